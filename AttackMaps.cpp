@@ -0,0 +1,221 @@
+// OOP Chess Project: AttackMaps.cpp.
+// This is the AttackMaps class source file.
+// It contains the definitions of the per-side attack bitboards the evaluation and move ordering share.
+// James Cummins.
+
+// Include the AttackMaps header file.
+#include <cstdlib>
+#include "AttackMaps.h"
+
+// Using namespaces.
+using namespace AttackNamespace;
+
+// The columns at the edges of the board, which pawn attacks must not wrap around.
+const Bitboard FirstColumn{ 0x0101010101010101ULL };
+const Bitboard LastColumn{ 0x8080808080808080ULL };
+
+// The eight directions a sliding piece can move in, as (row, column) steps: the straight ones first, then the diagonal ones.
+// The first two of each group step towards higher square numbers.
+const int Directions[8][2]{ {1, 0}, {0, 1}, {-1, 0}, {0, -1}, {1, 1}, {1, -1}, {-1, -1}, {-1, 1} };
+
+// The tables that only depend on the square, worked out once.
+struct AttackTables {
+	Bitboard Knight[64], King[64], WhiteFront[64], BlackFront[64], Columns[8], Neighbours[8];
+	// The squares from a square to the edge of the board in each direction.
+	Bitboard Rays[8][64];
+	AttackTables()
+	{
+		const int KnightSteps[8][2]{ {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2} };
+		for (int Square = 0; Square < 64; Square++)
+		{
+			int x{ Square / 8 }, y{ Square % 8 };
+			Knight[Square] = King[Square] = WhiteFront[Square] = BlackFront[Square] = 0;
+			for (const auto& Step : KnightSteps)
+			{
+				int NewX{ x + Step[0] }, NewY{ y + Step[1] };
+				if (NewX >= 0 && NewX < 8 && NewY >= 0 && NewY < 8) { Knight[Square] |= 1ULL << (8 * NewX + NewY); }
+			}
+			for (int Other = 0; Other < 64; Other++)
+			{
+				int OtherX{ Other / 8 }, OtherY{ Other % 8 };
+				if (Other != Square && abs(OtherX - x) <= 1 && abs(OtherY - y) <= 1) { King[Square] |= 1ULL << Other; }
+				// The squares in front of a pawn on its own and the neighbouring columns. White pawns move towards row zero.
+				if (abs(OtherY - y) > 1) { continue; }
+				if (OtherX < x) { WhiteFront[Square] |= 1ULL << Other; }
+				if (OtherX > x) { BlackFront[Square] |= 1ULL << Other; }
+			}
+		}
+		for (int d = 0; d < 8; d++)
+		{
+			for (int Square = 0; Square < 64; Square++)
+			{
+				Rays[d][Square] = 0;
+				int x{ Square / 8 + Directions[d][0] }, y{ Square % 8 + Directions[d][1] };
+				for (; x >= 0 && x < 8 && y >= 0 && y < 8; x += Directions[d][0], y += Directions[d][1]) { Rays[d][Square] |= 1ULL << (8 * x + y); }
+			}
+		}
+		for (int y = 0; y < 8; y++) { Columns[y] = FirstColumn << y; }
+		for (int y = 0; y < 8; y++) { Neighbours[y] = (y > 0 ? Columns[y - 1] : 0) | (y < 7 ? Columns[y + 1] : 0); }
+	}
+};
+static const AttackTables Tables;
+
+// Functions to return the squares a piece on a square attacks.
+Bitboard AttackNamespace::KnightAttacks(int Square) { return Tables.Knight[Square]; }
+Bitboard AttackNamespace::KingAttacks(int Square)   { return Tables.King[Square]; }
+Bitboard AttackNamespace::PawnAttacks(int Square, bool White)
+{
+	// White pawns capture towards row zero, black pawns towards row seven.
+	Bitboard Pawn{ 1ULL << Square };
+	if (White) { return ((Pawn & ~LastColumn) >> 7) | ((Pawn & ~FirstColumn) >> 9); }
+	return ((Pawn & ~FirstColumn) << 7) | ((Pawn & ~LastColumn) << 9);
+}
+
+// Function to return the squares a sliding piece attacks.
+Bitboard AttackNamespace::SlidingAttacks(int Square, Bitboard Occupied, bool Straight, bool Diagonal)
+{
+
+	// Each ray runs to the edge of the board, so cut it off beyond the first piece in the way (which is attacked too).
+	// Going towards higher squares the first piece is the lowest bit of the blockers, and going towards lower squares it is the highest.
+	Bitboard Result{ 0 };
+	for (int d = Straight ? 0 : 4; d < (Diagonal ? 8 : 4); d++)
+	{
+		Bitboard Ray{ Tables.Rays[d][Square] }, Blockers{ Ray & Occupied };
+		if (Blockers) { Ray ^= Tables.Rays[d][d % 4 < 2 ? LowestBit(Blockers) : HighestBit(Blockers)]; }
+		Result |= Ray;
+	}
+	return Result;
+
+}
+
+// Default constructor.
+AttackMaps::AttackMaps()
+{
+	uint8_t Empty[64]{};
+	Build(Empty);
+}
+
+// Function to build the maps from 64 piece codes.
+void AttackMaps::Build(const uint8_t Codes[64])
+{
+
+	// Start from nothing.
+	for (int Code = 0; Code < NumberOfPieceCodes; Code++) { Pieces[Code] = AttacksByCode[Code] = 0; Mobility[Code] = KingZoneAttacks[Code] = 0; }
+	Attacks[WhiteSide] = Attacks[BlackSide] = DoubleAttacks[WhiteSide] = DoubleAttacks[BlackSide] = 0;
+
+	// Put the pieces on the maps.
+	for (int Square = 0; Square < 64; Square++) { Pieces[Codes[Square]] |= 1ULL << Square; }
+	Pieces[NoPieceCode] = 0;
+	Sides[WhiteSide] = Sides[BlackSide] = 0;
+	for (int Code = WhitePawnCode; Code <= WhiteKingCode; Code++) { Sides[WhiteSide] |= Pieces[Code]; }
+	for (int Code = BlackPawnCode; Code <= BlackKingCode; Code++) { Sides[BlackSide] |= Pieces[Code]; }
+	Occupied = Sides[WhiteSide] | Sides[BlackSide];
+
+	// Pawns attack all at once with shifts.
+	Bitboard WhitePawns{ Pieces[WhitePawnCode] }, BlackPawns{ Pieces[BlackPawnCode] };
+	Bitboard WhiteLeft{ (WhitePawns & ~FirstColumn) >> 9 }, WhiteRight{ (WhitePawns & ~LastColumn) >> 7 };
+	Bitboard BlackLeft{ (BlackPawns & ~FirstColumn) << 7 }, BlackRight{ (BlackPawns & ~LastColumn) << 9 };
+	AttacksByCode[WhitePawnCode] = Attacks[WhiteSide] = WhiteLeft | WhiteRight;
+	AttacksByCode[BlackPawnCode] = Attacks[BlackSide] = BlackLeft | BlackRight;
+	DoubleAttacks[WhiteSide] = WhiteLeft & WhiteRight;
+	DoubleAttacks[BlackSide] = BlackLeft & BlackRight;
+
+	// The squares next to each king, and the squares each side's pieces can safely move to (not their own, and not attacked by enemy pawns).
+	Bitboard KingZone[2]{ 0, 0 }, SafeSquares[2];
+	if (Pieces[WhiteKingCode]) { KingZone[WhiteSide] = Pieces[WhiteKingCode] | KingAttacks(LowestBit(Pieces[WhiteKingCode])); }
+	if (Pieces[BlackKingCode]) { KingZone[BlackSide] = Pieces[BlackKingCode] | KingAttacks(LowestBit(Pieces[BlackKingCode])); }
+	SafeSquares[WhiteSide] = ~Sides[WhiteSide] & ~AttacksByCode[BlackPawnCode];
+	SafeSquares[BlackSide] = ~Sides[BlackSide] & ~AttacksByCode[WhitePawnCode];
+	KingZoneAttacks[WhitePawnCode] = CountBits(AttacksByCode[WhitePawnCode] & KingZone[BlackSide]);
+	KingZoneAttacks[BlackPawnCode] = CountBits(AttacksByCode[BlackPawnCode] & KingZone[WhiteSide]);
+
+	// Every other piece, one at a time.
+	for (int Code = WhiteKnightCode; Code < NumberOfPieceCodes; Code++)
+	{
+		if (Code == BlackPawnCode) { continue; }
+		int Own{ Code <= WhiteKingCode ? WhiteSide : BlackSide }, Type{ (Code - 1) % 6 };
+		for (Bitboard Remaining = Pieces[Code]; Remaining; Remaining &= Remaining - 1)
+		{
+			int Square{ LowestBit(Remaining) };
+			Bitboard Attacked;
+			if (Type == KnightType) { Attacked = KnightAttacks(Square); }
+			else if (Type == KingType) { Attacked = KingAttacks(Square); }
+			else { Attacked = SlidingAttacks(Square, Occupied, Type != BishopType, Type != RookType); }
+			AttacksByCode[Code] |= Attacked;
+			DoubleAttacks[Own] |= Attacks[Own] & Attacked;
+			Attacks[Own] |= Attacked;
+			Mobility[Code] += CountBits(Attacked & SafeSquares[Own]);
+			KingZoneAttacks[Code] += CountBits(Attacked & KingZone[1 - Own]);
+		}
+	}
+
+}
+
+// Access functions.
+Bitboard AttackMaps::GetPieces(int Code)           const { return Pieces[Code]; }
+Bitboard AttackMaps::GetSide(int TheSide)          const { return Sides[TheSide]; }
+Bitboard AttackMaps::GetOccupied()                 const { return Occupied; }
+Bitboard AttackMaps::GetAttacksBy(int Code)        const { return AttacksByCode[Code]; }
+Bitboard AttackMaps::GetAttacks(int TheSide)       const { return Attacks[TheSide]; }
+Bitboard AttackMaps::GetDoubleAttacks(int TheSide) const { return DoubleAttacks[TheSide]; }
+
+// Function to check if a square is attacked by a side.
+bool AttackMaps::IsAttacked(int Square, int TheSide) const { return (Attacks[TheSide] >> Square) & 1; }
+
+// Function to return the code of the least valuable piece of a side attacking a square.
+int AttackMaps::LeastValuableAttacker(int Square, int TheSide) const
+{
+	int First{ TheSide == WhiteSide ? WhitePawnCode : BlackPawnCode };
+	for (int Code = First; Code < First + 6; Code++)
+	{
+		if ((AttacksByCode[Code] >> Square) & 1) { return Code; }
+	}
+	return NoPieceCode;
+}
+
+// Function to return the counts behind the positional terms.
+TermCounts AttackMaps::CountTerms() const
+{
+
+	TermCounts Counts{};
+
+	// Doubled and isolated pawns, counted per column.
+	Bitboard WhitePawns{ Pieces[WhitePawnCode] }, BlackPawns{ Pieces[BlackPawnCode] };
+	for (int y = 0; y < 8; y++)
+	{
+		int White{ CountBits(WhitePawns & Tables.Columns[y]) }, Black{ CountBits(BlackPawns & Tables.Columns[y]) };
+		Counts.DoubledPawns += (White > 1 ? White - 1 : 0) - (Black > 1 ? Black - 1 : 0);
+		Counts.IsolatedPawns += ((WhitePawns & Tables.Neighbours[y]) == 0) * White - ((BlackPawns & Tables.Neighbours[y]) == 0) * Black;
+	}
+
+	// Passed pawns have no enemy pawns in front of them on their own or the neighbouring columns.
+	// These are added up without branches, since whether a pawn is passed is as good as random to the processor.
+	for (Bitboard Remaining = WhitePawns; Remaining; Remaining &= Remaining - 1)
+	{
+		int Square{ LowestBit(Remaining) };
+		Counts.PassedPawns[6 - Square / 8] += (BlackPawns & Tables.WhiteFront[Square]) == 0;
+	}
+	for (Bitboard Remaining = BlackPawns; Remaining; Remaining &= Remaining - 1)
+	{
+		int Square{ LowestBit(Remaining) };
+		Counts.PassedPawns[Square / 8 - 1] -= (WhitePawns & Tables.BlackFront[Square]) == 0;
+	}
+
+	// Mobility of the knights, bishops, rooks and queens, and attacks next to the enemy king by everything but the king.
+	for (int Type = KnightType; Type <= QueenType; Type++) { Counts.Mobility[Type - KnightType] = Mobility[WhitePawnCode + Type] - Mobility[BlackPawnCode + Type]; }
+	for (int Type = PawnType; Type <= QueenType; Type++) { Counts.KingAttacks[Type] = KingZoneAttacks[WhitePawnCode + Type] - KingZoneAttacks[BlackPawnCode + Type]; }
+
+	// Hanging pieces are attacked and not defended. Kings are left out, since an attacked king is in check.
+	Bitboard WhiteHanging{ Sides[WhiteSide] & ~Pieces[WhiteKingCode] & Attacks[BlackSide] & ~Attacks[WhiteSide] };
+	Bitboard BlackHanging{ Sides[BlackSide] & ~Pieces[BlackKingCode] & Attacks[WhiteSide] & ~Attacks[BlackSide] };
+	Counts.HangingPieces = CountBits(BlackHanging) - CountBits(WhiteHanging);
+
+	// Pawns attacking pieces, and minor pieces attacking rooks and queens.
+	Bitboard WhiteTargets{ Sides[WhiteSide] & ~WhitePawns & ~Pieces[WhiteKingCode] }, BlackTargets{ Sides[BlackSide] & ~BlackPawns & ~Pieces[BlackKingCode] };
+	Counts.PawnThreats = CountBits(AttacksByCode[WhitePawnCode] & BlackTargets) - CountBits(AttacksByCode[BlackPawnCode] & WhiteTargets);
+	Bitboard WhiteMinors{ AttacksByCode[WhiteKnightCode] | AttacksByCode[WhiteBishopCode] }, BlackMinors{ AttacksByCode[BlackKnightCode] | AttacksByCode[BlackBishopCode] };
+	Counts.MinorThreats = CountBits(WhiteMinors & (Pieces[BlackRookCode] | Pieces[BlackQueenCode])) - CountBits(BlackMinors & (Pieces[WhiteRookCode] | Pieces[WhiteQueenCode]));
+
+	return Counts;
+
+}
\ No newline at end of file
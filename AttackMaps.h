@@ -0,0 +1,122 @@
+// OOP Chess Project: AttackMaps.h.
+// This is the AttackMaps class header file.
+// It contains the declarations of the per-side attack bitboards the evaluation and move ordering share.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_AttackMaps
+#define MY_CLASS_AttackMaps
+
+// Include the relevant libraries.
+#include <cstdint>
+#include "Pieces.h"
+#include "EvalParameters.h"
+
+// Using namespaces.
+using namespace PieceNamespace;
+using namespace ParameterNamespace;
+
+// Using a namespace to avoid name collisions.
+namespace AttackNamespace
+{
+
+	// A set of squares, with bit 8 * x + y standing for row x and column y of the chessboard.
+	typedef uint64_t Bitboard;
+
+	// The two sides, used to index the maps.
+	enum Side { WhiteSide, BlackSide };
+
+	// Function to count the squares in a set.
+	// This adds neighbouring bits in parallel, which is fast on every processor (the builtin is a library call without POPCNT).
+	inline int CountBits(Bitboard Squares)
+	{
+		Squares = Squares - ((Squares >> 1) & 0x5555555555555555ULL);
+		Squares = (Squares & 0x3333333333333333ULL) + ((Squares >> 2) & 0x3333333333333333ULL);
+		Squares = (Squares + (Squares >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<int>((Squares * 0x0101010101010101ULL) >> 56);
+	}
+
+	// Function to return the lowest square in a (non-empty) set.
+	inline int LowestBit(Bitboard Squares)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(Squares);
+#else
+		int Square{ 0 };
+		while (!(Squares & 1)) { Squares >>= 1; Square++; }
+		return Square;
+#endif
+	}
+
+	// Function to return the highest square in a (non-empty) set.
+	inline int HighestBit(Bitboard Squares)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return 63 - __builtin_clzll(Squares);
+#else
+		int Square{ 63 };
+		while (!(Squares >> 63)) { Squares <<= 1; Square--; }
+		return Square;
+#endif
+	}
+
+	// Functions to return the squares a piece on a square attacks.
+	Bitboard KnightAttacks(int Square);
+	Bitboard KingAttacks(int Square);
+	Bitboard PawnAttacks(int Square, bool White);
+	// Sliding pieces stop at the first occupied square in each direction.
+	Bitboard SlidingAttacks(int Square, Bitboard Occupied, bool Straight, bool Diagonal);
+
+	// AttackMaps class.
+	// Everything is worked out in one pass over the pieces, and the evaluation terms are then read off with popcounts.
+	class AttackMaps {
+
+	// Private member data.
+	private:
+
+		// Where the pieces are: by piece code, by side, and all together.
+		Bitboard Pieces[NumberOfPieceCodes];
+		Bitboard Sides[2];
+		Bitboard Occupied;
+		// The squares attacked by each kind of piece, by each side, and by each side more than once.
+		Bitboard AttacksByCode[NumberOfPieceCodes];
+		Bitboard Attacks[2];
+		Bitboard DoubleAttacks[2];
+		// For each kind of piece, the safe squares it can move to and the squares next to the enemy king it attacks.
+		int Mobility[NumberOfPieceCodes];
+		int KingZoneAttacks[NumberOfPieceCodes];
+
+	// Public member functions.
+	public:
+
+		// Default constructor. The maps are of an empty board.
+		AttackMaps();
+		// Destructor.
+		~AttackMaps() {}
+
+		// Function to build the maps from 64 piece codes.
+		void Build(const uint8_t Codes[64]);
+
+		// Access functions.
+		Bitboard GetPieces(int Code)          const;
+		Bitboard GetSide(int TheSide)         const;
+		Bitboard GetOccupied()                const;
+		Bitboard GetAttacksBy(int Code)       const;
+		Bitboard GetAttacks(int TheSide)      const;
+		Bitboard GetDoubleAttacks(int TheSide) const;
+
+		// Function to check if a square is attacked by a side.
+		bool IsAttacked(int Square, int TheSide) const;
+
+		// Function to return the code of the least valuable piece of a side attacking a square, or NoPieceCode.
+		int LeastValuableAttacker(int Square, int TheSide) const;
+
+		// Function to return the counts behind the positional terms: pawn structure, mobility, king attacks and threats.
+		TermCounts CountTerms() const;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
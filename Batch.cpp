@@ -0,0 +1,476 @@
+// OOP Chess Project: Batch.cpp.
+// This is the batch source file.
+// It contains all the definitions related to playing and analysing positions in batch mode.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <deque>
+#include <condition_variable>
+#include "Batch.h"
+#include "Json.h"
+#include "Uci.h"
+#include "Zobrist.h"
+
+// Using namespaces.
+using namespace BatchNamespace;
+using namespace JsonNamespace;
+using namespace UciNamespace;
+using namespace ZobristNamespace;
+
+// The result of one game or position: the text written for it, and for a game its result.
+struct BatchResult { string Text, Result; };
+
+// Function to return a position as a FEN string.
+static string FENString(const FENPosition& Position)
+{
+	char Buffer[MaximumFENLength];
+	return string(Buffer, WriteFEN(Position, Buffer));
+}
+
+// Function to read the positions a batch starts from.
+bool BatchNamespace::LoadBatchPositions(const string& FileName, vector<FENPosition>& Positions)
+{
+
+	// A PGN file gives the position at the end of each game.
+	string Extension{ FileName.size() >= 4 ? FileName.substr(FileName.size() - 4) : "" };
+	transform(Extension.begin(), Extension.end(), Extension.begin(), [](char Character) { return static_cast<char>(tolower(Character)); });
+	if (Extension == ".pgn")
+	{
+		PgnReader Reader;
+		if (!Reader.Open(FileName)) { return false; }
+		PgnGame Game;
+		while (Reader.ReadGame(Game))
+		{
+			FENPosition Position{ Game.StartingPosition };
+			for (const PositionMove& Move : Game.Moves) { MakePositionMove(Position, Move); }
+			Positions.push_back(Position);
+		}
+		return true;
+	}
+
+	// Anything else is a FEN string or EPD line on each line. Blank lines and lines starting with '#' are skipped.
+	ifstream File(FileName);
+	if (!File) { cerr << "Error: Could not open " << FileName << "." << endl; return false; }
+	string Line;
+	int LineNumber{ 0 };
+	while (getline(File, Line))
+	{
+		LineNumber++;
+		size_t First{ Line.find_first_not_of(" \t\r") };
+		if (First == string::npos || Line[First] == '#') { continue; }
+		FENPosition Position;
+		if (!ParseFEN(Line.c_str(), Position)) { cerr << "Error: Line " << LineNumber << " of " << FileName << " is not a valid FEN string (" << FENProblem(Line.c_str()) << "), so it was skipped." << endl; continue; }
+		Positions.push_back(Position);
+	}
+	return true;
+
+}
+
+// Function to play a game from a position, with the computer playing both sides.
+static BatchResult PlayGame(GameManager& Game, const FENPosition& Start, const BatchOptions& Options, long long Number)
+{
+
+	// Play until the game ends or reaches the limit on its length, remembering the positions to spot repetitions.
+	auto Begin = chrono::steady_clock::now();
+	Game.SetPosition(Start);
+	PgnGame Record;
+	Record.StartingPosition = Start;
+	vector<uint64_t> Keys;
+	vector<string> Moves;
+	string Result{ "*" }, Ending{ "move limit" };
+	long long Nodes{ 0 };
+	FENPosition Position;
+	for (int Ply = 0; ; Ply++)
+	{
+		Game.GetPosition(Position);
+		Keys.push_back(PositionKey(Position));
+		GameEnding End{ FindGameEnding(Position) };
+		if (End != NotFinished) { Result = GameEndingResult(Position, End); Ending = GameEndingName(End); break; }
+		if (count(Keys.begin(), Keys.end(), Keys.back()) >= 3) { Result = "1/2-1/2"; Ending = "threefold repetition"; break; }
+		if (Ply >= Options.MaximumPlies) { break; }
+
+		SearchResult Found{ Game.LimitedSearch(Options.Limits) };
+		Nodes += Found.Nodes;
+		char Text[8];
+		WriteUciMove(Position.Codes, Found.Move, Text);
+		Moves.push_back(Text);
+		Record.Moves.push_back({ static_cast<uint8_t>(MoveFrom(Found.Move)), static_cast<uint8_t>(MoveTo(Found.Move)), NoPieceCode });
+		Game.MakeMove(Found.Move);
+	}
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Begin).count() };
+
+	// Write the game as PGN, or as a line of JSON with the moves in coordinates.
+	ostringstream Output;
+	if (Options.WritePgn)
+	{
+		string StartFEN{ FENString(Start) };
+		Record.Result = Result;
+		Record.Tags = { {"Event", "Batch game"}, {"Site", "?"}, {"Date", "????.??.??"}, {"Round", to_string(Number + 1)}, {"White", "Chess Game"}, {"Black", "Chess Game"}, {"Result", Result} };
+		if (StartFEN != StartingFEN) { Record.Tags.push_back({ "SetUp", "1" }); Record.Tags.push_back({ "FEN", StartFEN }); }
+		WritePgnGame(Output, Record);
+	}
+	else
+	{
+		Output << "{\"game\":" << Number + 1 << ",\"fen\":";
+		WriteJsonString(Output, FENString(Start));
+		Output << ",\"result\":\"" << Result << "\",\"ending\":\"" << Ending << "\",\"plies\":" << Moves.size() << ",\"moves\":[";
+		for (size_t i = 0; i < Moves.size(); i++) { Output << (i > 0 ? ",\"" : "\"") << Moves[i] << '"'; }
+		Output << "],\"nodes\":" << Nodes << ",\"seconds\":" << fixed << setprecision(3) << Seconds << "}\n";
+	}
+	return { Output.str(), Result };
+
+}
+
+// Function to find the best move in a position.
+static BatchResult AnalysePosition(GameManager& Game, const FENPosition& Position, const BatchOptions& Options)
+{
+
+	Game.SetPosition(Position);
+	SearchResult Found{ Game.LimitedSearch(Options.Limits) };
+	ostringstream Output;
+	Output << "{\"fen\":";
+	WriteJsonString(Output, FENString(Position));
+
+	// A position with no moves has no best move, only an ending.
+	if (Found.Depth == 0) { Output << ",\"bestmove\":null,\"ending\":\"" << GameEndingName(FindGameEnding(Position)) << "\"}\n"; return { Output.str(), "" }; }
+	char Text[8], SAN[16];
+	WriteUciMove(Position.Codes, Found.Move, Text);
+	WriteSAN(Position, { static_cast<uint8_t>(MoveFrom(Found.Move)), static_cast<uint8_t>(MoveTo(Found.Move)), NoPieceCode }, SAN);
+	Output << ",\"bestmove\":\"" << Text << "\",\"san\":\"" << SAN << "\",";
+	WriteJsonScore(Output, Position.WhiteToMove ? Found.Score : -Found.Score, Found.Depth);
+	Output << ",\"depth\":" << Found.Depth << ",\"nodes\":" << Found.Nodes << ",\"seconds\":" << fixed << setprecision(3) << Found.Seconds << "}\n";
+	return { Output.str(), "" };
+
+}
+
+// Function to play games or analyse positions on several threads.
+long long BatchNamespace::RunBatch(const vector<FENPosition>& Positions, const BatchOptions& Options, ostream& Output)
+{
+
+	// Each thread takes the next game or position nobody has taken. The results are written in order: a finished result waits
+	// until the ones before it have been written, so the output is the same however many threads there are.
+	size_t Count{ Options.Mode == PlayGames ? static_cast<size_t>(Options.Games) : Positions.size() };
+	if (Positions.empty() || Count == 0) { return 0; }
+	vector<BatchResult> Results(Count);
+	vector<bool> Finished(Count, false);
+	size_t NextToWrite{ 0 };
+	long long WhiteWins{ 0 }, BlackWins{ 0 }, Draws{ 0 };
+	mutex OutputLock;
+	atomic<size_t> Next{ 0 };
+	auto Start = chrono::steady_clock::now();
+
+	auto Worker = [&]() {
+		Board TheBoard;
+		GameManager Game(&TheBoard);
+		for (size_t i = Next++; i < Count; i = Next++)
+		{
+			BatchResult Result{ Options.Mode == PlayGames ? PlayGame(Game, Positions[i % Positions.size()], Options, static_cast<long long>(i)) : AnalysePosition(Game, Positions[i], Options) };
+			lock_guard<mutex> Lock(OutputLock);
+			Results[i] = Result;
+			Finished[i] = true;
+			for (; NextToWrite < Count && Finished[NextToWrite]; NextToWrite++)
+			{
+				const string& GameResult{ Results[NextToWrite].Result };
+				WhiteWins += GameResult == "1-0";
+				BlackWins += GameResult == "0-1";
+				Draws += GameResult == "1/2-1/2";
+				Output << Results[NextToWrite].Text << flush;
+				Results[NextToWrite] = BatchResult();
+			}
+		}
+	};
+
+	int Threads{ static_cast<int>(max<size_t>(1, min(static_cast<size_t>(max(Options.Threads, 1)), Count))) };
+	vector<thread> Workers;
+	for (int i = 1; i < Threads; i++) { Workers.emplace_back(Worker); }
+	Worker();
+	for (thread& TheThread : Workers) { TheThread.join(); }
+
+	// A summary of a run of games ends the JSON lines. PGN has nowhere to put it.
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+	if (Options.Mode == PlayGames && !Options.WritePgn)
+	{
+		Output << "{\"summary\":{\"games\":" << Count << ",\"white_wins\":" << WhiteWins << ",\"black_wins\":" << BlackWins << ",\"draws\":" << Draws
+			<< ",\"unfinished\":" << static_cast<long long>(Count) - WhiteWins - BlackWins - Draws << ",\"threads\":" << Threads
+			<< ",\"seconds\":" << fixed << setprecision(3) << Seconds << "}}" << endl;
+	}
+	return static_cast<long long>(Count);
+
+}
+
+// Function to return the default settings of a stream of analysis requests.
+StreamOptions BatchNamespace::DefaultStreamOptions()
+{
+	return { { 2, 0, 0.0 }, 1, max(1, static_cast<int>(thread::hardware_concurrency())), 4096, 1 << 16, 0.01 };
+}
+
+// A request of a stream: its id, written as JSON ready to copy into the answer, its position, and how to search it.
+struct StreamRequest {
+	string Id;
+	FENPosition Position;
+	SearchLimits Limits;
+	int MultiPv;
+};
+
+// Function to read a request from a line of JSON. Returns false, with the reason in Error, if it can't be read.
+// The id is read first, so even a request with a mistake in it can be answered with its id.
+static bool ReadStreamRequest(const string& Line, const StreamOptions& Options, StreamRequest& Request, string& Error)
+{
+
+	vector<JsonField> Fields;
+	Request.Id = "null";
+	if (!ReadFlatJsonObject(Line, Fields, Error)) { return false; }
+	const JsonField* Id{ FindJsonField(Fields, "id") };
+	if (Id && Id->IsString) { ostringstream Text; WriteJsonString(Text, Id->Value); Request.Id = Text.str(); }
+	else if (Id) { Request.Id = Id->Value; }
+
+	// The position.
+	const JsonField* FEN{ FindJsonField(Fields, "fen") };
+	if (FEN && !FEN->IsString) { Error = "\"fen\" must be a string"; return false; }
+	if (!ParseFEN(FEN ? FEN->Value.c_str() : StartingFEN, Request.Position)) { Error = string("\"fen\" is not a valid FEN string: ") + FENProblem(FEN->Value.c_str()); return false; }
+
+	// The limits, which are all numbers.
+	Request.Limits = Options.Limits;
+	Request.MultiPv = Options.MultiPv;
+	bool HasLimit{ false };
+	for (const char* Name : { "depth", "nodes", "time", "multipv" })
+	{
+		const JsonField* Field{ FindJsonField(Fields, Name) };
+		if (!Field) { continue; }
+		if (Field->IsString || !(isdigit(static_cast<unsigned char>(Field->Value[0])) || Field->Value[0] == '-')) { Error = string("\"") + Name + "\" must be a number"; return false; }
+		double Value{ atof(Field->Value.c_str()) };
+		if (string(Name) == "multipv") { Request.MultiPv = static_cast<int>(max(1.0, min(Value, 256.0))); continue; }
+		if (!HasLimit) { Request.Limits = { 0, 0, 0.0 }; HasLimit = true; }
+		if (string(Name) == "depth") { Request.Limits.Depth = static_cast<int>(min(Value, 100.0)); }
+		else if (string(Name) == "nodes") { Request.Limits.Nodes = static_cast<long long>(Value); }
+		else { Request.Limits.Seconds = Value; }
+	}
+	if (Request.Limits.Depth <= 0 && Request.Limits.Nodes <= 0 && Request.Limits.Seconds <= 0) { Error = "A request must have a positive limit"; return false; }
+	return true;
+
+}
+
+// Function to answer a request, adding the answer to Text.
+static void AnswerStreamRequest(GameManager& Game, const StreamRequest& Request, ostringstream& Text)
+{
+
+	// Find the best moves one at a time, each without the ones found before it, sharing the node and time limits between them.
+	Game.SetPosition(Request.Position);
+	SearchLimits Limits{ Request.Limits };
+	Limits.Nodes /= Request.MultiPv;
+	Limits.Seconds /= Request.MultiPv;
+	vector<PackedMove> Found;
+	vector<SearchResult> Lines;
+	long long Nodes{ 0 };
+	double Seconds{ 0 };
+	for (int i = 0; i < Request.MultiPv; i++)
+	{
+		SearchResult Result{ Game.LimitedSearch(Limits, nullptr, nullptr, Found) };
+		Nodes += Result.Nodes;
+		Seconds += Result.Seconds;
+		if (Result.Depth == 0) { break; }
+		Found.push_back(Result.Move);
+		Lines.push_back(Result);
+	}
+
+	Text << "{\"id\":" << Request.Id << ",\"fen\":";
+	WriteJsonString(Text, FENString(Request.Position));
+
+	// A position with no moves has no best move, only an ending.
+	if (Lines.empty()) { Text << ",\"bestmove\":null,\"ending\":\"" << GameEndingName(FindGameEnding(Request.Position)) << "\"}\n"; return; }
+	auto WriteLine = [&](const SearchResult& Line, const char* MoveName) {
+		char Move[8], SAN[16];
+		WriteUciMove(Request.Position.Codes, Line.Move, Move);
+		WriteSAN(Request.Position, { static_cast<uint8_t>(MoveFrom(Line.Move)), static_cast<uint8_t>(MoveTo(Line.Move)), NoPieceCode }, SAN);
+		Text << '"' << MoveName << "\":\"" << Move << "\",\"san\":\"" << SAN << "\",";
+		WriteJsonScore(Text, Request.Position.WhiteToMove ? Line.Score : -Line.Score, Line.Depth);
+		Text << ",\"depth\":" << Line.Depth;
+	};
+	Text << ',';
+	WriteLine(Lines.front(), "bestmove");
+	if (Request.MultiPv > 1)
+	{
+		Text << ",\"lines\":[";
+		for (size_t i = 0; i < Lines.size(); i++) { Text << (i > 0 ? ",{" : "{"); WriteLine(Lines[i], "move"); Text << '}'; }
+		Text << ']';
+	}
+	Text << ",\"nodes\":" << Nodes << ",\"seconds\":" << fixed << setprecision(3) << Seconds << "}\n";
+
+}
+
+// Function to answer a stream of requests.
+long long BatchNamespace::RunAnalysisStream(istream& Input, ostream& Output, const StreamOptions& Options)
+{
+
+	// The requests waiting for a thread, and whether the input has ended.
+	deque<StreamRequest> Requests;
+	bool InputEnded{ false };
+	mutex RequestLock;
+	condition_variable RequestWaiting, RequestTaken;
+
+	// The answers waiting to be written, the number of requests read but not yet answered, and whether everything has been answered.
+	// Only the writer thread writes, so the threads answering never wait for the output.
+	string Answers;
+	long long Unanswered{ 0 }, Answered{ 0 };
+	bool Finished{ false };
+	mutex AnswerLock;
+	condition_variable AnswersReady;
+	auto AddAnswer = [&](const string& Text, bool Request) {
+		lock_guard<mutex> Lock(AnswerLock);
+		Answers += Text;
+		if (Request) { Unanswered--; Answered++; }
+		if (Answers.size() >= Options.FlushBytes || Unanswered == 0) { AnswersReady.notify_one(); }
+	};
+
+	thread Writer([&]() {
+		unique_lock<mutex> Lock(AnswerLock);
+		auto FlushTime = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(Options.FlushSeconds));
+		while (true)
+		{
+			AnswersReady.wait_for(Lock, FlushTime, [&]() { return Answers.size() >= Options.FlushBytes || (Unanswered == 0 && !Answers.empty()) || Finished; });
+			if (!Answers.empty())
+			{
+				string Block;
+				swap(Block, Answers);
+				Lock.unlock();
+				Output.write(Block.data(), static_cast<streamsize>(Block.size())).flush();
+				Lock.lock();
+			}
+			if (Finished && Answers.empty()) { break; }
+		}
+	});
+
+	// Each thread answering requests has its own board and game, and its own text to write an answer in.
+	auto Worker = [&]() {
+		Board TheBoard;
+		GameManager Game(&TheBoard);
+		ostringstream Text;
+		while (true)
+		{
+			unique_lock<mutex> Lock(RequestLock);
+			RequestWaiting.wait(Lock, [&]() { return !Requests.empty() || InputEnded; });
+			if (Requests.empty()) { return; }
+			StreamRequest Request{ move(Requests.front()) };
+			Requests.pop_front();
+			Lock.unlock();
+			RequestTaken.notify_one();
+			Text.str("");
+			AnswerStreamRequest(Game, Request, Text);
+			AddAnswer(Text.str(), true);
+		}
+	};
+	vector<thread> Workers;
+	for (int i = 0; i < max(1, Options.Threads); i++) { Workers.emplace_back(Worker); }
+
+	// Read the requests on this thread. Blank lines are skipped, and a line that can't be read is answered straight away.
+	string Line, Error;
+	while (getline(Input, Line))
+	{
+		if (Line.find_first_not_of(" \t\r") == string::npos) { continue; }
+		StreamRequest Request;
+		if (!ReadStreamRequest(Line, Options, Request, Error))
+		{
+			ostringstream Text;
+			Text << "{\"id\":" << Request.Id << ",\"error\":";
+			WriteJsonString(Text, Error);
+			Text << "}\n";
+			AddAnswer(Text.str(), false);
+			continue;
+		}
+		{ lock_guard<mutex> Lock(AnswerLock); Unanswered++; }
+		unique_lock<mutex> Lock(RequestLock);
+		RequestTaken.wait(Lock, [&]() { return Requests.size() < max<size_t>(1, Options.QueueLimit); });
+		Requests.push_back(move(Request));
+		Lock.unlock();
+		RequestWaiting.notify_one();
+	}
+
+	// Let the threads finish the requests that are left, then write the last answers.
+	{ lock_guard<mutex> Lock(RequestLock); InputEnded = true; }
+	RequestWaiting.notify_all();
+	for (thread& TheThread : Workers) { TheThread.join(); }
+	{ lock_guard<mutex> Lock(AnswerLock); Finished = true; }
+	AnswersReady.notify_one();
+	Writer.join();
+	return Answered;
+
+}
+
+// Function to run "batch play|analyse|stream ..." from the command line.
+int BatchNamespace::RunBatchCommand(int argc, char* argv[])
+{
+
+	// Check the arguments. With no limit the search goes to depth 2, as the computer player does.
+	const string Usage{ "Error: Usage is \"batch play|analyse|stream [-depth N] [-time S] [-nodes N] [-games N] [-plies N] [-threads N] [-multipv N] [-fen FEN] [-input file] [-output file] [-format json|pgn]\"." };
+	if (argc < 3 || (string(argv[2]) != "play" && string(argv[2]) != "analyse" && string(argv[2]) != "stream")) { cerr << Usage << endl; return 1; }
+	bool Stream{ string(argv[2]) == "stream" };
+	BatchOptions Options{ string(argv[2]) == "play" ? PlayGames : AnalysePositions, { 0, 0, 0.0 }, 0, 400, max(1, static_cast<int>(thread::hardware_concurrency())), false };
+	StreamOptions Streaming{ DefaultStreamOptions() };
+	string FEN, InputFile, OutputFile;
+	for (int i = 3; i < argc; i++)
+	{
+		string Option{ argv[i] };
+		if (i + 1 >= argc) { cerr << "Error: " << Option << " needs a value." << endl; return 1; }
+		string Value{ argv[++i] };
+		if (Option == "-depth") { Options.Limits.Depth = atoi(Value.c_str()); }
+		else if (Option == "-time") { Options.Limits.Seconds = atof(Value.c_str()); }
+		else if (Option == "-nodes") { Options.Limits.Nodes = atoll(Value.c_str()); }
+		else if (Option == "-games") { Options.Games = atoll(Value.c_str()); }
+		else if (Option == "-plies") { Options.MaximumPlies = atoi(Value.c_str()); }
+		else if (Option == "-threads") { Options.Threads = atoi(Value.c_str()); }
+		else if (Option == "-multipv" && Stream) { Streaming.MultiPv = max(1, atoi(Value.c_str())); }
+		else if (Option == "-fen") { FEN = Value; }
+		else if (Option == "-input") { InputFile = Value; }
+		else if (Option == "-output") { OutputFile = Value; }
+		else if (Option == "-format" && (Value == "json" || Value == "pgn")) { Options.WritePgn = Value == "pgn"; }
+		else { cerr << "Error: Did not recognise " << Option << " " << Value << ".\n" << Usage << endl; return 1; }
+	}
+	if (Options.Limits.Depth <= 0 && Options.Limits.Nodes <= 0 && Options.Limits.Seconds <= 0) { Options.Limits.Depth = 2; }
+	if (Options.WritePgn && Options.Mode == AnalysePositions) { cerr << "Error: Only games can be written as PGN." << endl; return 1; }
+
+	// A stream reads requests rather than positions, from the input file or the standard input.
+	if (Stream)
+	{
+		Streaming.Limits = Options.Limits;
+		Streaming.Threads = Options.Threads;
+		ifstream RequestFile;
+		if (!InputFile.empty()) { RequestFile.open(InputFile); if (!RequestFile) { cerr << "Error: Could not open " << InputFile << "." << endl; return 1; } }
+		istream& Requests{ InputFile.empty() ? cin : RequestFile };
+		if (OutputFile.empty()) { RunAnalysisStream(Requests, cout, Streaming); return 0; }
+		ofstream Output(OutputFile);
+		if (!Output.is_open()) { cerr << "Error: Unable to open " << OutputFile << " for saving." << endl; return 1; }
+		RunAnalysisStream(Requests, Output, Streaming);
+		if (!Output) { cerr << "Error: Could not write every answer to " << OutputFile << "." << endl; return 1; }
+		return 0;
+	}
+
+	// Read the positions: a FEN string, a file of them, or the usual starting position.
+	vector<FENPosition> Positions;
+	FENPosition Position;
+	if (!FEN.empty())
+	{
+		if (!ParseFEN(FEN.c_str(), Position)) { cerr << "Error: \"" << FEN << "\" is not a valid FEN string: " << FENProblem(FEN.c_str()) << "." << endl; return 1; }
+		Positions.push_back(Position);
+	}
+	if (!InputFile.empty() && !LoadBatchPositions(InputFile, Positions)) { return 1; }
+	if (FEN.empty() && InputFile.empty()) { ParseFEN(StartingFEN, Position); Positions.push_back(Position); }
+	if (Positions.empty()) { cerr << "Error: There are no positions to start from." << endl; return 1; }
+	if (Options.Games <= 0) { Options.Games = static_cast<long long>(Positions.size()); }
+
+	// Write to the output file, or to the screen if there isn't one.
+	if (OutputFile.empty()) { RunBatch(Positions, Options, cout); return 0; }
+	ofstream Output(OutputFile);
+	if (!Output.is_open()) { cerr << "Error: Unable to open " << OutputFile << " for saving." << endl; return 1; }
+	RunBatch(Positions, Options, Output);
+	if (!Output) { cerr << "Error: Could not write every result to " << OutputFile << "." << endl; return 1; }
+	return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+// OOP Chess Project: Batch.h.
+// This is the batch header file.
+// It contains the declarations of the batch mode, which plays or analyses positions without any prompts for scripts to use.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Batch
+#define MY_CLASS_Batch
+
+// Include the relevant libraries.
+#include <string>
+#include <vector>
+#include "GameManager.h"
+
+// Using namespaces.
+using namespace GameNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace BatchNamespace
+{
+
+	// What a batch run does with its positions: play games from them, or find the best move in each.
+	enum BatchMode { PlayGames, AnalysePositions };
+
+	// The settings of a batch run.
+	struct BatchOptions {
+		BatchMode Mode;
+		// The limits of every search.
+		SearchLimits Limits;
+		// The number of games to play, which go through the positions in turn, and the longest a game may last in half moves.
+		long long Games;
+		int MaximumPlies;
+		// The number of threads playing games or analysing positions.
+		int Threads;
+		// Whether games are written as PGN rather than lines of JSON.
+		bool WritePgn;
+	};
+
+	// Function to read the positions a batch starts from: each line of a FEN or EPD file, or the position at the end of each game
+	// of a PGN file (which is how sets of openings are usually given). Returns false if the file can't be read.
+	bool LoadBatchPositions(const string& FileName, vector<FENPosition>& Positions);
+
+	// Function to play games or analyse positions on several threads, writing one result at a time to Output in the order of the positions.
+	// Each thread has its own board and game. Returns the number of results written.
+	long long RunBatch(const vector<FENPosition>& Positions, const BatchOptions& Options, ostream& Output);
+
+	// The settings of a stream of analysis requests.
+	struct StreamOptions {
+		// The limits of the search of a request that doesn't give any, and the number of best moves it gets if it doesn't ask.
+		SearchLimits Limits;
+		int MultiPv;
+		// The number of threads answering requests, and the most requests waiting for one. The input isn't read while that many wait.
+		int Threads;
+		size_t QueueLimit;
+		// Answers are gathered and written together once there are this many bytes of them, once this long has passed since the
+		// last were written, or once every request read so far has been answered, whichever comes first.
+		size_t FlushBytes;
+		double FlushSeconds;
+	};
+
+	// Function to return the default settings: depth 2 and one best move, a thread for each core, 4096 requests waiting,
+	// and answers written every 64 kilobytes or 10 milliseconds.
+	StreamOptions DefaultStreamOptions();
+
+	// Function to answer a stream of requests, one JSON object a line, such as {"id":7,"fen":"...","depth":3,"multipv":2}.
+	// Every field is optional: "fen" is the usual starting position if it isn't given, and "depth", "nodes" and "time" (in seconds)
+	// replace the default limits if any of them is. With "multipv" the best few moves are found, the later each searched without the
+	// ones before, sharing the node and time limits between them. Each answer is a line of JSON with the request's "id", which is
+	// null if it had none. Answers come in the order they are finished, not the order of the requests.
+	// A line that can't be read is answered with an "error". Returns the number of requests answered.
+	long long RunAnalysisStream(istream& Input, ostream& Output, const StreamOptions& Options);
+
+	// Function to run "batch play|analyse|stream [-depth N] [-time S] [-nodes N] [-games N] [-plies N] [-threads N] [-multipv N]
+	// [-fen FEN] [-input file] [-output file] [-format json|pgn]" from the command line. Nothing is asked and no board is printed.
+	// With "stream" the requests are read from the input file, or the standard input if there isn't one.
+	int RunBatchCommand(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
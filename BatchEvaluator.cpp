@@ -0,0 +1,142 @@
+// OOP Chess Project: BatchEvaluator.cpp.
+// This is the BatchEvaluator class source file.
+// It contains all the definitions related to scoring many positions at once.
+// James Cummins.
+
+// Include the BatchEvaluator and CPU features header files.
+#include "BatchEvaluator.h"
+#include "CpuFeatures.h"
+
+// Using namespaces.
+using namespace BatchNamespace;
+using namespace CpuNamespace;
+
+// Default constructor.
+PositionBatch::PositionBatch() { NumberOfPositions = 0; }
+
+// Access functions.
+size_t PositionBatch::Size() const { return NumberOfPositions; }
+const uint8_t* PositionBatch::GetSquarePlane(int Square) const { return SquarePlanes[Square].data(); }
+
+// Function to reserve space for a number of positions.
+void PositionBatch::Reserve(size_t Capacity)
+{
+	for (auto& Plane : SquarePlanes) { Plane.reserve(Capacity); }
+}
+
+// Function to remove every position from the batch.
+void PositionBatch::Clear()
+{
+	for (auto& Plane : SquarePlanes) { Plane.clear(); }
+	NumberOfPositions = 0;
+}
+
+// Function to add a position given as 64 piece codes.
+void PositionBatch::AddPosition(const uint8_t Codes[64])
+{
+	for (int Square = 0; Square < 64; Square++) { SquarePlanes[Square].push_back(Codes[Square]); }
+	NumberOfPositions++;
+}
+
+// Function to add the position currently on a chessboard.
+void PositionBatch::AddPosition(const Board& InputBoard) { AddPosition(InputBoard.GetPieceCodes()); }
+
+// Default constructor.
+BatchEvaluator::BatchEvaluator()
+{
+	BuildTables();
+	UseAVX2 = CpuSupportsAVX2();
+}
+
+// Function to rebuild the score table from the values of the pieces.
+void BatchEvaluator::BuildTables()
+{
+
+	// Empty squares and unused codes score nothing.
+	for (auto& Entry : ScoreTable) { Entry = 0.0f; }
+
+	// Ask one piece of every kind for its value and its position evaluation vector.
+	for (int Code = WhitePawnCode; Code < NumberOfPieceCodes; Code++)
+	{
+		shared_ptr<Piece> TemporaryPiece{ MakePiece(Code, 0, 0) };
+		vector<vector<double>> PosEvalVector{ TemporaryPiece->PositionEvaluation() };
+		for (int i = 0; i < 8; i++)
+		{
+			for (int j = 0; j < 8; j++)
+			{
+				// This mirrors Board::EvaluateBoard: white adds the vector element...
+				// while black subtracts the element of the vector rotated by 180 degrees.
+				double Entry{ TemporaryPiece->GetColour() == "White" ? TemporaryPiece->GetValue() + PosEvalVector[i][j] : TemporaryPiece->GetValue() - PosEvalVector[7 - i][7 - j] };
+				ScoreTable[16 * (8 * i + j) + Code] = static_cast<float>(Entry);
+			}
+		}
+	}
+
+}
+
+// Access function.
+bool BatchEvaluator::IsUsingAVX2() const { return UseAVX2; }
+
+// Mutator function. AVX2 is only switched on if the processor supports it.
+void BatchEvaluator::SetUseAVX2(bool TrueOrFalse) { UseAVX2 = TrueOrFalse && CpuSupportsAVX2(); }
+
+// Function to score every position of the batch.
+void BatchEvaluator::Evaluate(const PositionBatch& Batch, vector<double>& Scores) const
+{
+
+	// Make room for the scores.
+	Scores.resize(Batch.Size());
+
+	// The AVX2 kernel works on eight positions at a time, so the scalar kernel picks up whatever is left over.
+	size_t Vectorised{ 0 };
+	if (UseAVX2)
+	{
+		Vectorised = Batch.Size() - Batch.Size() % 8;
+		EvaluateAVX2(Batch, 0, Vectorised, Scores.data());
+	}
+	EvaluateScalar(Batch, Vectorised, Batch.Size(), Scores.data());
+
+}
+
+// Scalar kernel. The sums are built in single precision and in square order...
+// so that the results match the AVX2 kernel bit for bit.
+void BatchEvaluator::EvaluateScalar(const PositionBatch& Batch, size_t Begin, size_t End, double* Scores) const
+{
+	for (size_t Position = Begin; Position < End; Position++)
+	{
+		float Score{ 0.0f };
+		for (int Square = 0; Square < 64; Square++) { Score += ScoreTable[16 * Square + Batch.GetSquarePlane(Square)[Position]]; }
+		Scores[Position] = Score;
+	}
+}
+
+#ifdef CHESS_X86
+
+// AVX2 kernel. Each iteration scores eight positions: for every square, the eight piece codes are widened...
+// to 32 bit indices and used to gather the eight table entries in one instruction.
+AVX2_TARGET void BatchEvaluator::EvaluateAVX2(const PositionBatch& Batch, size_t Begin, size_t End, double* Scores) const
+{
+	for (size_t Position = Begin; Position < End; Position += 8)
+	{
+		__m256 Score{ _mm256_setzero_ps() };
+		for (int Square = 0; Square < 64; Square++)
+		{
+			__m128i Codes{ _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Batch.GetSquarePlane(Square) + Position)) };
+			__m256i Indices{ _mm256_cvtepu8_epi32(Codes) };
+			Score = _mm256_add_ps(Score, _mm256_i32gather_ps(ScoreTable + 16 * Square, Indices, 4));
+		}
+		// Widen the eight single precision scores to double precision and store them.
+		_mm256_storeu_pd(Scores + Position,     _mm256_cvtps_pd(_mm256_castps256_ps128(Score)));
+		_mm256_storeu_pd(Scores + Position + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(Score, 1)));
+	}
+}
+
+#else
+
+// Without x86 there is no AVX2, so fall back to the scalar kernel.
+void BatchEvaluator::EvaluateAVX2(const PositionBatch& Batch, size_t Begin, size_t End, double* Scores) const
+{
+	EvaluateScalar(Batch, Begin, End, Scores);
+}
+
+#endif
\ No newline at end of file
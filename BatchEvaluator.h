@@ -0,0 +1,103 @@
+// OOP Chess Project: BatchEvaluator.h.
+// This is the BatchEvaluator class header file.
+// It contains all the declarations related to scoring many positions at once.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_BatchEvaluator
+#define MY_CLASS_BatchEvaluator
+
+// Include the relevant libraries.
+#include <cstdint>
+#include "Board.h"
+
+// Using namespaces.
+using namespace BoardNamespace;
+
+// Using a namespace to avoid name collisions.
+namespace BatchNamespace
+{
+
+	// A batch of positions stored as a structure of arrays.
+	// Instead of one 8x8 board per position, there is one array per square...
+	// holding the piece code found on that square in every position of the batch.
+	// This lets the evaluation kernels load the same square of many positions in a single instruction.
+	class PositionBatch {
+
+	// Private member data.
+	private:
+
+		// One plane of piece codes per square. Square index = 8 * x + y, as on the Board.
+		vector<uint8_t> SquarePlanes[64];
+		// The number of positions in the batch.
+		size_t NumberOfPositions;
+
+	// Public member functions.
+	public:
+
+		// Default constructor.
+		PositionBatch();
+		// Destructor.
+		~PositionBatch() {}
+
+		// Access functions.
+		size_t Size() const;
+		const uint8_t* GetSquarePlane(int Square) const;
+
+		// Function to reserve space for a number of positions.
+		void Reserve(size_t Capacity);
+
+		// Function to remove every position from the batch.
+		void Clear();
+
+		// Function to add a position given as 64 piece codes.
+		void AddPosition(const uint8_t Codes[64]);
+
+		// Function to add the position currently on a chessboard.
+		void AddPosition(const Board& InputBoard);
+
+	};
+
+	// BatchEvaluator class.
+	// It computes the same material and position score as Board::EvaluateBoard, for a whole batch at once.
+	class BatchEvaluator {
+
+	// Private member data.
+	private:
+
+		// Combined value and position table, indexed by 16 * square + piece code.
+		// Black entries are already negated and rotated, so a score is just a sum of 64 lookups.
+		float ScoreTable[64 * 16];
+		// Bool that determines if the AVX2 kernel is used when the processor supports it.
+		bool UseAVX2;
+
+		// The two kernels, each scoring positions [Begin, End) of the batch.
+		void EvaluateScalar(const PositionBatch& Batch, size_t Begin, size_t End, double* Scores) const;
+		void EvaluateAVX2(const PositionBatch& Batch, size_t Begin, size_t End, double* Scores) const;
+
+	// Public member functions.
+	public:
+
+		// Default constructor.
+		BatchEvaluator();
+		// Destructor.
+		~BatchEvaluator() {}
+
+		// Function to rebuild the score table from the values of the pieces.
+		void BuildTables();
+
+		// Access function.
+		bool IsUsingAVX2() const;
+
+		// Mutator function. AVX2 is only switched on if the processor supports it.
+		void SetUseAVX2(bool TrueOrFalse);
+
+		// Function to score every position of the batch.
+		void Evaluate(const PositionBatch& Batch, vector<double>& Scores) const;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,510 @@
+// OOP Chess Project: Benchmark.cpp.
+// This is the benchmark source file.
+// It contains the definitions of the speed measurements that can be run from the command line.
+// James Cummins.
+
+// Include the relevant header files.
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Benchmark.h"
+#include "BatchEvaluator.h"
+#include "GameManager.h"
+#include "Renderer.h"
+
+// Using namespaces.
+using namespace BenchmarkNamespace;
+using namespace BatchNamespace;
+using namespace GameNamespace;
+using namespace RenderNamespace;
+
+// Non member function to fill an array of piece codes with a random, roughly realistic position.
+// The starting set of pieces is thinned out at random and the survivors are scattered over the board.
+void RandomPositionCodes(mt19937& Generator, uint8_t Codes[64])
+{
+
+	// The pieces of the starting position, kings first so that they are never removed.
+	const string Pieces{ "KkQqRRrrBBbbNNnnPPPPPPPPpppppppp" };
+	uniform_real_distribution<double> Uniform(0.0, 1.0);
+	double RemovalChance{ 0.8 * Uniform(Generator) };
+
+	// Fill the board with the surviving pieces and then shuffle the squares.
+	int Square{ 0 };
+	for (size_t i = 0; i < Pieces.size(); i++)
+	{
+		if (i < 2 || Uniform(Generator) > RemovalChance) { Codes[Square++] = static_cast<uint8_t>(SymbolToPieceCode(Pieces[i])); }
+	}
+	while (Square < 64) { Codes[Square++] = NoPieceCode; }
+	shuffle(Codes, Codes + 64, Generator);
+
+	// A pawn can't stand on the first or last rank, so swap any there with a piece or an empty square from the middle of the board.
+	uniform_int_distribution<int> Middle(8, 55);
+	for (int Edge = 0; Edge < 64; Edge = Edge == 7 ? 56 : Edge + 1)
+	{
+		while (Codes[Edge] == WhitePawnCode || Codes[Edge] == BlackPawnCode)
+		{
+			int Other{ Middle(Generator) };
+			if (Codes[Other] != WhitePawnCode && Codes[Other] != BlackPawnCode) { swap(Codes[Edge], Codes[Other]); }
+		}
+	}
+
+}
+
+// Non member function to build a set of middlegame positions by playing random moves from the start, always leaving white to move.
+static vector<vector<PackedMove>> RandomOpenings()
+{
+	mt19937 Generator(12345);
+	vector<vector<PackedMove>> Openings;
+	for (int Game = 0; Game < 12; Game++)
+	{
+		Board TheBoard;
+		TheBoard.InitialiseBoard();
+		GameManager TheGame(&TheBoard);
+		vector<PackedMove> Played;
+		for (int Ply = 0; Ply < 12 + 2 * (Game % 4); Ply++)
+		{
+			vector<PackedMove> Moves{ TheGame.AllPossibleMoves(Ply % 2 == 0 ? "White" : "Black") };
+			if (Moves.empty()) { break; }
+			Played.push_back(Moves[Generator() % Moves.size()]);
+			TheGame.MakeMove(Played.back());
+		}
+		if (Played.size() % 2 == 0) { Openings.push_back(Played); }
+	}
+	return Openings;
+}
+
+// Non member function to time a callable and return the elapsed time in seconds.
+template <class F> double TimeInSeconds(F Function)
+{
+	auto Start = chrono::steady_clock::now();
+	Function();
+	auto End = chrono::steady_clock::now();
+	return chrono::duration<double>(End - Start).count();
+}
+
+// Function to run the benchmarks named on the command line.
+int BenchmarkNamespace::RunBenchmarks(int argc, char* argv[])
+{
+
+	// The benchmark name and its optional argument come after "bench".
+	string Name{ argc > 2 ? argv[2] : "batch" };
+	string Argument{ argc > 3 ? argv[3] : "" };
+
+	// The nnue benchmark takes a network file and perft takes nothing. The others take a count, or a depth for lazy, which must be a positive whole number.
+	size_t Count{ 0 };
+	if (!Argument.empty() && Name != "nnue" && Name != "perft")
+	{
+		// Exception handling in case the argument isn't a number.
+		try
+		{
+			size_t Used{ 0 };
+			long long Value{ stoll(Argument, &Used) };
+			if (Used != Argument.size() || Value <= 0 || (Name == "lazy" && Value > 64)) { throw invalid_argument(Argument); }
+			Count = static_cast<size_t>(Value);
+		}
+		catch (exception&) { cerr << "Error: " << Argument << " is not a valid argument for the " << Name << " benchmark." << endl; return 1; }
+	}
+
+	if (Name == "batch") { BenchmarkBatchEvaluation(Count == 0 ? 1000000 : Count); return 0; }
+	if (Name == "nnue")  { BenchmarkNeuralEvaluation(Argument); return 0; }
+	if (Name == "lazy")  { BenchmarkLazyEvaluation(Count == 0 ? 3 : static_cast<int>(Count)); return 0; }
+	if (Name == "attacks") { BenchmarkAttackMaps(Count == 0 ? 100000 : Count); return 0; }
+	if (Name == "fen")   { BenchmarkFEN(Count == 0 ? 100000 : Count); return 0; }
+	if (Name == "render") { BenchmarkRendering(Count == 0 ? 100000 : Count); return 0; }
+	if (Name == "perft") { return BenchmarkPerft() ? 0 : 1; }
+
+	// If the name is not recognised, print an error message.
+	cerr << "Error: Unknown benchmark '" << Name << "'. Available: batch, nnue, lazy, attacks, fen, render, perft." << endl;
+	return 1;
+
+}
+
+// Function to compare the positions per second of the scalar and AVX2 batch evaluators.
+void BenchmarkNamespace::BenchmarkBatchEvaluation(size_t NumberOfPositions)
+{
+
+	// Build the batch from random positions, with a fixed seed so that runs can be compared.
+	mt19937 Generator(12345);
+	PositionBatch Batch;
+	Batch.Reserve(NumberOfPositions);
+	vector<uint8_t> FirstCodes;
+	for (size_t i = 0; i < NumberOfPositions; i++)
+	{
+		uint8_t Codes[64];
+		RandomPositionCodes(Generator, Codes);
+		Batch.AddPosition(Codes);
+		// Keep a copy of the first few positions for the per-board comparison below.
+		if (i < 10000) { FirstCodes.insert(FirstCodes.end(), Codes, Codes + 64); }
+	}
+
+	// Score the batch with both kernels. Each kernel is run a few times and the best time is kept.
+	const int Repeats{ 5 };
+	BatchEvaluator Evaluator;
+	vector<double> ScalarScores, SIMDScores;
+	double ScalarTime{ 1e30 }, SIMDTime{ 1e30 };
+	Evaluator.SetUseAVX2(false);
+	for (int r = 0; r < Repeats; r++) { ScalarTime = min(ScalarTime, TimeInSeconds([&]() { Evaluator.Evaluate(Batch, ScalarScores); })); }
+	Evaluator.SetUseAVX2(true);
+	bool HaveAVX2{ Evaluator.IsUsingAVX2() };
+	if (HaveAVX2) { for (int r = 0; r < Repeats; r++) { SIMDTime = min(SIMDTime, TimeInSeconds([&]() { Evaluator.Evaluate(Batch, SIMDScores); })); } }
+
+	// For reference, score the first positions one Board object at a time, as the game does.
+	size_t BoardCount{ FirstCodes.size() / 64 };
+	vector<Board> Boards(BoardCount);
+	for (size_t b = 0; b < BoardCount; b++)
+	{
+		for (int Square = 0; Square < 64; Square++)
+		{
+			shared_ptr<Piece> TemporaryPiece{ MakePiece(FirstCodes[64 * b + Square], Square / 8, Square % 8) };
+			if (TemporaryPiece) { Boards[b].AddPiece(TemporaryPiece); }
+		}
+	}
+	vector<double> BoardScores(BoardCount);
+	double BoardTime{ TimeInSeconds([&]() { for (size_t b = 0; b < BoardCount; b++) { BoardScores[b] = Boards[b].EvaluateBoard(); } }) };
+
+	// Check that every path agrees with Board::EvaluateBoard.
+	size_t Mismatches{ 0 };
+	for (size_t b = 0; b < BoardCount; b++)
+	{
+		if (BoardScores[b] != ScalarScores[b] || (HaveAVX2 && BoardScores[b] != SIMDScores[b])) { Mismatches++; }
+	}
+	if (HaveAVX2) { Mismatches += !equal(ScalarScores.begin(), ScalarScores.end(), SIMDScores.begin()); }
+
+	// Print the results.
+	cout << "Batch evaluation benchmark: " << NumberOfPositions << " positions." << endl;
+	cout << fixed << setprecision(0);
+	cout << "Board::EvaluateBoard : " << setw(12) << BoardCount / BoardTime << " positions/second (" << BoardCount << " boards)." << endl;
+	cout << "Scalar batch kernel  : " << setw(12) << NumberOfPositions / ScalarTime << " positions/second." << endl;
+	if (HaveAVX2)
+	{
+		cout << "AVX2 batch kernel    : " << setw(12) << NumberOfPositions / SIMDTime << " positions/second." << endl;
+		cout << setprecision(2) << "AVX2 speed-up        : " << ScalarTime / SIMDTime << "x over scalar." << endl;
+	}
+	else { cout << "AVX2 batch kernel    : not supported on this processor." << endl; }
+	cout << "Mismatched scores    : " << Mismatches << endl;
+
+}
+
+// Function to measure the neural evaluator.
+void BenchmarkNamespace::BenchmarkNeuralEvaluation(const string& NetworkFile)
+{
+
+	// Load the network, or make a random one.
+	shared_ptr<NeuralNetwork> Network{ make_shared<NeuralNetwork>() };
+	if (NetworkFile.empty() || !Network->LoadFromFile(NetworkFile))
+	{
+		cout << "Using a random network." << endl;
+		Network->InitialiseRandom(12345);
+	}
+
+	// First check that the incrementally updated accumulator agrees with one built from scratch.
+	// Random moves are made and taken back with MakeMove and UnmakeMove, as the search does.
+	mt19937 Generator(12345);
+	Board TheBoard;
+	TheBoard.InitialiseBoard();
+	GameManager TheGame(&TheBoard);
+	TheBoard.EnableNeuralEvaluation(Network);
+	int Mismatches{ 0 }, Checks{ 0 };
+	for (int Ply = 0; Ply < 60; Ply++)
+	{
+		vector<PackedMove> Moves{ TheGame.AllPossibleMoves(Ply % 2 == 0 ? "White" : "Black") };
+		if (Moves.empty()) { break; }
+		// Try every move and take it back, then play a random one.
+		for (PackedMove TheMove : Moves)
+		{
+			TheGame.MakeMove(TheMove);
+			double Incremental{ TheBoard.EvaluateNeural(Ply % 2 == 1) };
+			TheBoard.EnableNeuralEvaluation(Network);
+			Mismatches += Incremental != TheBoard.EvaluateNeural(Ply % 2 == 1);
+			Checks++;
+			TheGame.UnmakeMove();
+		}
+		TheGame.MakeMove(Moves[Generator() % Moves.size()]);
+	}
+
+	// Now time the accumulator and the network directly, with both kernels.
+	const int Iterations{ 200000 };
+	for (int Kernel = 0; Kernel < 2; Kernel++)
+	{
+		Network->SetUseAVX2(Kernel == 1);
+		if (Kernel == 1 && !Network->IsUsingAVX2()) { cout << "AVX2 kernels: not supported on this processor." << endl; break; }
+
+		// Set up the starting position on a bare accumulator.
+		NeuralAccumulator Accumulator(Network);
+		for (int Square = 0; Square < 64; Square++)
+		{
+			shared_ptr<Piece> TemporaryPiece{ TheBoard.GetPiece(Square / 8, Square % 8) };
+			if (TemporaryPiece) { Accumulator.AddPiece(SymbolToPieceCode(TemporaryPiece->GetSymbol()), Square); }
+		}
+		volatile int Sink{ Accumulator.Evaluate(true) };
+
+		// A full evaluation on an up to date accumulator.
+		double EvaluationTime{ TimeInSeconds([&]() { for (int i = 0; i < Iterations; i++) { Sink = Sink + Accumulator.Evaluate(i % 2 == 0); } }) };
+		// A quiet knight move there and back: one column removed and one added per side, twice.
+		const int Knight{ WhiteKnightCode }, From{ 62 }, To{ 45 };
+		double UpdateTime{ TimeInSeconds([&]() {
+			for (int i = 0; i < Iterations; i++)
+			{
+				Accumulator.RemovePiece(Knight, From); Accumulator.AddPiece(Knight, To);
+				Accumulator.RemovePiece(Knight, To);   Accumulator.AddPiece(Knight, From);
+			}
+		}) };
+		// A king move followed by an evaluation, which rebuilds the king's side from scratch.
+		const int King{ WhiteKingCode }, KingFrom{ 60 }, KingTo{ 61 };
+		double RefreshTime{ TimeInSeconds([&]() {
+			for (int i = 0; i < Iterations; i++)
+			{
+				Accumulator.RemovePiece(King, i % 2 == 0 ? KingFrom : KingTo);
+				Accumulator.AddPiece(King, i % 2 == 0 ? KingTo : KingFrom);
+				Sink = Sink + Accumulator.Evaluate(true);
+			}
+		}) };
+
+		// Print the results.
+		cout << (Kernel == 1 ? "AVX2 kernels:" : "Scalar kernels:") << endl;
+		cout << fixed << setprecision(0) << "  Evaluations per second         : " << setw(12) << Iterations / EvaluationTime << endl;
+		cout << setprecision(1) << "  Quiet move update (nanoseconds) : " << setw(12) << 1e9 * UpdateTime / (2.0 * Iterations) << endl;
+		cout << "  King move refresh + evaluation  : " << setw(12) << 1e9 * RefreshTime / Iterations << " nanoseconds" << endl;
+	}
+	cout << "Incremental accumulator mismatches: " << Mismatches << " out of " << Checks << " positions." << endl;
+
+}
+
+// Function to compare lazy evaluation margins.
+void BenchmarkNamespace::BenchmarkLazyEvaluation(int Depth)
+{
+
+	// Make sure the depth is sensible.
+	if (Depth <= 0) { cerr << "Error: The search depth must be at least one." << endl; return; }
+
+	// Build a set of middlegame positions to search.
+	vector<vector<PackedMove>> Openings{ RandomOpenings() };
+
+	// Search every position with each margin. A negative margin switches lazy evaluation off and gives the reference moves.
+	const double Margins[]{ -1.0, 2.5, 5.0, 10.0, 20.0 };
+	vector<PossibleMove> ReferenceMoves;
+	double ReferenceTime{ 0 };
+	cout << "Margin     Time (s)   Speed-up   Early exits   Same best move" << endl;
+	for (double Margin : Margins)
+	{
+		double TotalTime{ 0 };
+		long long Calls{ 0 }, Exits{ 0 };
+		int SameMoves{ 0 };
+		for (size_t i = 0; i < Openings.size(); i++)
+		{
+			Board TheBoard;
+			TheBoard.InitialiseBoard();
+			GameManager TheGame(&TheBoard);
+			for (PackedMove TheMove : Openings[i]) { TheGame.MakeMove(TheMove); }
+			TheGame.SetLazyEvaluationMargin(Margin);
+			TheGame.SetMaxBoardEval(true);
+			// The search shuffles the moves, so use the same random seed for every margin.
+			srand(static_cast<unsigned int>(i));
+			PossibleMove BestMove{};
+			TotalTime += TimeInSeconds([&]() { BestMove = TheGame.MinimaxMove(Depth, true); });
+			Calls += TheGame.GetLazyEvaluationCalls();
+			Exits += TheGame.GetLazyEvaluationExits();
+			if (Margin < 0) { ReferenceMoves.push_back(BestMove); continue; }
+			const PossibleMove& Reference{ ReferenceMoves[i] };
+			SameMoves += BestMove.OriginalX == Reference.OriginalX && BestMove.OriginalY == Reference.OriginalY &&
+				BestMove.MovedX == Reference.MovedX && BestMove.MovedY == Reference.MovedY;
+		}
+		if (Margin < 0) { ReferenceTime = TotalTime; SameMoves = static_cast<int>(Openings.size()); }
+
+		// Print the results for this margin.
+		cout << fixed << setprecision(1) << setw(6) << (Margin < 0 ? string("off") : to_string(Margin).substr(0, 4))
+			<< setprecision(3) << setw(13) << TotalTime << setprecision(2) << setw(11) << ReferenceTime / TotalTime
+			<< setw(13) << (Calls > 0 ? 100.0 * Exits / Calls : 0.0) << "%" << setw(11) << SameMoves << " / " << Openings.size() << endl;
+	}
+
+}
+
+// Function to measure the cost of the attack maps and the positional terms.
+void BenchmarkNamespace::BenchmarkAttackMaps(size_t NumberOfPositions)
+{
+
+	// Make the random positions.
+	mt19937 Generator(12345);
+	vector<uint8_t> Codes(64 * NumberOfPositions);
+	for (size_t n = 0; n < NumberOfPositions; n++) { RandomPositionCodes(Generator, &Codes[64 * n]); }
+
+	// A board is needed for the cheap evaluation, so only a few thousand positions are timed that way.
+	size_t BoardPositions{ min<size_t>(NumberOfPositions, 10000) };
+	vector<unique_ptr<Board>> Boards;
+	for (size_t n = 0; n < BoardPositions; n++)
+	{
+		Boards.push_back(make_unique<Board>());
+		for (int Square = 0; Square < 64; Square++)
+		{
+			if (Codes[64 * n + Square] != NoPieceCode) { Boards.back()->AddPiece(MakePiece(Codes[64 * n + Square], Square / 8, Square % 8)); }
+		}
+	}
+
+	// Time the cheap evaluation, building the maps, and building the maps plus scoring every term.
+	volatile double Sink{ 0 };
+	double CheapTime{ TimeInSeconds([&]() { for (auto& TheBoard : Boards) { Sink = Sink + TheBoard->EvaluateBoard(); } }) };
+	AttackMaps Maps;
+	double BuildTime{ TimeInSeconds([&]() { for (size_t n = 0; n < NumberOfPositions; n++) { Maps.Build(&Codes[64 * n]); Sink = Sink + static_cast<double>(Maps.GetOccupied()); } }) };
+	double TermsTime{ TimeInSeconds([&]() {
+		for (size_t n = 0; n < NumberOfPositions; n++) { Maps.Build(&Codes[64 * n]); Sink = Sink + PositionalScore(Maps.CountTerms(), ActiveParameters()); }
+	}) };
+
+	// Print the results in nanoseconds per position.
+	cout << fixed << setprecision(0);
+	cout << "Material and position tables (EvaluateBoard) : " << setw(8) << 1e9 * CheapTime / BoardPositions << " nanoseconds" << endl;
+	cout << "Building the attack maps                      : " << setw(8) << 1e9 * BuildTime / NumberOfPositions << " nanoseconds" << endl;
+	cout << "Attack maps and every positional term         : " << setw(8) << 1e9 * TermsTime / NumberOfPositions << " nanoseconds" << endl;
+
+	// Search the same positions to depth three with the move ordering off and on. Alpha-beta finds the same score whatever
+	// order the moves are tried in, so only the nodes and time should change. Lazy evaluation is switched off for this,
+	// since its early exits depend on the window and so on the order.
+	vector<vector<PackedMove>> Openings{ RandomOpenings() };
+	const int Depth{ 3 };
+	vector<double> ReferenceScores;
+	double ReferenceTime{ 0 };
+	cout << "Move ordering   Time (s)   Speed-up        Nodes   Same score" << endl;
+	for (bool Ordering : { false, true })
+	{
+		double TotalTime{ 0 };
+		long long Nodes{ 0 };
+		int SameScores{ 0 };
+		for (size_t i = 0; i < Openings.size(); i++)
+		{
+			Board TheBoard;
+			TheBoard.InitialiseBoard();
+			GameManager TheGame(&TheBoard);
+			for (PackedMove TheMove : Openings[i]) { TheGame.MakeMove(TheMove); }
+			TheGame.SetLazyEvaluationMargin(-1);
+			TheGame.SetMoveOrdering(Ordering);
+			SearchResult Result{};
+			TotalTime += TimeInSeconds([&]() { Result = TheGame.LimitedSearch({ Depth, 0, 0.0 }); });
+			Nodes += Result.Nodes;
+			if (!Ordering) { ReferenceScores.push_back(Result.Score); continue; }
+			SameScores += fabs(Result.Score - ReferenceScores[i]) < 1e-9;
+		}
+		if (!Ordering) { ReferenceTime = TotalTime; SameScores = static_cast<int>(Openings.size()); }
+		cout << setw(13) << (Ordering ? "on" : "off") << fixed << setprecision(3) << setw(11) << TotalTime << setprecision(2) << setw(11) << ReferenceTime / TotalTime
+			<< setw(13) << Nodes << setw(8) << SameScores << " / " << Openings.size() << endl;
+	}
+
+}
+
+// Function to measure reading and writing FEN strings, and setting up a board from one.
+void BenchmarkNamespace::BenchmarkFEN(size_t NumberOfPositions)
+{
+
+	// Make the random positions, with a random side to move and counters.
+	mt19937 Generator(12345);
+	vector<FENPosition> Positions(NumberOfPositions);
+	for (auto& Position : Positions)
+	{
+		RandomPositionCodes(Generator, Position.Codes);
+		Position.WhiteToMove = Generator() % 2 == 0;
+		Position.Castling = 0;
+		Position.EnPassantSquare = -1;
+		Position.HalfmoveClock = static_cast<int>(Generator() % 100);
+		Position.FullmoveNumber = 1 + static_cast<int>(Generator() % 200);
+	}
+
+	// Time writing every position into one buffer, and then reading them all back.
+	vector<char> Text(MaximumFENLength * NumberOfPositions);
+	double WriteTime{ TimeInSeconds([&]() { for (size_t n = 0; n < NumberOfPositions; n++) { WriteFEN(Positions[n], &Text[MaximumFENLength * n]); } }) };
+	vector<FENPosition> ReadBack(NumberOfPositions);
+	size_t Failures{ 0 };
+	double ReadTime{ TimeInSeconds([&]() { for (size_t n = 0; n < NumberOfPositions; n++) { Failures += !ParseFEN(&Text[MaximumFENLength * n], ReadBack[n]); } }) };
+
+	// Check that every position came back unchanged.
+	size_t Mismatches{ 0 };
+	for (size_t n = 0; n < NumberOfPositions; n++)
+	{
+		bool Same{ equal(Positions[n].Codes, Positions[n].Codes + 64, ReadBack[n].Codes) && Positions[n].WhiteToMove == ReadBack[n].WhiteToMove
+			&& Positions[n].HalfmoveClock == ReadBack[n].HalfmoveClock && Positions[n].FullmoveNumber == ReadBack[n].FullmoveNumber };
+		Mismatches += !Same;
+	}
+
+	// Setting up a board creates a piece object for every piece, so only a few thousand positions are timed that way.
+	size_t BoardPositions{ min<size_t>(NumberOfPositions, 10000) };
+	Board TheBoard;
+	GameManager TheGame(&TheBoard);
+	double SetupTime{ TimeInSeconds([&]() { for (size_t n = 0; n < BoardPositions; n++) { TheGame.SetPosition(ReadBack[n]); } }) };
+
+	// A snapshot of a game is what a thread is handed to work on, so time taking one and copying it.
+	vector<GameState> States(NumberOfPositions);
+	double SnapshotTime{ TimeInSeconds([&]() { for (size_t n = 0; n < BoardPositions; n++) { States[n] = TheGame.GetState(); } }) };
+	vector<GameState> Copies(NumberOfPositions);
+	double CopyTime{ TimeInSeconds([&]() { copy(States.begin(), States.end(), Copies.begin()); }) };
+
+	// Print the results.
+	cout << fixed << setprecision(0);
+	cout << "Writing a FEN string             : " << setw(8) << 1e9 * WriteTime / NumberOfPositions << " nanoseconds" << endl;
+	cout << "Reading a FEN string             : " << setw(8) << 1e9 * ReadTime / NumberOfPositions << " nanoseconds" << endl;
+	cout << "Setting up the board and game    : " << setw(8) << 1e9 * SetupTime / BoardPositions << " nanoseconds" << endl;
+	cout << "Taking a snapshot of the game    : " << setw(8) << 1e9 * SnapshotTime / BoardPositions << " nanoseconds" << endl;
+	cout << setprecision(1) << "Copying a snapshot (" << sizeof(GameState) << " bytes)   : " << setw(8) << 1e9 * CopyTime / NumberOfPositions << " nanoseconds" << endl;
+	cout << setprecision(0);
+	cout << "Positions that failed to read back: " << Failures + Mismatches << " of " << NumberOfPositions << endl;
+
+}
+
+// Function to measure composing frames of the board.
+void BenchmarkNamespace::BenchmarkRendering(size_t NumberOfFrames)
+{
+
+	// Make some random positions to draw.
+	mt19937 Generator(12345);
+	const size_t NumberOfPositions{ 1024 };
+	vector<uint8_t> Codes(64 * NumberOfPositions);
+	for (size_t n = 0; n < NumberOfPositions; n++) { RandomPositionCodes(Generator, &Codes[64 * n]); }
+
+	// Compose the frames into the same buffer, as the board does, adding up their lengths so the work can't be skipped.
+	char Frame[MaximumFrameLength];
+	size_t AnsiBytes{ 0 }, PlainBytes{ 0 };
+	double AnsiTime{ TimeInSeconds([&]() { for (size_t n = 0; n < NumberOfFrames; n++) { AnsiBytes += ComposeBoardFrame(&Codes[64 * (n % NumberOfPositions)], 15, 0, AnsiBackend, Frame); } }) };
+	double PlainTime{ TimeInSeconds([&]() { for (size_t n = 0; n < NumberOfFrames; n++) { PlainBytes += ComposeBoardFrame(&Codes[64 * (n % NumberOfPositions)], 15, 0, PlainBackend, Frame); } }) };
+
+	// Compose the updates incremental drawing sends after a move: each position with its first piece moved to the last square.
+	vector<uint8_t> Moved(Codes);
+	for (size_t n = 0; n < NumberOfPositions; n++)
+	{
+		uint8_t* Position{ &Moved[64 * n] };
+		int From{ 0 };
+		while (From < 63 && Position[From] == 0) { From++; }
+		Position[63] = Position[From];
+		Position[From] = 0;
+	}
+	size_t UpdateBytes{ 0 };
+	double UpdateTime{ TimeInSeconds([&]() { for (size_t n = 0; n < NumberOfFrames; n++) { size_t Index{ 64 * (n % NumberOfPositions) }; UpdateBytes += ComposeBoardUpdate(&Codes[Index], &Moved[Index], 15, 0, Frame); } }) };
+
+	// Print the results.
+	cout << fixed << setprecision(0);
+	cout << "Composing a frame with colour    : " << setw(8) << 1e9 * AnsiTime / NumberOfFrames << " nanoseconds, " << AnsiBytes / NumberOfFrames << " bytes" << endl;
+	cout << "Composing a frame without colour : " << setw(8) << 1e9 * PlainTime / NumberOfFrames << " nanoseconds, " << PlainBytes / NumberOfFrames << " bytes" << endl;
+	cout << "Composing the update after a move: " << setw(8) << 1e9 * UpdateTime / NumberOfFrames << " nanoseconds, " << UpdateBytes / NumberOfFrames << " bytes" << endl;
+
+}
+
+// Function to count the standard perft positions with the light move generator.
+bool BenchmarkNamespace::BenchmarkPerft()
+{
+
+	// Count every position, comparing the counts with the published ones.
+	bool AllCorrect{ true };
+	cout << "Depth        Nodes     Expected   Nodes per second   Position" << endl;
+	for (const PerftCheck& Check : StandardPerftChecks)
+	{
+		FENPosition Position;
+		ParseFEN(Check.FEN, Position);
+		uint64_t Nodes{ 0 };
+		double Time{ TimeInSeconds([&]() { Nodes = Perft(Position, Check.Depth); }) };
+		AllCorrect = AllCorrect && Nodes == Check.Nodes;
+		cout << setw(5) << Check.Depth << setw(13) << Nodes << setw(13) << Check.Nodes << fixed << setprecision(0) << setw(19) << Nodes / Time
+			<< "   " << Check.FEN << (Nodes == Check.Nodes ? "" : "   WRONG") << endl;
+	}
+	if (AllCorrect) { cout << "Every count is correct." << endl; }
+	else { cerr << "Error: Some perft counts are wrong." << endl; }
+	return AllCorrect;
+
+}
\ No newline at end of file
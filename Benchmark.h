@@ -0,0 +1,48 @@
+// OOP Chess Project: Benchmark.h.
+// This is the benchmark header file.
+// It contains the declarations of the speed measurements that can be run from the command line.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Benchmark
+#define MY_CLASS_Benchmark
+
+// Include the relevant libraries.
+#include <string>
+
+// Using a namespace to avoid name collisions.
+namespace BenchmarkNamespace
+{
+
+	// Function to run the benchmarks named on the command line (e.g. "bench batch 1000000", "bench nnue ChessNet.nnue" or "bench lazy 3", "bench attacks 100000", "bench fen 100000" or "bench render 100000").
+	int RunBenchmarks(int argc, char* argv[]);
+
+	// Function to compare the positions per second of the scalar and AVX2 batch evaluators.
+	void BenchmarkBatchEvaluation(size_t NumberOfPositions);
+
+	// Function to measure the neural evaluator: evaluations per second and the cost of accumulator updates.
+	// If no network file is given, random weights are used, which cost exactly the same to evaluate.
+	void BenchmarkNeuralEvaluation(const std::string& NetworkFile);
+
+	// Function to compare lazy evaluation margins: search time, how often the early exit fires,
+	// and how often the best move still agrees with a search that never exits early.
+	void BenchmarkLazyEvaluation(int Depth);
+
+	// Function to measure the cost of the attack maps and the positional terms against the cheap evaluation,
+	// and to check that ordering moves by the attack maps speeds the search up without changing its scores.
+	void BenchmarkAttackMaps(size_t NumberOfPositions);
+
+	// Function to measure reading and writing FEN strings, and setting up a board from one.
+	void BenchmarkFEN(size_t NumberOfPositions);
+
+	// Function to measure composing frames of the board, with and without colour.
+	void BenchmarkRendering(size_t NumberOfFrames);
+
+	// Function to count the standard perft positions with the light move generator and time it.
+	// Returns false if any count is different from the published one.
+	bool BenchmarkPerft();
+
+}
+
+#endif
\ No newline at end of file
@@ -5,34 +5,11 @@
 
 // Include the Board header file.
 #include "Board.h"
+#include "Renderer.h"
 
 // Using namespaces.
 using namespace BoardNamespace;
-
-// Non member handle function. This is important for the colour function.
-HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-
-// Non member rotate function. This is important for rotating the position evaluation 2D vector.
-void Rotate(vector<vector<double>>& Vector)
-{
-
-	// Find the dimensions of the 2D vector (will be 8x8).
-	size_t M = Vector.size();
-	size_t N = Vector[0].size();
-
-	// Iterate over the vector, swapping values as appropriate.
-	for (size_t i = 0; i < M / 2; i++) {
-		for (size_t j = 0; j < N; j++) {
-			swap(Vector[i][j], Vector[M - i - 1][N - j - 1]);
-		}
-	}
-	if (M & 1) {
-		for (size_t i = 0; i < N / 2; i++) {
-			swap(Vector[M / 2][i], Vector[M / 2][N - i - 1]);
-		}
-	}
-
-}
+using namespace RenderNamespace;
 
 // Default constructor.
 Board::Board()
@@ -66,6 +43,14 @@ Board::Board()
 	ComputerOriginalX = ComputerOriginalY = ComputerMovedX = ComputerMovedY = 0;
 	// Set the computer pieces to null pointers.
 	ComputerMovedPiece = ComputerCapturedPiece = ComputerEnPassantPiece = ComputerPromotedPawn = nullptr;
+	// No piece has moved yet.
+	LastPieceSquare = -1;
+	// The board is empty.
+	for (auto& Code : PieceCodes) { Code = NoPieceCode; }
+	MapsAreCurrent = false;
+	// The board is drawn in bright white on black until told otherwise.
+	BoardTextColour = 15;
+	BoardBackgroundColour = 0;
 
 }
 
@@ -74,6 +59,7 @@ char Board::GetBoardSymbol(int xCoordinate, int yCoordinate) const { return Ches
 // Overloading the GetPiece function.
 shared_ptr<Piece> Board::GetPiece(Point InputPoint)          const { return ChessBoard[InputPoint.GetX()][InputPoint.GetY()]; }
 shared_ptr<Piece> Board::GetPiece(int InputX, int InputY)    const { return ChessBoard[InputX][InputY]; }
+const uint8_t* Board::GetPieceCodes()                        const { return PieceCodes; }
 
 // More access functions.
 int Board::GetComputerOriginalX() const { return ComputerOriginalX; }
@@ -84,6 +70,7 @@ shared_ptr<Piece> Board::GetComputerMovedPiece()     const { return ComputerMove
 shared_ptr<Piece> Board::GetComputerCapturedPiece()  const { return ComputerCapturedPiece; }
 shared_ptr<Piece> Board::GetComputerEnPassantPiece() const { return ComputerEnPassantPiece; }
 shared_ptr<Piece> Board::GetComputerPromotedPawn()   const { return ComputerPromotedPawn; }
+int Board::GetLastPieceSquare() const { return LastPieceSquare; }
 
 // Mutator function to set the moved and captured computer pieces.
 void Board::SetComputerPieces(shared_ptr<Piece> MovedPiece, shared_ptr<Piece> CapturedPiece)
@@ -143,48 +130,164 @@ void Board::InitialiseBoard()
 			ChessBoard[i][j] = nullptr;
 		}
 	}
+	// Every piece is new, so none of them has moved.
+	LastPieceSquare = -1;
+
+	// The whole board has changed, so rebuild the piece codes, and the neural accumulator if there is one.
+	for (int i = 0; i < 8; i++)
+	{
+		for (int j = 0; j < 8; j++) { PieceCodes[8 * i + j] = static_cast<uint8_t>(ChessBoard[i][j] ? SymbolToPieceCode(ChessBoard[i][j]->GetSymbol()) : NoPieceCode); }
+	}
+	MapsAreCurrent = false;
+	if (Accumulator) { RefreshNeuralAccumulator(); }
 
 }
 
-// This function allows the colour of the text and background to be set with integers.
-void Board::SetColourAndBackground(int ForegroundColour, int BackgroundColour)
+// Function to set up the chessboard from a FEN position.
+void Board::SetPosition(const FENPosition& Position)
 {
-	WORD WordColour = ((BackgroundColour & 0x0F) << 4) + (ForegroundColour & 0x0F);
-	SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), WordColour);
+
+	// Place the pieces, and clear whatever the computer last moved.
+	for (int i = 0; i < 8; i++)
+	{
+		for (int j = 0; j < 8; j++)
+		{
+			ChessBoard[i][j] = MakePiece(Position.Codes[8 * i + j], i, j);
+			PieceCodes[8 * i + j] = ChessBoard[i][j] ? Position.Codes[8 * i + j] : static_cast<uint8_t>(NoPieceCode);
+		}
+	}
+	ComputerOriginalX = ComputerOriginalY = ComputerMovedX = ComputerMovedY = 0;
+	ComputerMovedPiece = ComputerCapturedPiece = ComputerEnPassantPiece = ComputerPromotedPawn = nullptr;
+	LastPieceSquare = -1;
+
+	// A king or rook can only castle if its turn number is zero, so every one that has lost the right is given a turn.
+	// The castling rights only count if the king and rook are still on their starting squares.
+	const int Rows[2]{ 7, 0 };
+	const char Kings[2]{ 'K', 'k' }, Rooks[2]{ 'R', 'r' };
+	const int Kingside[2]{ WhiteKingside, BlackKingside }, Queenside[2]{ WhiteQueenside, BlackQueenside };
+	for (int i = 0; i < 8; i++)
+	{
+		for (int j = 0; j < 8; j++)
+		{
+			if (ChessBoard[i][j] && (ChessBoard[i][j]->GetName() == "King" || ChessBoard[i][j]->GetName() == "Rook")) { ChessBoard[i][j]->SetTurn(1); }
+		}
+	}
+	for (int Side = 0; Side < 2; Side++)
+	{
+		int Row{ Rows[Side] };
+		if (!ChessBoard[Row][4] || ChessBoard[Row][4]->GetSymbol() != Kings[Side]) { continue; }
+		bool CanCastleKingside{ (Position.Castling & Kingside[Side]) && ChessBoard[Row][7] && ChessBoard[Row][7]->GetSymbol() == Rooks[Side] };
+		bool CanCastleQueenside{ (Position.Castling & Queenside[Side]) && ChessBoard[Row][0] && ChessBoard[Row][0]->GetSymbol() == Rooks[Side] };
+		if (CanCastleKingside)  { ChessBoard[Row][7]->SetTurn(0); }
+		if (CanCastleQueenside) { ChessBoard[Row][0]->SetTurn(0); }
+		if (CanCastleKingside || CanCastleQueenside) { ChessBoard[Row][4]->SetTurn(0); }
+	}
+
+	// A pawn can only double step if its turn number is zero, so pawns that have left their starting rank are given a turn.
+	for (int i = 0; i < 8; i++)
+	{
+		for (int j = 0; j < 8; j++)
+		{
+			if (ChessBoard[i][j] && ChessBoard[i][j]->GetSymbol() == 'P' && i != 6) { ChessBoard[i][j]->SetTurn(1); }
+			if (ChessBoard[i][j] && ChessBoard[i][j]->GetSymbol() == 'p' && i != 1) { ChessBoard[i][j]->SetTurn(1); }
+		}
+	}
+
+	// A pawn can be captured en passant if it has moved once and was the last piece to move.
+	if (Position.EnPassantSquare >= 0 && Position.EnPassantSquare < 64)
+	{
+		int Row{ Position.EnPassantSquare / 8 }, Column{ Position.EnPassantSquare % 8 };
+		if (Row == 2 && ChessBoard[3][Column] && ChessBoard[3][Column]->GetSymbol() == 'p') { SetLastPieceSquare(8 * 3 + Column); }
+		if (Row == 5 && ChessBoard[4][Column] && ChessBoard[4][Column]->GetSymbol() == 'P') { SetLastPieceSquare(8 * 4 + Column); }
+	}
+
+	// The whole board has changed, so rebuild the neural accumulator if there is one.
+	MapsAreCurrent = false;
+	if (Accumulator) { RefreshNeuralAccumulator(); }
+
 }
 
-// Function to print the board.
-void Board::PrintBoard()
+// Function to fill in a FEN position from the chessboard.
+void Board::GetPosition(FENPosition& Position) const
 {
 
-	// Print the coordinate labels for the user.
-	cout << "\n        a     b     c     d     e     f     g     h   " << endl;
-	cout << "      _____ _____ _____ _____ _____ _____ _____ _____ ";
-	for (int i = 0; i < 8; i++) {
-		cout << "\n     |     |     |     |     |     |     |     |     |";
-		cout << "\n  " << 8 - i << "  ";
+	// The placement is just the piece codes.
+	for (int Square = 0; Square < 64; Square++) { Position.Codes[Square] = PieceCodes[Square]; }
+
+	// A side can still castle if its king and the rook have never moved.
+	Position.Castling = 0;
+	auto Unmoved = [&](int x, int y, char Symbol) { return ChessBoard[x][y] && ChessBoard[x][y]->GetSymbol() == Symbol && ChessBoard[x][y]->GetTurn() == 0; };
+	if (Unmoved(7, 4, 'K') && Unmoved(7, 7, 'R')) { Position.Castling |= WhiteKingside; }
+	if (Unmoved(7, 4, 'K') && Unmoved(7, 0, 'R')) { Position.Castling |= WhiteQueenside; }
+	if (Unmoved(0, 4, 'k') && Unmoved(0, 7, 'r')) { Position.Castling |= BlackKingside; }
+	if (Unmoved(0, 4, 'k') && Unmoved(0, 0, 'r')) { Position.Castling |= BlackQueenside; }
+
+	// If the last move was a double step, the square the pawn passed over is the en passant square.
+	Position.EnPassantSquare = -1;
+	for (int j = 0; j < 8; j++)
+	{
+		if (ChessBoard[4][j] && ChessBoard[4][j]->GetSymbol() == 'P' && ChessBoard[4][j]->GetTurn() == 1 && ChessBoard[4][j]->GetLastPiece()) { Position.EnPassantSquare = 8 * 5 + j; }
+		if (ChessBoard[3][j] && ChessBoard[3][j]->GetSymbol() == 'p' && ChessBoard[3][j]->GetTurn() == 1 && ChessBoard[3][j]->GetLastPiece()) { Position.EnPassantSquare = 8 * 2 + j; }
+	}
+
+}
+
+// Function to put a piece (or a null pointer) on a square.
+// Every change to the board after initialisation goes through here so that the neural accumulator and the piece codes see it.
+void Board::SetSquare(int xCoordinate, int yCoordinate, shared_ptr<Piece> NewPiece)
+{
+
+	// Tell the accumulator about the piece that leaves the square and the piece that arrives.
+	if (Accumulator)
+	{
+		int Square{ 8 * xCoordinate + yCoordinate };
+		if (ChessBoard[xCoordinate][yCoordinate]) { Accumulator->RemovePiece(SymbolToPieceCode(ChessBoard[xCoordinate][yCoordinate]->GetSymbol()), Square); }
+		if (NewPiece) { Accumulator->AddPiece(SymbolToPieceCode(NewPiece->GetSymbol()), Square); }
+	}
+
+	// Update the chessboard and the piece codes. The attack maps are now out of date.
+	ChessBoard[xCoordinate][yCoordinate] = NewPiece;
+	PieceCodes[8 * xCoordinate + yCoordinate] = static_cast<uint8_t>(NewPiece ? SymbolToPieceCode(NewPiece->GetSymbol()) : NoPieceCode);
+	MapsAreCurrent = false;
+
+}
+
+// Function to rebuild the neural accumulator from every piece on the board.
+void Board::RefreshNeuralAccumulator()
+{
+	Accumulator->Clear();
+	for (int i = 0; i < 8; i++)
+	{
 		for (int j = 0; j < 8; j++)
 		{
-			cout << "|  ";
-			// If the chessboard is not empty at (i, j), enter this section.
-			if (ChessBoard[i][j] != nullptr)
-			{
-				// If the piece is white, then set the colour and backgound
-				if (ChessBoard[i][j]->GetColour() == "White") { SetColourAndBackground(0, 15); }
-				// Print the symbol of the piece.
-				cout << ChessBoard[i][j]->GetSymbol();
-				// Reset the colour and background.
-				SetColourAndBackground(15, 0);
-			}
-			else { cout << " "; }
-			cout << "  ";
+			if (ChessBoard[i][j]) { Accumulator->AddPiece(SymbolToPieceCode(ChessBoard[i][j]->GetSymbol()), 8 * i + j); }
 		}
-		cout << "|  " << 8 - i << "\n     |_____|_____|_____|_____|_____|_____|_____|_____|";
 	}
-	cout << "\n\n        a     b     c     d     e     f     g     h   " << endl;
+}
 
+// Function to switch on the neural evaluation with the given network.
+void Board::EnableNeuralEvaluation(shared_ptr<const NeuralNetwork> Network)
+{
+	Accumulator = make_unique<NeuralAccumulator>(Network);
+	RefreshNeuralAccumulator();
 }
 
+// Function to switch off the neural evaluation.
+void Board::DisableNeuralEvaluation() { Accumulator.reset(); }
+
+// Access function.
+bool Board::HasNeuralEvaluation() const { return Accumulator != nullptr; }
+
+// This function allows the colour of the text and background to be set with integers.
+void Board::SetColourAndBackground(int ForegroundColour, int BackgroundColour)
+{
+	BoardTextColour = ForegroundColour & 0x0F;
+	BoardBackgroundColour = BackgroundColour & 0x0F;
+}
+
+// Function to print the board.
+void Board::PrintBoard() { DrawBoard(PieceCodes, BoardTextColour, BoardBackgroundColour); }
+
 // Function to move a piece and update the relevant values.
 void Board::MovePiece(int OldX, int OldY, int NewX, int NewY)
 {
@@ -202,12 +305,12 @@ void Board::MovePiece(int OldX, int OldY, int NewX, int NewY)
 	if (EnPassantMove(OldX, OldY, NewX, NewY) && NewX == 2)
 	{
 		ComputerEnPassantPiece = ChessBoard[3][NewY];
-		ChessBoard[3][NewY] = nullptr;
+		SetSquare(3, NewY, nullptr);
 	}
 	if (EnPassantMove(OldX, OldY, NewX, NewY) && NewX == 5)
 	{
 		ComputerEnPassantPiece = ChessBoard[4][NewY];
-		ChessBoard[4][NewY] = nullptr;
+		SetSquare(4, NewY, nullptr);
 	}
 
 	// In the case that the move is a castling move, set the appropriate pieces.
@@ -215,15 +318,15 @@ void Board::MovePiece(int OldX, int OldY, int NewX, int NewY)
 	{
 		shared_ptr<Piece> TemporaryCastledPiece{ ChessBoard[OldX][NewY + 1] };
 		TemporaryCastledPiece->SetPosition(Point(OldX, NewY - 1));
-		ChessBoard[OldX][NewY - 1] = TemporaryCastledPiece;
-		ChessBoard[OldX][NewY + 1] = nullptr;
+		SetSquare(OldX, NewY - 1, TemporaryCastledPiece);
+		SetSquare(OldX, NewY + 1, nullptr);
 	}
 	if (CastlingMove(OldX, OldY, NewX, NewY) && NewY - OldY == -2)
 	{
 		shared_ptr<Piece> TemporaryCastledPiece = ChessBoard[OldX][NewY - 2];
 		TemporaryCastledPiece->SetPosition(Point(OldX, NewY + 1));
-		ChessBoard[OldX][NewY + 1] = TemporaryCastledPiece;
-		ChessBoard[OldX][NewY - 2] = nullptr;
+		SetSquare(OldX, NewY + 1, TemporaryCastledPiece);
+		SetSquare(OldX, NewY - 2, nullptr);
 	}
 
 	// In the case that the move is a pawn promotion move.
@@ -239,9 +342,9 @@ void Board::MovePiece(int OldX, int OldY, int NewX, int NewY)
 	// Iterate the turn number of the piece.
 	TemporaryPiece->IterateTurn(1);
 	// Place the piece in the new position.
-	ChessBoard[NewX][NewY] = TemporaryPiece;
+	SetSquare(NewX, NewY, TemporaryPiece);
 	// Set the old position to be a null pointer.
-	ChessBoard[OldX][OldY] = nullptr;
+	SetSquare(OldX, OldY, nullptr);
 	// If it was a pawn promotion move, promote the pawn.
 	if (PromotePawnBool) { PromotePawn(NewX, NewY); }
 
@@ -256,9 +359,9 @@ void Board::MovePieceAndDoNothing(int OldX, int OldY, int NewX, int NewY)
 	// Set the new position of the piece.
 	TemporaryPiece->SetPosition(Point(NewX, NewY));
 	// Place the piece in the new position.
-	ChessBoard[NewX][NewY] = TemporaryPiece;
+	SetSquare(NewX, NewY, TemporaryPiece);
 	// Set the old position to be a null pointer.
-	ChessBoard[OldX][OldY] = nullptr;
+	SetSquare(OldX, OldY, nullptr);
 
 }
 
@@ -532,10 +635,10 @@ void Board::PromotePawn(int xCoordinate, int yCoordinate)
 	bool   LastPiece{ ChessBoard[xCoordinate][yCoordinate]->GetLastPiece() };
 	
 	// Set the position to a null pointer.
-	ChessBoard[xCoordinate][yCoordinate] = nullptr;
+	SetSquare(xCoordinate, yCoordinate, nullptr);
 	// Now put either a white or black queen on the chessboard, as appropriate.
-	if (Colour == "White") { ChessBoard[xCoordinate][yCoordinate] = make_shared<WhiteQueen>(xCoordinate, yCoordinate); }
-	if (Colour == "Black") { ChessBoard[xCoordinate][yCoordinate] = make_shared<BlackQueen>(xCoordinate, yCoordinate); }
+	if (Colour == "White") { SetSquare(xCoordinate, yCoordinate, make_shared<WhiteQueen>(xCoordinate, yCoordinate)); }
+	if (Colour == "Black") { SetSquare(xCoordinate, yCoordinate, make_shared<BlackQueen>(xCoordinate, yCoordinate)); }
 	// Set the turn number and last piece variable of the new queen.
 	ChessBoard[xCoordinate][yCoordinate]->SetTurn(TurnNumber);
 	ChessBoard[xCoordinate][yCoordinate]->SetLastPiece(LastPiece);
@@ -552,10 +655,10 @@ void Board::UnPromotePawn(int xCoordinate, int yCoordinate)
 	bool   LastPiece{ ChessBoard[xCoordinate][yCoordinate]->GetLastPiece() };
 	
 	// Set the position to a null pointer.
-	ChessBoard[xCoordinate][yCoordinate] = nullptr;
+	SetSquare(xCoordinate, yCoordinate, nullptr);
 	// Now put either a white or black pawn on the chessboard, as appropriate.
-	if (Colour == "White") { ChessBoard[xCoordinate][yCoordinate] = make_shared<WhitePawn>(xCoordinate, yCoordinate); }
-	if (Colour == "Black") { ChessBoard[xCoordinate][yCoordinate] = make_shared<BlackPawn>(xCoordinate, yCoordinate); }
+	if (Colour == "White") { SetSquare(xCoordinate, yCoordinate, make_shared<WhitePawn>(xCoordinate, yCoordinate)); }
+	if (Colour == "Black") { SetSquare(xCoordinate, yCoordinate, make_shared<BlackPawn>(xCoordinate, yCoordinate)); }
 	// Set the turn number and last piece variable of the new pawn.
 	ChessBoard[xCoordinate][yCoordinate]->SetTurn(TurnNumber);
 	ChessBoard[xCoordinate][yCoordinate]->SetLastPiece(LastPiece);
@@ -577,8 +680,8 @@ bool Board::KingInCheck(string Colour)
 		cerr << "Error: The colour of the player could not be identified." << endl;
 	}
 
-	// Declare the coordinates of the king piece.
-	int KingXCoordinate, KingYCoordinate;
+	// Declare the coordinates of the king piece. A board without the king can't put it in check.
+	int KingXCoordinate{ -1 }, KingYCoordinate{ -1 };
 
 	// These loops find the position of the king.
 	for (int i = 0; i < 8; i++) {
@@ -593,6 +696,8 @@ bool Board::KingInCheck(string Colour)
 		}
 	}
 
+	if (KingXCoordinate < 0) { return false; }
+
 	// If an opposition piece can capture the king, return true.
 	for (int i = 0; i < 8; i++) {
 		for (int j = 0; j < 8; j++) {
@@ -608,22 +713,14 @@ bool Board::KingInCheck(string Colour)
 
 }
 
-// Function to set the variable 'LastPiece' to false for every piece.
-void Board::SetBoardLastPieceFalse()
+// Function to make the piece on a square (or no piece, for -1) the last piece to have moved.
+void Board::SetLastPieceSquare(int Square)
 {
 
-	// Iterate through all the pieces on the board.
-	for (int i = 0; i < 8; i++)
-	{
-		for (int j = 0; j < 8; j++)
-		{
-			if (ChessBoard[i][j])
-			{
-				// Set the last piece bool to false.
-				ChessBoard[i][j]->SetLastPiece(false);
-			}
-		}
-	}
+	// Only one piece on the board can have moved last, so only the previous one needs its variable clearing.
+	if (LastPieceSquare >= 0 && ChessBoard[LastPieceSquare / 8][LastPieceSquare % 8]) { ChessBoard[LastPieceSquare / 8][LastPieceSquare % 8]->SetLastPiece(false); }
+	LastPieceSquare = Square;
+	if (Square >= 0 && ChessBoard[Square / 8][Square % 8]) { ChessBoard[Square / 8][Square % 8]->SetLastPiece(true); }
 
 }
 
@@ -633,30 +730,27 @@ double Board::EvaluateBoard()
 
 	// Initialse the score.
 	double Score{ 0 };
+	// The values and position tables come straight from the evaluation parameters (the same numbers the pieces return),
+	// which saves building a 2D vector for every piece.
+	const EvaluationParameters& Parameters{ ActiveParameters() };
 
 	// Iterate over the chessboard.
-	for (int i = 0; i < 8; i++)
+	for (int Square = 0; Square < 64; Square++)
 	{
-		for (int j = 0; j < 8; j++)
+		int Code{ PieceCodes[Square] };
+		if (Code == NoPieceCode) { continue; }
+		int Type{ (Code - 1) % 6 }, i{ Square / 8 }, j{ Square % 8 };
+		if (Code <= WhiteKingCode)
 		{
-			if (ChessBoard[i][j])
-			{
-				// Fetch the 2D position evaluation vector.
-				vector<vector<double>> PosEvalVector{ ChessBoard[i][j]->PositionEvaluation() };
-				if (ChessBoard[i][j]->GetColour() == "White")
-				{
-					// If the colour is white, just add the value and the vector element.
-					Score += ChessBoard[i][j]->GetValue() + PosEvalVector[i][j];
-				}
-				else
-				{
-					// If the colour is black, we first need to rotate the 2D vector by 180 degrees...
-					// because the vector is constructed for the white pieces only...
-					// and then we subtract the vector element when calculating the score.
-					Rotate(PosEvalVector);
-					Score += ChessBoard[i][j]->GetValue() - PosEvalVector[i][j];
-				}
-			}
+			// If the colour is white, just add the value and the table element.
+			Score += Parameters.PieceValues[Type] + Parameters.PositionTables[Type][i][j];
+		}
+		else
+		{
+			// If the colour is black, we use the table rotated by 180 degrees...
+			// because the table is constructed for the white pieces only...
+			// and then we subtract the table element when calculating the score.
+			Score += -Parameters.PieceValues[Type] - Parameters.PositionTables[Type][7 - i][7 - j];
 		}
 	}
 
@@ -665,8 +759,34 @@ double Board::EvaluateBoard()
 
 }
 
+// Function to return the more expensive positional terms of the evaluation.
+// They are all read off the attack maps, which are built once per position.
+double Board::EvaluatePositionalTerms()
+{
+	return PositionalScore(GetAttackMaps().CountTerms(), ActiveParameters());
+}
+
+// Function to return the attack maps of the current position, rebuilding them if the board has changed.
+const AttackMaps& Board::GetAttackMaps()
+{
+	if (!MapsAreCurrent)
+	{
+		Maps.Build(PieceCodes);
+		MapsAreCurrent = true;
+	}
+	return Maps;
+}
+
 // Function to add a piece onto the chessboard.
 void Board::AddPiece(shared_ptr<Piece> ChessPiece)
 {
-	ChessBoard[ChessPiece->GetPoint().GetX()][ChessPiece->GetPoint().GetY()] = ChessPiece;
+	SetSquare(ChessPiece->GetPoint().GetX(), ChessPiece->GetPoint().GetY(), ChessPiece);
+}
+
+// Function to return the neural network evaluation of the chessboard.
+// The network works in centipawns, so the score is divided by ten to match EvaluateBoard where a pawn is worth ten.
+double Board::EvaluateNeural(bool WhiteToMove)
+{
+	if (!Accumulator) { return EvaluateBoard(); }
+	return Accumulator->Evaluate(WhiteToMove) / 10.0;
 }
\ No newline at end of file
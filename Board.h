@@ -9,13 +9,20 @@
 #define MY_CLASS_Board
 
 // Include the relevant libraries.
-#include <windows.h>
 #include <exception>
 #include <memory>
 #include "Pieces.h"
+#include "NeuralEvaluator.h"
+#include "EvalParameters.h"
+#include "AttackMaps.h"
+#include "Fen.h"
 
 // Using namespaces.
 using namespace PieceNamespace;
+using namespace NeuralNamespace;
+using namespace ParameterNamespace;
+using namespace AttackNamespace;
+using namespace FenNamespace;
 using namespace std;
 
 // Using a namespace to avoid name collisions.
@@ -35,6 +42,26 @@ namespace BoardNamespace
 		int ComputerOriginalX, ComputerOriginalY, ComputerMovedX, ComputerMovedY;
 		// The pieces that the computer moves.
 		shared_ptr<Piece> ComputerMovedPiece, ComputerCapturedPiece, ComputerEnPassantPiece, ComputerPromotedPawn;
+		// The square of the piece whose 'LastPiece' variable is set, or -1 if there is none.
+		int LastPieceSquare;
+
+		// The neural network accumulator. It is a null pointer unless neural evaluation has been switched on.
+		unique_ptr<NeuralAccumulator> Accumulator;
+
+		// The piece code on every square, kept up to date alongside the chessboard.
+		uint8_t PieceCodes[64];
+		// The colours the board is drawn in.
+		int BoardTextColour, BoardBackgroundColour;
+
+		// The attack maps of the current position. They are only rebuilt when asked for after the board has changed.
+		AttackMaps Maps;
+		bool MapsAreCurrent;
+
+		// Function to put a piece (or a null pointer) on a square, keeping the accumulator and piece codes up to date.
+		void SetSquare(int xCoordinate, int yCoordinate, shared_ptr<Piece> NewPiece);
+
+		// Function to rebuild the neural accumulator from every piece on the board.
+		void RefreshNeuralAccumulator();
 
 	// Public member functions.
 	public:
@@ -48,6 +75,10 @@ namespace BoardNamespace
 		char GetBoardSymbol(int xCoordinate, int yCoordinate) const;
 		shared_ptr<Piece> GetPiece(Point InputPoint)          const;
 		shared_ptr<Piece> GetPiece(int InputX, int InputY)    const;
+		const uint8_t* GetPieceCodes()                        const;
+
+		// Function to return the attack maps of the current position, so the evaluation and move ordering can share them.
+		const AttackMaps& GetAttackMaps();
 
 		// More access functions.
 		int GetComputerOriginalX() const;
@@ -58,6 +89,7 @@ namespace BoardNamespace
 		shared_ptr<Piece> GetComputerCapturedPiece()  const;
 		shared_ptr<Piece> GetComputerEnPassantPiece() const;
 		shared_ptr<Piece> GetComputerPromotedPawn()   const;
+		int GetLastPieceSquare() const;
 
 		// Mutator functions.
 		void SetComputerPieces(shared_ptr<Piece> MovedPiece, shared_ptr<Piece> CapturedPiece);
@@ -68,10 +100,18 @@ namespace BoardNamespace
 		// Function to intialise the chessboard.
 		void InitialiseBoard();
 
-		// Function to set the colour of the writing and the background.
+		// Function to set up the chessboard from a FEN position.
+		// The castling rights and en passant square become the turn numbers and 'LastPiece' variables the move rules check.
+		void SetPosition(const FENPosition& Position);
+
+		// Function to fill in the placement, castling rights and en passant square of a FEN position from the chessboard.
+		// The side to move and the move counters are left alone, since the game manager keeps track of them.
+		void GetPosition(FENPosition& Position) const;
+
+		// Function to set the colour of the writing and the background the board is drawn in, numbered as the Windows console numbers them.
 		void SetColourAndBackground(int ForegroundColour, int BackgroundColour);
 
-		// Function to display the chessboard.
+		// Function to display the chessboard. The whole frame is composed in one buffer and written at once.
 		void PrintBoard();
 
 		// Function to move a piece and update the relevant values.
@@ -101,15 +141,29 @@ namespace BoardNamespace
 		// Function to check if the king is in check.
 		bool KingInCheck(string Colour);
 
-		// Function to set the variable 'LastPiece' to false for every piece.
-		void SetBoardLastPieceFalse();
+		// Function to make the piece on a square (or no piece, for -1) the last piece to have moved.
+		// Only the piece on the previous last piece square has its 'LastPiece' variable cleared.
+		void SetLastPieceSquare(int Square);
 
 		// Function to return a quantifiable value of the strength of the chessboard.
+		// This is the cheap part of the evaluation: material and piece positions only.
 		double EvaluateBoard();
 
+		// Function to return the more expensive positional terms of the evaluation, read off the attack maps:
+		// pawn structure, mobility, king attacks and threats. The full evaluation is EvaluateBoard() + EvaluatePositionalTerms().
+		double EvaluatePositionalTerms();
+
 		// Function to add a piece onto the chessboard.
 		void AddPiece(shared_ptr<Piece> ChessPiece);
 
+		// Functions to switch the neural evaluation on and off.
+		void EnableNeuralEvaluation(shared_ptr<const NeuralNetwork> Network);
+		void DisableNeuralEvaluation();
+		bool HasNeuralEvaluation() const;
+
+		// Function to return the neural network evaluation of the chessboard, in the same units as EvaluateBoard.
+		double EvaluateNeural(bool WhiteToMove);
+
 	};
 
 }
@@ -0,0 +1,318 @@
+// OOP Chess Project: BookBuilder.cpp.
+// This is the book builder source file.
+// It contains the definitions of the tool that makes opening books from PGN games.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include "BookBuilder.h"
+#include "OpeningBook.h"
+#include "Pgn.h"
+#include "Zobrist.h"
+
+// Using namespaces.
+using namespace BookBuilderNamespace;
+using namespace BookNamespace;
+using namespace PgnNamespace;
+using namespace ZobristNamespace;
+
+// The number of shards. Each holds the keys that start with the same bits, so the shards are in key order one after another.
+const int ShardBits{ 6 };
+const int NumberOfShards{ 1 << ShardBits };
+
+// A position and a move in it, and the results of the games it was played in, for the side that played it.
+struct BookRecord {
+	uint64_t Key;
+	uint16_t Move, Reserved;
+	uint32_t Wins, Draws, Losses;
+};
+
+// Function to order records by key, then by move.
+static bool RecordBefore(const BookRecord& First, const BookRecord& Second)
+{
+	return First.Key != Second.Key ? First.Key < Second.Key : First.Move < Second.Move;
+}
+
+// The hash of a position and move, for the shard maps. The key is already random, so the move just needs mixing in.
+struct PositionMoveHash {
+	size_t operator()(const pair<uint64_t, uint16_t>& Entry) const { return static_cast<size_t>(Entry.first ^ (static_cast<uint64_t>(Entry.second) * 0x9E3779B97F4A7C15ULL)); }
+};
+
+// A shard: its map of results, and the sorted runs it has written to disk when it got too big.
+struct BookShard {
+	mutex Lock;
+	unordered_map<pair<uint64_t, uint16_t>, BookRecord, PositionMoveHash> Records;
+	vector<string> Runs;
+};
+
+// Everything the builder threads share.
+struct BuildState {
+	BookShard Shards[NumberOfShards];
+	string BookFile;
+	size_t ShardLimit;
+	atomic<bool> Failed;
+};
+
+// Function to return the shard of a key.
+static int ShardOf(uint64_t Key) { return static_cast<int>(Key >> (64 - ShardBits)); }
+
+// Function to write a shard's records to a sorted run file and empty its map. The shard must be locked.
+static void WriteRun(BuildState& State, int Shard)
+{
+	BookShard& TheShard{ State.Shards[Shard] };
+	vector<BookRecord> Sorted;
+	Sorted.reserve(TheShard.Records.size());
+	for (const auto& Record : TheShard.Records) { Sorted.push_back(Record.second); }
+	sort(Sorted.begin(), Sorted.end(), RecordBefore);
+	string RunName{ State.BookFile + ".shard" + to_string(Shard) + ".run" + to_string(TheShard.Runs.size()) };
+	ofstream Run(RunName, ios::binary | ios::trunc);
+	Run.write(reinterpret_cast<const char*>(Sorted.data()), static_cast<streamsize>(Sorted.size() * sizeof(BookRecord)));
+	if (!Run) { cerr << "Error: Unable to write " << RunName << "." << endl; State.Failed = true; }
+	TheShard.Runs.push_back(RunName);
+	TheShard.Records.clear();
+}
+
+// Function to add a thread's records to the shards, locking each shard once.
+static void FlushRecords(BuildState& State, vector<BookRecord>& Records)
+{
+	sort(Records.begin(), Records.end(), [](const BookRecord& First, const BookRecord& Second) { return ShardOf(First.Key) < ShardOf(Second.Key); });
+	for (size_t Begin = 0; Begin < Records.size();)
+	{
+		int Shard{ ShardOf(Records[Begin].Key) };
+		size_t End{ Begin };
+		while (End < Records.size() && ShardOf(Records[End].Key) == Shard) { End++; }
+		BookShard& TheShard{ State.Shards[Shard] };
+		lock_guard<mutex> Guard(TheShard.Lock);
+		for (size_t i = Begin; i < End; i++)
+		{
+			auto Inserted = TheShard.Records.emplace(make_pair(Records[i].Key, Records[i].Move), Records[i]);
+			if (Inserted.second) { continue; }
+			BookRecord& Record{ Inserted.first->second };
+			Record.Wins += Records[i].Wins;
+			Record.Draws += Records[i].Draws;
+			Record.Losses += Records[i].Losses;
+		}
+		if (TheShard.Records.size() >= State.ShardLimit) { WriteRun(State, Shard); }
+		Begin = End;
+	}
+	Records.clear();
+}
+
+// Function to delete the run files that are still on disk, when the book can't be finished.
+static void RemoveRuns(BuildState& State)
+{
+	for (auto& Shard : State.Shards)
+	{
+		for (const auto& Run : Shard.Runs) { remove(Run.c_str()); }
+		Shard.Runs.clear();
+	}
+}
+
+// Function to add the book entries of one shard: the moves of each position that pass the filters, heaviest first.
+static void FinishShard(BuildState& State, int Shard, const BookBuildOptions& Options, vector<uint8_t>& Output)
+{
+
+	// Sort what is left in memory, and map the runs. Each is a sorted list of records.
+	BookShard& TheShard{ State.Shards[Shard] };
+	vector<BookRecord> InMemory;
+	InMemory.reserve(TheShard.Records.size());
+	for (const auto& Record : TheShard.Records) { InMemory.push_back(Record.second); }
+	TheShard.Records.clear();
+	sort(InMemory.begin(), InMemory.end(), RecordBefore);
+	vector<pair<const BookRecord*, const BookRecord*>> Lists{ { InMemory.data(), InMemory.data() + InMemory.size() } };
+	vector<MappedFile> RunFiles(TheShard.Runs.size());
+	for (size_t i = 0; i < RunFiles.size(); i++)
+	{
+		if (!RunFiles[i].Open(TheShard.Runs[i])) { State.Failed = true; return; }
+		const BookRecord* Start{ reinterpret_cast<const BookRecord*>(RunFiles[i].GetData()) };
+		Lists.push_back({ Start, Start + RunFiles[i].GetSize() / sizeof(BookRecord) });
+	}
+
+	// Merge the lists, adding up the records of the same move, and write out each position's moves once all of them are known.
+	vector<BookRecord> Position;
+	auto WritePosition = [&]()
+	{
+		// Keep the moves that pass the filters, weighted as Polyglot does, scaled down if a weight wouldn't fit in 16 bits.
+		vector<pair<uint32_t, uint16_t>> Kept;
+		for (const auto& Record : Position)
+		{
+			uint32_t Games{ Record.Wins + Record.Draws + Record.Losses };
+			if (Games < static_cast<uint32_t>(Options.MinimumGames) || (Record.Wins + 0.5 * Record.Draws) < Options.MinimumScore * Games) { continue; }
+			Kept.push_back({ 2 * Record.Wins + Record.Draws, Record.Move });
+		}
+		uint32_t Heaviest{ 0 };
+		for (const auto& Move : Kept) { Heaviest = max(Heaviest, Move.first); }
+		sort(Kept.begin(), Kept.end(), [](const pair<uint32_t, uint16_t>& First, const pair<uint32_t, uint16_t>& Second) { return First.first > Second.first; });
+		for (const auto& Move : Kept)
+		{
+			uint32_t Weight{ Heaviest > 65535 ? static_cast<uint32_t>(static_cast<uint64_t>(Move.first) * 65535 / Heaviest) : Move.first };
+			uint8_t Entry[BookEntrySize]{};
+			for (int Byte = 0; Byte < 8; Byte++) { Entry[Byte] = static_cast<uint8_t>(Position[0].Key >> (56 - 8 * Byte)); }
+			Entry[8] = static_cast<uint8_t>(Move.second >> 8);
+			Entry[9] = static_cast<uint8_t>(Move.second);
+			Entry[10] = static_cast<uint8_t>(Weight >> 8);
+			Entry[11] = static_cast<uint8_t>(Weight);
+			Output.insert(Output.end(), Entry, Entry + BookEntrySize);
+		}
+		Position.clear();
+	};
+	vector<const BookRecord*> Fronts;
+	for (const auto& List : Lists) { Fronts.push_back(List.first); }
+	while (true)
+	{
+		// Find the smallest record at the front of any list. There are only ever a few lists, so a simple scan is enough.
+		int Smallest{ -1 };
+		for (size_t i = 0; i < Lists.size(); i++)
+		{
+			if (Fronts[i] < Lists[i].second && (Smallest < 0 || RecordBefore(*Fronts[i], *Fronts[Smallest]))) { Smallest = static_cast<int>(i); }
+		}
+		if (Smallest < 0) { break; }
+		const BookRecord& Record{ *Fronts[Smallest]++ };
+		if (!Position.empty() && Position.back().Key != Record.Key) { WritePosition(); }
+		if (!Position.empty() && Position.back().Move == Record.Move)
+		{
+			Position.back().Wins += Record.Wins;
+			Position.back().Draws += Record.Draws;
+			Position.back().Losses += Record.Losses;
+		}
+		else { Position.push_back(Record); }
+	}
+	if (!Position.empty()) { WritePosition(); }
+
+	// The runs aren't needed any more.
+	for (auto& RunFile : RunFiles) { RunFile.Close(); }
+	for (const auto& Run : TheShard.Runs) { remove(Run.c_str()); }
+	TheShard.Runs.clear();
+
+}
+
+// Function to return the default settings.
+BookBuildOptions BookBuilderNamespace::DefaultBookBuildOptions()
+{
+	return { 24, 3, 0.0, max(1, static_cast<int>(thread::hardware_concurrency())), static_cast<size_t>(1) << 24 };
+}
+
+// Function to make a book from PGN files.
+long long BookBuilderNamespace::BuildBook(const string& BookFile, const vector<string>& PgnFiles, const BookBuildOptions& Options)
+{
+
+	// Count the moves of every game, each thread collecting records and adding them to the shards in batches.
+	BuildState State;
+	State.BookFile = BookFile;
+	State.ShardLimit = max(Options.MemoryEntries / NumberOfShards, static_cast<size_t>(1024));
+	State.Failed = false;
+	int Threads{ max(Options.Threads, 1) };
+	vector<vector<BookRecord>> Batches(Threads);
+	for (const auto& PgnFile : PgnFiles)
+	{
+		long long Skipped;
+		long long Read{ ReadPgnFileParallel(PgnFile, Threads, [&](const PgnGame& Game, int Thread)
+		{
+			// Games without a result can't say whether a move was any good.
+			int WhiteScore{ Game.Result == "1-0" ? 2 : Game.Result == "1/2-1/2" ? 1 : Game.Result == "0-1" ? 0 : -1 };
+			if (WhiteScore < 0) { return; }
+			FENPosition Position{ Game.StartingPosition };
+			for (size_t Ply = 0; Ply < Game.Moves.size() && Ply < static_cast<size_t>(Options.MaximumPly); Ply++)
+			{
+				int Score{ Position.WhiteToMove ? WhiteScore : 2 - WhiteScore };
+				Batches[Thread].push_back({ PolyglotKey(Position), ToBookMove(Position, Game.Moves[Ply]), 0, Score == 2 ? 1u : 0u, Score == 1 ? 1u : 0u, Score == 0 ? 1u : 0u });
+				MakePositionMove(Position, Game.Moves[Ply]);
+			}
+			if (Batches[Thread].size() >= (1 << 16)) { FlushRecords(State, Batches[Thread]); }
+		}, Skipped) };
+		if (Read < 0) { State.Failed = true; break; }
+		if (Skipped > 0) { cerr << "Error: " << Skipped << " games in " << PgnFile << " couldn't be read and were left out." << endl; }
+	}
+	if (State.Failed) { RemoveRuns(State); return -1; }
+	for (auto& Batch : Batches) { FlushRecords(State, Batch); }
+	ofstream File(BookFile, ios::binary | ios::trunc);
+	if (!File.is_open()) { cerr << "Error: Unable to open " << BookFile << " for writing." << endl; RemoveRuns(State); return -1; }
+
+	// Finish the shards on several threads. Shards are in key order, so each is written out as soon as it and all the shards before it are done.
+	vector<vector<uint8_t>> Outputs(NumberOfShards);
+	vector<bool> Finished(NumberOfShards, false);
+	int NextToWrite{ 0 };
+	long long Entries{ 0 };
+	mutex WriteLock;
+	atomic<int> NextShard{ 0 };
+	vector<thread> Workers;
+	for (int t = 0; t < Threads; t++)
+	{
+		Workers.emplace_back([&]()
+		{
+			for (int Shard = NextShard++; Shard < NumberOfShards; Shard = NextShard++)
+			{
+				FinishShard(State, Shard, Options, Outputs[Shard]);
+				lock_guard<mutex> Guard(WriteLock);
+				Finished[Shard] = true;
+				for (; NextToWrite < NumberOfShards && Finished[NextToWrite]; NextToWrite++)
+				{
+					vector<uint8_t> Output;
+					Output.swap(Outputs[NextToWrite]);
+					File.write(reinterpret_cast<const char*>(Output.data()), static_cast<streamsize>(Output.size()));
+					Entries += static_cast<long long>(Output.size() / BookEntrySize);
+				}
+			}
+		});
+	}
+	for (auto& Worker : Workers) { Worker.join(); }
+	if (!State.Failed && !File) { cerr << "Error: Unable to write " << BookFile << "." << endl; State.Failed = true; }
+	if (State.Failed)
+	{
+		File.close();
+		remove(BookFile.c_str());
+		RemoveRuns(State);
+		return -1;
+	}
+	return Entries;
+
+}
+
+// Function to run the book builder from the command line.
+int BookBuilderNamespace::RunBookBuilder(int argc, char* argv[])
+{
+
+	// Read the book file, the PGN files and any settings.
+	BookBuildOptions Options{ DefaultBookBuildOptions() };
+	vector<string> PgnFiles;
+	for (int i = 3; i < argc; i++)
+	{
+		string Argument{ argv[i] };
+		if (Argument[0] != '-') { PgnFiles.push_back(Argument); continue; }
+		if (i + 1 >= argc) { cerr << "Error: " << Argument << " needs a value." << endl; return 1; }
+		// Exception handling in case the value isn't a number.
+		try
+		{
+			if (Argument == "-ply") { Options.MaximumPly = stoi(argv[++i]); }
+			else if (Argument == "-games") { Options.MinimumGames = stoi(argv[++i]); }
+			else if (Argument == "-score") { Options.MinimumScore = stod(argv[++i]); }
+			else if (Argument == "-threads") { Options.Threads = stoi(argv[++i]); }
+			else if (Argument == "-memory") { Options.MemoryEntries = static_cast<size_t>(stoull(argv[++i])); }
+			else { cerr << "Error: Unknown setting " << Argument << "." << endl; return 1; }
+		}
+		catch (exception&) { cerr << "Error: " << argv[i] << " is not a valid value for " << Argument << "." << endl; return 1; }
+	}
+	Options.Threads = max(Options.Threads, 1);
+	if (argc < 4 || PgnFiles.empty())
+	{
+		cerr << "Error: Usage is \"makebook <book file> <pgn file>... [-ply N] [-games N] [-score S] [-threads N] [-memory N]\"." << endl;
+		return 1;
+	}
+
+	// Build the book and report how long it took.
+	auto Start = chrono::steady_clock::now();
+	long long Entries{ BuildBook(argv[2], PgnFiles, Options) };
+	if (Entries < 0) { return 1; }
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+	cout << "Wrote " << Entries << " book entries to " << argv[2] << " in " << Seconds << " seconds with " << Options.Threads << " threads." << endl;
+	return 0;
+
+}
\ No newline at end of file
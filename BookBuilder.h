@@ -0,0 +1,51 @@
+// OOP Chess Project: BookBuilder.h.
+// This is the book builder header file.
+// It contains the declarations of the tool that makes Polyglot opening books from collections of PGN games.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_BookBuilder
+#define MY_CLASS_BookBuilder
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace BookBuilderNamespace
+{
+
+	// The settings of a book build.
+	struct BookBuildOptions {
+		// How many half moves into each game are added to the book.
+		int MaximumPly;
+		// The fewest games a move must have been played in, and the lowest score it must have made for the side playing it
+		// (from 0 to 1, counting a draw as half), to be kept.
+		int MinimumGames;
+		double MinimumScore;
+		// The number of threads reading games, and the most moves held in memory before they are written to temporary files.
+		int Threads;
+		size_t MemoryEntries;
+	};
+
+	// Function to return the default settings: 24 half moves, 3 games, any score, every core and 16 million moves in memory.
+	BookBuildOptions DefaultBookBuildOptions();
+
+	// Function to make a book from PGN files. Every move in the first MaximumPly half moves of every finished game is counted
+	// as a win, draw or loss for the side that played it, in hash maps split into shards by key so threads rarely wait for each other.
+	// The moves that pass the filters are written in key order, weighted by twice their wins plus their draws, as Polyglot does.
+	// Returns the number of book entries written, or -1 if something failed.
+	long long BuildBook(const string& BookFile, const vector<string>& PgnFiles, const BookBuildOptions& Options);
+
+	// Function to run "makebook <book file> <pgn file>... [-ply N] [-games N] [-score S] [-threads N] [-memory N]" from the command line.
+	int RunBookBuilder(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+// OOP Chess Project: CpuFeatures.h.
+// This is the CPU features header file.
+// It contains the helpers used to pick between the SIMD and scalar code paths at run time.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_CpuFeatures
+#define MY_CLASS_CpuFeatures
+
+// Only x86 processors can have AVX2, so everything below is switched off on other processors.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CHESS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang need each AVX2 function to be marked so that the rest of the program can still run on older processors.
+// MSVC allows the AVX2 intrinsics to be used anywhere, so nothing is needed there.
+#if defined(CHESS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define AVX2_TARGET
+#endif
+
+// Using a namespace to avoid name collisions.
+namespace CpuNamespace
+{
+
+	// Function to check if the processor (and operating system) supports AVX2.
+	// The result is worked out once and then remembered.
+	inline bool CpuSupportsAVX2()
+	{
+#if defined(CHESS_X86) && (defined(__GNUC__) || defined(__clang__))
+		static const bool Supported{ __builtin_cpu_supports("avx2") != 0 };
+		return Supported;
+#elif defined(CHESS_X86) && defined(_MSC_VER)
+		static const bool Supported = []() {
+			int Info[4];
+			// The operating system must save the AVX registers (OSXSAVE bit and XCR0)...
+			__cpuid(Info, 1);
+			if ((Info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6) { return false; }
+			// ...and the processor must report AVX2 in leaf seven.
+			__cpuidex(Info, 7, 0);
+			return (Info[1] & (1 << 5)) != 0;
+		}();
+		return Supported;
+#else
+		return false;
+#endif
+	}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,238 @@
+// OOP Chess Project: Epd.cpp.
+// This is the EPD source file.
+// It contains all the definitions related to running EPD test suites.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include "Epd.h"
+#include "Json.h"
+
+// Using namespaces.
+using namespace EpdNamespace;
+using namespace JsonNamespace;
+
+// Function to read the operations of an EPD line, which follow the position, into the position of the suite.
+static bool ParseOperations(const char* Cursor, EpdPosition& Position)
+{
+
+	while (*Cursor)
+	{
+		// Split the next operation into its opcode and operands. An operand in quotes may contain spaces and semicolons.
+		vector<string> Operands;
+		string Operand;
+		bool Quoted{ false }, InOperand{ false };
+		for (; *Cursor && (Quoted || *Cursor != ';'); Cursor++)
+		{
+			if (*Cursor == '"') { Quoted = !Quoted; InOperand = true; continue; }
+			if (!Quoted && isspace(static_cast<unsigned char>(*Cursor)))
+			{
+				if (InOperand) { Operands.push_back(Operand); Operand.clear(); InOperand = false; }
+				continue;
+			}
+			Operand += *Cursor;
+			InOperand = true;
+		}
+		if (InOperand) { Operands.push_back(Operand); }
+		if (*Cursor == ';') { Cursor++; }
+		if (Quoted) { return false; }
+		if (Operands.empty()) { continue; }
+
+		// The best and avoid moves are in standard algebraic notation, and must be legal.
+		const string& Opcode{ Operands[0] };
+		if (Opcode == "bm" || Opcode == "am")
+		{
+			vector<PositionMove>& Moves{ Opcode == "bm" ? Position.BestMoves : Position.AvoidMoves };
+			for (size_t i = 1; i < Operands.size(); i++)
+			{
+				PositionMove Move;
+				if (!ParseSAN(Position.Position, Operands[i].c_str(), static_cast<int>(Operands[i].size()), Move)) { return false; }
+				Moves.push_back(Move);
+			}
+		}
+		else if (Opcode == "id" && Operands.size() > 1) { Position.Id = Operands[1]; }
+	}
+	return true;
+
+}
+
+// Function to read a line of an EPD file.
+bool EpdNamespace::ParseEpdLine(const string& Line, EpdPosition& Position)
+{
+	Position = EpdPosition();
+	Position.Line = Line;
+	const char* End{ nullptr };
+	if (!ParseFEN(Line.c_str(), Position.Position, &End)) { return false; }
+	if (!ParseOperations(End, Position)) { return false; }
+	return !Position.BestMoves.empty() || !Position.AvoidMoves.empty();
+}
+
+// Function to read every position of an EPD file.
+bool EpdNamespace::LoadEpdSuite(const string& FileName, vector<EpdPosition>& Suite)
+{
+	ifstream File(FileName);
+	if (!File) { cerr << "Error: Could not open " << FileName << "." << endl; return false; }
+	string Line;
+	int LineNumber{ 0 };
+	while (getline(File, Line))
+	{
+		LineNumber++;
+		if (!Line.empty() && Line.back() == '\r') { Line.pop_back(); }
+		size_t First{ Line.find_first_not_of(" \t") };
+		if (First == string::npos || Line[First] == '#') { continue; }
+		EpdPosition Position;
+		if (!ParseEpdLine(Line, Position)) { cerr << "Error: Line " << LineNumber << " of " << FileName << " could not be read as a position with legal bm or am moves, so it was skipped." << endl; continue; }
+		if (Position.Id.empty()) { Position.Id = to_string(LineNumber); }
+		Suite.push_back(Position);
+	}
+	return true;
+}
+
+// Function to return whether a move solves a position: it must be one of the best moves, if there are any, and none of the moves to avoid.
+// The computer always promotes to a queen, so a best move that promotes to anything else can't be found.
+static bool SolvesPosition(const EpdPosition& Position, const PositionMove& Move)
+{
+	auto Matches = [&](const PositionMove& Other) {
+		int Promotion{ Other.Promotion == NoPieceCode ? NoPieceCode : (Other.Promotion - 1) % 6 + 1 };
+		bool Queen{ Promotion == NoPieceCode || Promotion == WhiteQueenCode };
+		return Other.From == Move.From && Other.To == Move.To && Queen;
+	};
+	for (const PositionMove& Avoid : Position.AvoidMoves) { if (Matches(Avoid)) { return false; } }
+	if (Position.BestMoves.empty()) { return true; }
+	for (const PositionMove& Best : Position.BestMoves) { if (Matches(Best)) { return true; } }
+	return false;
+}
+
+// Function to search one position with a game of its own.
+static EpdResult SolvePosition(GameManager& Game, const EpdPosition& Position, const SearchLimits& Limits)
+{
+
+	// Each finished depth is checked, so the time to solve is when the search found the right move and never changed its mind.
+	EpdResult Result{ {0, 0, NoPieceCode}, false, 0, 0, -1, 0.0, -1.0 };
+	auto ToPositionMove = [](PackedMove Move) {
+		PositionMove Converted{ static_cast<uint8_t>(MoveFrom(Move)), static_cast<uint8_t>(MoveTo(Move)), NoPieceCode };
+		return Converted;
+	};
+	Game.SetPosition(Position.Position);
+	SearchResult Found{ Game.LimitedSearch(Limits, nullptr, [&](const SearchResult& Depth) {
+		if (!SolvesPosition(Position, ToPositionMove(Depth.Move))) { Result.SolvedNodes = -1; Result.SolvedSeconds = -1.0; }
+		else if (Result.SolvedNodes < 0) { Result.SolvedNodes = Depth.Nodes; Result.SolvedSeconds = Depth.Seconds; }
+	}) };
+
+	// A position with no moves can't be solved.
+	Result.Depth = Found.Depth;
+	Result.Nodes = Found.Nodes;
+	Result.Seconds = Found.Seconds;
+	if (Found.Depth == 0) { Result.SolvedNodes = -1; Result.SolvedSeconds = -1.0; return Result; }
+	Result.Move = ToPositionMove(Found.Move);
+	Result.Solved = SolvesPosition(Position, Result.Move);
+	return Result;
+
+}
+
+// Function to search every position of a suite, sharing the positions between threads.
+vector<EpdResult> EpdNamespace::SolveEpdSuite(const vector<EpdPosition>& Suite, const SearchLimits& Limits, int Threads)
+{
+
+	// Each thread takes the next position nobody has taken, until there are none left.
+	vector<EpdResult> Results(Suite.size());
+	atomic<size_t> Next{ 0 };
+	auto Worker = [&]() {
+		Board TheBoard;
+		GameManager Game(&TheBoard);
+		for (size_t i = Next++; i < Suite.size(); i = Next++) { Results[i] = SolvePosition(Game, Suite[i], Limits); }
+	};
+
+	Threads = max(1, min(Threads, static_cast<int>(Suite.size())));
+	vector<thread> Workers;
+	for (int i = 1; i < Threads; i++) { Workers.emplace_back(Worker); }
+	Worker();
+	for (thread& TheThread : Workers) { TheThread.join(); }
+	return Results;
+
+}
+
+// Function to write a list of moves as a JSON array of moves in standard algebraic notation.
+static void WriteJsonMoves(ostream& Output, const FENPosition& Position, const vector<PositionMove>& Moves)
+{
+	char Text[16];
+	Output << '[';
+	for (size_t i = 0; i < Moves.size(); i++)
+	{
+		WriteSAN(Position, Moves[i], Text);
+		if (i > 0) { Output << ','; }
+		WriteJsonString(Output, Text);
+	}
+	Output << ']';
+}
+
+// Function to run "epd <file> [-time S] [-nodes N] [-depth N] [-threads N]" from the command line.
+int EpdNamespace::RunEpd(int argc, char* argv[])
+{
+
+	// Check the arguments.
+	if (argc < 3) { cerr << "Error: Usage is \"epd <file> [-time S] [-nodes N] [-depth N] [-threads N]\"." << endl; return 1; }
+	SearchLimits Limits{ 0, 0, 0.0 };
+	int Threads{ max(1, static_cast<int>(thread::hardware_concurrency())) };
+	for (int i = 3; i < argc; i++)
+	{
+		string Option{ argv[i] };
+		if (i + 1 >= argc) { cerr << "Error: " << Option << " needs a value." << endl; return 1; }
+		if (Option == "-time") { Limits.Seconds = atof(argv[++i]); }
+		else if (Option == "-nodes") { Limits.Nodes = atoll(argv[++i]); }
+		else if (Option == "-depth") { Limits.Depth = atoi(argv[++i]); }
+		else if (Option == "-threads") { Threads = atoi(argv[++i]); }
+		else { cerr << "Error: Did not recognise " << Option << "." << endl; return 1; }
+	}
+	if (Limits.Seconds <= 0 && Limits.Nodes <= 0 && Limits.Depth <= 0) { Limits.Seconds = 1.0; }
+
+	// Read the suite and search every position.
+	vector<EpdPosition> Suite;
+	if (!LoadEpdSuite(argv[2], Suite)) { return 1; }
+	if (Suite.empty()) { cerr << "Error: " << argv[2] << " has no positions with a bm or am move." << endl; return 1; }
+	auto Start = chrono::steady_clock::now();
+	vector<EpdResult> Results{ SolveEpdSuite(Suite, Limits, Threads) };
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+
+	// Print a line for each position.
+	int Solved{ 0 };
+	long long Nodes{ 0 };
+	double SolvedSeconds{ 0.0 };
+	cout << fixed << setprecision(3);
+	for (size_t i = 0; i < Suite.size(); i++)
+	{
+		const EpdResult& Result{ Results[i] };
+		char Text[16] = "";
+		if (Result.Depth > 0) { WriteSAN(Suite[i].Position, Result.Move, Text); }
+		cout << "{\"id\":";
+		WriteJsonString(cout, Suite[i].Id);
+		cout << ",\"solved\":" << (Result.Solved ? "true" : "false") << ",\"move\":";
+		WriteJsonString(cout, Text);
+		cout << ",\"bm\":";
+		WriteJsonMoves(cout, Suite[i].Position, Suite[i].BestMoves);
+		cout << ",\"am\":";
+		WriteJsonMoves(cout, Suite[i].Position, Suite[i].AvoidMoves);
+		cout << ",\"depth\":" << Result.Depth << ",\"nodes\":" << Result.Nodes << ",\"seconds\":" << Result.Seconds;
+		if (Result.Solved) { cout << ",\"solved_nodes\":" << Result.SolvedNodes << ",\"solved_seconds\":" << Result.SolvedSeconds; }
+		else { cout << ",\"solved_nodes\":null,\"solved_seconds\":null"; }
+		cout << "}" << endl;
+		if (Result.Solved) { Solved++; SolvedSeconds += Result.SolvedSeconds; }
+		Nodes += Result.Nodes;
+	}
+
+	// Then the summary.
+	cout << "{\"summary\":{\"positions\":" << Suite.size() << ",\"solved\":" << Solved << ",\"threads\":" << max(1, min(Threads, static_cast<int>(Suite.size())))
+		<< ",\"limit_seconds\":" << Limits.Seconds << ",\"limit_nodes\":" << Limits.Nodes << ",\"limit_depth\":" << Limits.Depth
+		<< ",\"nodes\":" << Nodes << ",\"seconds\":" << Seconds << ",\"mean_solved_seconds\":";
+	if (Solved > 0) { cout << SolvedSeconds / Solved; }
+	else { cout << "null"; }
+	cout << "}}" << endl;
+	return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+// OOP Chess Project: Epd.h.
+// This is the EPD header file.
+// It contains the declarations of the runner for EPD test suites, which measures how many positions the search solves.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Epd
+#define MY_CLASS_Epd
+
+// Include the relevant libraries.
+#include <string>
+#include <vector>
+#include "GameManager.h"
+
+// Using namespaces.
+using namespace GameNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace EpdNamespace
+{
+
+	// A position of a test suite: the position, its name (the "id" operation), the best moves ("bm") and the moves to avoid ("am").
+	// The line it was read from is kept for reporting.
+	struct EpdPosition {
+		FENPosition Position;
+		string Id, Line;
+		vector<PositionMove> BestMoves, AvoidMoves;
+	};
+
+	// The result of searching a position: the move found, whether it solved the position, the depth, nodes and seconds of the whole search,
+	// and the nodes and seconds after which the search had the right move and kept it (both -1 if it never did).
+	struct EpdResult {
+		PositionMove Move;
+		bool Solved;
+		int Depth;
+		long long Nodes, SolvedNodes;
+		double Seconds, SolvedSeconds;
+	};
+
+	// Function to read a line of an EPD file: the first four fields of a FEN string, then operations ending with semicolons
+	// (e.g. "bm Qg6; id \"WAC.001\";"). Operations other than bm, am and id are ignored. Returns false if the line can't be read.
+	bool ParseEpdLine(const string& Line, EpdPosition& Position);
+
+	// Function to read every position of an EPD file, skipping blank lines and lines starting with '#'.
+	// Lines that can't be read are reported and left out. Returns false if the file can't be opened.
+	bool LoadEpdSuite(const string& FileName, vector<EpdPosition>& Suite);
+
+	// Function to search every position of a suite within the limits, sharing the positions between threads.
+	// Each thread has its own board and game, so the searches don't affect one another. The results are in the order of the suite.
+	vector<EpdResult> SolveEpdSuite(const vector<EpdPosition>& Suite, const SearchLimits& Limits, int Threads);
+
+	// Function to run "epd <file> [-time S] [-nodes N] [-depth N] [-threads N]" from the command line. The result of each position,
+	// and then a summary, are printed as lines of JSON so scripts can compare runs. With no limit given, each position gets a second.
+	int RunEpd(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+// OOP Chess Project: EvalParameters.cpp.
+// This is the evaluation parameters source file.
+// It contains the definitions of the tunable numbers used by the evaluation.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include "EvalParameters.h"
+
+// Using namespaces.
+using namespace ParameterNamespace;
+
+// The names of the pieces, used in the parameter file.
+const char* const PieceTypeNames[NumberOfPieceTypes]{ "Pawn", "Knight", "Bishop", "Rook", "Queen", "King" };
+
+// Function to return the hand-set parameters the engine has always used.
+EvaluationParameters ParameterNamespace::DefaultParameters()
+{
+
+	// The piece values and position tables used to live in the piece classes.
+	return { { 10.0, 30.0, 30.0, 50.0, 90.0, 900.0 },
+	{
+	// Pawn.
+	{ {0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0 },
+	{5.0,  5.0,  5.0,  5.0,  5.0,  5.0,  5.0,  5.0},
+	{1.0,  1.0,  2.0,  3.0,  3.0,  2.0,  1.0,  1.0},
+	{0.5,  0.5,  1.0,  2.5,  2.5,  1.0,  0.5,  0.5},
+	{0.0,  0.0,  0.0,  2.0,  2.0,  0.0,  0.0,  0.0},
+	{0.5, -0.5, -1.0,  0.0,  0.0, -1.0, -0.5,  0.5},
+	{0.5,  1.0, 1.0,  -2.0, -2.0,  1.0,  1.0,  0.5},
+	{0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0} },
+	// Knight.
+	{ {-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0},
+	{-4.0, -2.0,  0.0,  0.0,  0.0,  0.0, -2.0, -4.0},
+	{-3.0,  0.0,  1.0,  1.5,  1.5,  1.0,  0.0, -3.0},
+	{-3.0,  0.5,  1.5,  2.0,  2.0,  1.5,  0.5, -3.0},
+	{-3.0,  0.0,  1.5,  2.0,  2.0,  1.5,  0.0, -3.0},
+	{-3.0,  0.5,  1.0,  1.5,  1.5,  1.0,  0.5, -3.0},
+	{-4.0, -2.0,  0.0,  0.5,  0.5,  0.0, -2.0, -4.0},
+	{-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0} },
+	// Bishop.
+	{ {-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0 },
+	{-1.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -1.0},
+	{-1.0,  0.0,  0.5,  1.0,  1.0,  0.5,  0.0, -1.0},
+	{-1.0,  0.5,  0.5,  1.0,  1.0,  0.5,  0.5, -1.0},
+	{-1.0,  0.0,  1.0,  1.0,  1.0,  1.0,  0.0, -1.0},
+	{-1.0,  1.0,  1.0,  1.0,  1.0,  1.0,  1.0, -1.0},
+	{-1.0,  0.5,  0.0,  0.0,  0.0,  0.0,  0.5, -1.0},
+	{-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0} },
+	// Rook.
+	{ {0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0},
+	{0.5,  1.0,  1.0,  1.0,  1.0,  1.0,  1.0,  0.5},
+	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
+	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
+	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
+	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
+	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
+	{0.0,   0.0, 0.0,  0.5,  0.5,  0.0,  0.0,  0.0} },
+	// Queen.
+	{ {-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0},
+	{-1.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -1.0},
+	{-1.0,  0.0,  0.5,  0.5,  0.5,  0.5,  0.0, -1.0},
+	{-0.5,  0.0,  0.5,  0.5,  0.5,  0.5,  0.0, -0.5},
+	{0.0,  0.0,  0.5,  0.5,  0.5,  0.5,  0.0, -0.5},
+	{-1.0,  0.5,  0.5,  0.5,  0.5,  0.5,  0.0, -1.0},
+	{-1.0,  0.0,  0.5,  0.0,  0.0,  0.0,  0.0, -1.0},
+	{-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0} },
+	// King.
+	{ {-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
+	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
+	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
+	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
+	{-2.0, -3.0, -3.0, -4.0, -4.0, -3.0, -3.0, -2.0},
+	{-1.0, -2.0, -2.0, -2.0, -2.0, -2.0, -2.0, -1.0},
+	{2.0,  2.0,  0.0,  0.0,  0.0,  0.0,  2.0,  2.0},
+	{2.0,  3.0,  1.0,  0.0,  0.0,  1.0,  3.0,  2.0} } },
+	// Doubled and isolated pawn penalties, then the passed pawn bonus.
+	1.0, 1.5, { 0.0, 0.5, 1.0, 2.5, 4.5, 7.5 },
+	// Mobility of knights, bishops, rooks and queens.
+	{ 0.4, 0.5, 0.25, 0.1 },
+	// Attacks next to the enemy king by pawns, knights, bishops, rooks and queens.
+	{ 0.2, 0.6, 0.4, 0.6, 0.8 },
+	// Hanging pieces, pawn threats and minor piece threats.
+	1.5, 3.5, 2.5 };
+
+}
+
+// Function to return the parameters the engine is currently using.
+EvaluationParameters& ParameterNamespace::ActiveParameters()
+{
+	// Built from the defaults the first time it is needed.
+	static EvaluationParameters Parameters{ DefaultParameters() };
+	return Parameters;
+}
+
+// Function to write the parameters out as one flat vector.
+vector<double> ParameterNamespace::ParametersToVector(const EvaluationParameters& Parameters)
+{
+
+	vector<double> Values(NumberOfParameters);
+	for (int Type = 0; Type < NumberOfPieceTypes; Type++)
+	{
+		Values[Type] = Parameters.PieceValues[Type];
+		for (int Square = 0; Square < 64; Square++) { Values[PositionTableOffset + 64 * Type + Square] = Parameters.PositionTables[Type][Square / 8][Square % 8]; }
+	}
+	Values[DoubledPawnIndex] = Parameters.DoubledPawnPenalty;
+	Values[IsolatedPawnIndex] = Parameters.IsolatedPawnPenalty;
+	for (int i = 0; i < 6; i++) { Values[PassedPawnOffset + i] = Parameters.PassedPawnBonus[i]; }
+	for (int i = 0; i < 4; i++) { Values[MobilityOffset + i] = Parameters.MobilityBonus[i]; }
+	for (int i = 0; i < 5; i++) { Values[KingAttackOffset + i] = Parameters.KingAttackBonus[i]; }
+	Values[HangingPieceIndex] = Parameters.HangingPieceBonus;
+	Values[PawnThreatIndex] = Parameters.PawnThreatBonus;
+	Values[MinorThreatIndex] = Parameters.MinorThreatBonus;
+	return Values;
+
+}
+
+// Function to read the parameters back from one flat vector.
+void ParameterNamespace::ParametersFromVector(const vector<double>& Values, EvaluationParameters& Parameters)
+{
+
+	// Make sure the vector is the right size.
+	if (Values.size() != static_cast<size_t>(NumberOfParameters)) { cerr << "Error: Wrong number of evaluation parameters." << endl; return; }
+
+	for (int Type = 0; Type < NumberOfPieceTypes; Type++)
+	{
+		Parameters.PieceValues[Type] = Values[Type];
+		for (int Square = 0; Square < 64; Square++) { Parameters.PositionTables[Type][Square / 8][Square % 8] = Values[PositionTableOffset + 64 * Type + Square]; }
+	}
+	Parameters.DoubledPawnPenalty = Values[DoubledPawnIndex];
+	Parameters.IsolatedPawnPenalty = Values[IsolatedPawnIndex];
+	for (int i = 0; i < 6; i++) { Parameters.PassedPawnBonus[i] = Values[PassedPawnOffset + i]; }
+	for (int i = 0; i < 4; i++) { Parameters.MobilityBonus[i] = Values[MobilityOffset + i]; }
+	for (int i = 0; i < 5; i++) { Parameters.KingAttackBonus[i] = Values[KingAttackOffset + i]; }
+	Parameters.HangingPieceBonus = Values[HangingPieceIndex];
+	Parameters.PawnThreatBonus = Values[PawnThreatIndex];
+	Parameters.MinorThreatBonus = Values[MinorThreatIndex];
+
+}
+
+// Function to return the name of a parameter in the flat vector.
+string ParameterNamespace::ParameterName(int Index)
+{
+
+	if (Index < PositionTableOffset) { return string("Value.") + PieceTypeNames[Index]; }
+	if (Index < DoubledPawnIndex)
+	{
+		// Row zero of the table is the eighth rank.
+		int Type{ (Index - PositionTableOffset) / 64 }, Square{ (Index - PositionTableOffset) % 64 };
+		return string("Table.") + PieceTypeNames[Type] + "." + static_cast<char>('a' + Square % 8) + static_cast<char>('8' - Square / 8);
+	}
+	if (Index == DoubledPawnIndex) { return "Pawn.Doubled"; }
+	if (Index == IsolatedPawnIndex) { return "Pawn.Isolated"; }
+	if (Index < MobilityOffset) { return "Pawn.Passed." + to_string(Index - PassedPawnOffset); }
+	// Mobility starts at the knight.
+	if (Index < KingAttackOffset) { return string("Mobility.") + PieceTypeNames[KnightType + Index - MobilityOffset]; }
+	if (Index < HangingPieceIndex) { return string("KingAttack.") + PieceTypeNames[Index - KingAttackOffset]; }
+	if (Index == HangingPieceIndex) { return "Threat.Hanging"; }
+	if (Index == PawnThreatIndex) { return "Threat.Pawn"; }
+	return "Threat.Minor";
+
+}
+
+// Function to return the score of the positional terms.
+double ParameterNamespace::PositionalScore(const TermCounts& Counts, const EvaluationParameters& Parameters)
+{
+
+	// The pawn penalties are subtracted, everything else is added.
+	double Score{ -Parameters.DoubledPawnPenalty * Counts.DoubledPawns - Parameters.IsolatedPawnPenalty * Counts.IsolatedPawns };
+	for (int i = 0; i < 6; i++) { Score += Parameters.PassedPawnBonus[i] * Counts.PassedPawns[i]; }
+	for (int i = 0; i < 4; i++) { Score += Parameters.MobilityBonus[i] * Counts.Mobility[i]; }
+	for (int i = 0; i < 5; i++) { Score += Parameters.KingAttackBonus[i] * Counts.KingAttacks[i]; }
+	Score += Parameters.HangingPieceBonus * Counts.HangingPieces;
+	Score += Parameters.PawnThreatBonus * Counts.PawnThreats;
+	Score += Parameters.MinorThreatBonus * Counts.MinorThreats;
+	return Score;
+
+}
+
+// Function to write the positional terms as (parameter, weight) pairs.
+int ParameterNamespace::PositionalFeatures(const TermCounts& Counts, int Indices[], double Weights[])
+{
+
+	// Each pair is always written, but only kept if its weight isn't zero.
+	// Doing it without a branch is faster, since which counts are zero is as good as random.
+	int Count{ 0 };
+	auto Add = [&](int Index, double Weight) { Indices[Count] = Index; Weights[Count] = Weight; Count += Weight != 0; };
+	Add(DoubledPawnIndex, -Counts.DoubledPawns);
+	Add(IsolatedPawnIndex, -Counts.IsolatedPawns);
+	for (int i = 0; i < 6; i++) { Add(PassedPawnOffset + i, Counts.PassedPawns[i]); }
+	for (int i = 0; i < 4; i++) { Add(MobilityOffset + i, Counts.Mobility[i]); }
+	for (int i = 0; i < 5; i++) { Add(KingAttackOffset + i, Counts.KingAttacks[i]); }
+	Add(HangingPieceIndex, Counts.HangingPieces);
+	Add(PawnThreatIndex, Counts.PawnThreats);
+	Add(MinorThreatIndex, Counts.MinorThreats);
+	return Count;
+
+}
+
+// Function to return a position table as a 2D vector.
+vector<vector<double>> ParameterNamespace::PositionTableVector(int Type)
+{
+	const auto& Table = ActiveParameters().PositionTables[Type];
+	vector<vector<double>> TableVector(8);
+	for (int i = 0; i < 8; i++) { TableVector[i].assign(Table[i], Table[i] + 8); }
+	return TableVector;
+}
+
+// Function to load parameters from a text file.
+bool ParameterNamespace::LoadParameters(const string& FileName, EvaluationParameters& Parameters)
+{
+
+	// Open the file.
+	ifstream File(FileName);
+	if (!File.is_open()) { cerr << "Error: Unable to open parameter file " << FileName << "." << endl; return false; }
+
+	// Look up the parameters by name.
+	map<string, int> Indices;
+	for (int i = 0; i < NumberOfParameters; i++) { Indices[ParameterName(i)] = i; }
+	vector<double> Values{ ParametersToVector(Parameters) };
+
+	// Exception handling.
+	// This is very useful if the file has been corrupted.
+	try {
+		string Line;
+		int LineNumber{ 0 };
+		while (getline(File, Line))
+		{
+			LineNumber++;
+			// Skip blank lines and comments.
+			if (Line.empty() || Line[0] == '#' || Line[0] == '\r') { continue; }
+			istringstream Stream(Line);
+			string Name;
+			double Value;
+			if (!(Stream >> Name >> Value)) { throw LineNumber; }
+			auto Found = Indices.find(Name);
+			if (Found == Indices.end()) { throw LineNumber; }
+			Values[Found->second] = Value;
+		}
+	}
+	catch (int LineNumber) {
+		cerr << "Error: Line " << LineNumber << " of " << FileName << " is not a known parameter." << endl;
+		return false;
+	}
+
+	// Only change the parameters once the whole file has been read.
+	ParametersFromVector(Values, Parameters);
+	return true;
+
+}
+
+// Function to save parameters to a text file.
+bool ParameterNamespace::SaveParameters(const string& FileName, const EvaluationParameters& Parameters)
+{
+
+	// Create the file.
+	ofstream File(FileName);
+	if (!File.is_open()) { cerr << "Error: Unable to open " << FileName << " for saving." << endl; return false; }
+
+	// Write one parameter per line.
+	vector<double> Values{ ParametersToVector(Parameters) };
+	File << "# Evaluation parameters, in tenths of a pawn from white's point of view." << endl;
+	for (int i = 0; i < NumberOfParameters; i++) { File << ParameterName(i) << " " << setprecision(6) << Values[i] << endl; }
+	return static_cast<bool>(File);
+
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+// OOP Chess Project: EvalParameters.h.
+// This is the evaluation parameters header file.
+// It contains the declarations of the tunable numbers used by the evaluation: piece values, position tables and pawn terms.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_EvalParameters
+#define MY_CLASS_EvalParameters
+
+// Include the relevant libraries.
+#include <string>
+#include <vector>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace ParameterNamespace
+{
+
+	// The kinds of piece, in the same order as the piece codes.
+	enum PieceType { PawnType, KnightType, BishopType, RookType, QueenType, KingType, NumberOfPieceTypes };
+
+	// Every number the evaluation uses, all from white's point of view.
+	// The position tables are laid out like the chessboard: row zero is black's back rank.
+	struct EvaluationParameters {
+		double PieceValues[NumberOfPieceTypes];
+		double PositionTables[NumberOfPieceTypes][8][8];
+		double DoubledPawnPenalty;
+		double IsolatedPawnPenalty;
+		// Indexed by how many ranks the passed pawn has advanced from its starting rank.
+		double PassedPawnBonus[6];
+		// Per safe square a knight, bishop, rook or queen can move to.
+		double MobilityBonus[4];
+		// Per square next to the enemy king attacked by a pawn, knight, bishop, rook or queen.
+		double KingAttackBonus[5];
+		// Per enemy piece that is attacked and not defended, attacked by a pawn, or a rook or queen attacked by a minor piece.
+		double HangingPieceBonus;
+		double PawnThreatBonus;
+		double MinorThreatBonus;
+	};
+
+	// The counts behind the positional terms, each one white's count minus black's.
+	// They are worked out from the attack maps, and are what the parameters above multiply.
+	struct TermCounts {
+		double DoubledPawns;
+		double IsolatedPawns;
+		double PassedPawns[6];
+		double Mobility[4];
+		double KingAttacks[5];
+		double HangingPieces;
+		double PawnThreats;
+		double MinorThreats;
+	};
+
+	// The position of each parameter when they are all written out as one flat vector.
+	const int PositionTableOffset{ NumberOfPieceTypes };
+	const int DoubledPawnIndex{ PositionTableOffset + 64 * NumberOfPieceTypes };
+	const int IsolatedPawnIndex{ DoubledPawnIndex + 1 };
+	const int PassedPawnOffset{ IsolatedPawnIndex + 1 };
+	const int MobilityOffset{ PassedPawnOffset + 6 };
+	const int KingAttackOffset{ MobilityOffset + 4 };
+	const int HangingPieceIndex{ KingAttackOffset + 5 };
+	const int PawnThreatIndex{ HangingPieceIndex + 1 };
+	const int MinorThreatIndex{ PawnThreatIndex + 1 };
+	const int NumberOfParameters{ MinorThreatIndex + 1 };
+	// The largest number of (parameter, weight) pairs PositionalFeatures can write.
+	const int MaximumPositionalFeatures{ 2 + 6 + 4 + 5 + 3 };
+
+	// Function to return the hand-set parameters the engine has always used.
+	EvaluationParameters DefaultParameters();
+
+	// Function to return the parameters the engine is currently using.
+	EvaluationParameters& ActiveParameters();
+
+	// Functions to convert the parameters to and from one flat vector (used by the tuner).
+	vector<double> ParametersToVector(const EvaluationParameters& Parameters);
+	void ParametersFromVector(const vector<double>& Values, EvaluationParameters& Parameters);
+
+	// Function to return the name of a parameter in the flat vector, e.g. "Value.Knight" or "Table.Pawn.e4".
+	string ParameterName(int Index);
+
+	// Function to return the score of the positional terms.
+	double PositionalScore(const TermCounts& Counts, const EvaluationParameters& Parameters);
+
+	// Function to write the positional terms as (parameter, weight) pairs, skipping those with a weight of zero.
+	// The tuner uses this so that it scores the terms exactly as PositionalScore does. Returns the number of pairs written.
+	int PositionalFeatures(const TermCounts& Counts, int Indices[], double Weights[]);
+
+	// Function to return a position table as the 2D vector the pieces hand to the board.
+	vector<vector<double>> PositionTableVector(int Type);
+
+	// Function to load parameters from a text file of "name value" lines. Names that are missing keep their current values.
+	bool LoadParameters(const string& FileName, EvaluationParameters& Parameters);
+
+	// Function to save parameters to a text file of "name value" lines.
+	bool SaveParameters(const string& FileName, const EvaluationParameters& Parameters);
+
+}
+
+#endif
\ No newline at end of file
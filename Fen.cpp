@@ -0,0 +1,213 @@
+// OOP Chess Project: Fen.cpp.
+// This is the FEN source file.
+// It contains the definitions of the reader and writer of FEN strings.
+// James Cummins.
+
+// Include the relevant header files.
+#include "Fen.h"
+#include "Pieces.h"
+
+// Using namespaces.
+using namespace FenNamespace;
+using namespace PieceNamespace;
+
+// The FEN string of the starting position.
+const char FenNamespace::StartingFEN[]{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1" };
+
+// Function to check if a field of a FEN string ends at this character.
+// A semicolon also ends a field, since that is how EPD opcodes are separated.
+static bool FieldEnds(char Symbol) { return Symbol == '\0' || Symbol == ' ' || Symbol == '\t' || Symbol == '\r' || Symbol == '\n' || Symbol == ';'; }
+
+// Function to skip the spaces between fields.
+static const char* SkipSpaces(const char* Text)
+{
+	while (*Text == ' ' || *Text == '\t') { Text++; }
+	return Text;
+}
+
+// Function to read a field that is a whole number. Returns false (and reads nothing) if the field isn't one.
+// Numbers are capped well below the integer limit, so a corrupt counter can't overflow.
+static bool ReadNumber(const char*& Text, int& Number)
+{
+	const char* Cursor{ Text };
+	int Value{ 0 };
+	while (*Cursor >= '0' && *Cursor <= '9')
+	{
+		if (Value < 100000000) { Value = 10 * Value + (*Cursor - '0'); }
+		Cursor++;
+	}
+	if (Cursor == Text || !FieldEnds(*Cursor)) { return false; }
+	Number = Value;
+	Text = Cursor;
+	return true;
+}
+
+// Function to write a whole number, returning the position after it.
+static char* WriteNumber(char* Buffer, int Number)
+{
+	char Digits[12];
+	int Count{ 0 };
+	if (Number < 0) { Number = 0; }
+	do { Digits[Count++] = static_cast<char>('0' + Number % 10); Number /= 10; } while (Number > 0);
+	while (Count > 0) { *Buffer++ = Digits[--Count]; }
+	return Buffer;
+}
+
+// Function to read a FEN string into a position.
+// Function to return what is wrong with the placement of a position, or nullptr if the board can play from it.
+static const char* PlacementProblem(const FENPosition& Position)
+{
+	int WhiteKings{ 0 }, BlackKings{ 0 };
+	for (int Square = 0; Square < 64; Square++)
+	{
+		int Code{ Position.Codes[Square] };
+		WhiteKings += Code == WhiteKingCode;
+		BlackKings += Code == BlackKingCode;
+		if ((Code == WhitePawnCode || Code == BlackPawnCode) && (Square < 8 || Square >= 56)) { return "a pawn is on the first or last rank"; }
+	}
+	if (WhiteKings != 1) { return "white must have exactly one king"; }
+	if (BlackKings != 1) { return "black must have exactly one king"; }
+	return nullptr;
+}
+
+// Function to read a FEN string into a position, without checking the placement.
+static bool ReadFEN(const char* Text, FENPosition& Position, const char** End)
+{
+
+	// The placement starts with the eighth rank, which is row zero of the chessboard.
+	const char* Cursor{ SkipSpaces(Text) };
+	int Row{ 0 }, Column{ 0 };
+	for (int Square = 0; Square < 64; Square++) { Position.Codes[Square] = NoPieceCode; }
+	if (End) { *End = Cursor; }
+	for (; !FieldEnds(*Cursor); Cursor++)
+	{
+		char Symbol{ *Cursor };
+		if (Symbol == '/') { if (Column != 8 || Row == 7) { return false; } Row++; Column = 0; continue; }
+		if (Symbol >= '1' && Symbol <= '8') { Column += Symbol - '0'; }
+		else
+		{
+			int Code{ SymbolToPieceCode(Symbol) };
+			if (Code == NoPieceCode || Column > 7) { return false; }
+			Position.Codes[8 * Row + Column++] = static_cast<uint8_t>(Code);
+		}
+		if (Column > 8) { return false; }
+	}
+	if (Row != 7 || Column != 8) { return false; }
+
+	// Fill in the fields that may be missing.
+	Position.WhiteToMove = true;
+	Position.Castling = 0;
+	Position.EnPassantSquare = -1;
+	Position.HalfmoveClock = 0;
+	Position.FullmoveNumber = 1;
+	Cursor = SkipSpaces(Cursor);
+
+	// The side to move. Anything other than 'w' or 'b' is taken as the end of the FEN string.
+	if ((*Cursor == 'w' || *Cursor == 'b') && FieldEnds(Cursor[1]))
+	{
+		Position.WhiteToMove = *Cursor == 'w';
+		Cursor = SkipSpaces(Cursor + 1);
+
+		// The castling rights, either "-" or some of "KQkq".
+		if (*Cursor == '-' && FieldEnds(Cursor[1])) { Cursor = SkipSpaces(Cursor + 1); }
+		else if (*Cursor == 'K' || *Cursor == 'Q' || *Cursor == 'k' || *Cursor == 'q')
+		{
+			for (; !FieldEnds(*Cursor); Cursor++)
+			{
+				switch (*Cursor) {
+				case 'K': Position.Castling |= WhiteKingside;  break;
+				case 'Q': Position.Castling |= WhiteQueenside; break;
+				case 'k': Position.Castling |= BlackKingside;  break;
+				case 'q': Position.Castling |= BlackQueenside; break;
+				default:  return false;
+				}
+			}
+			Cursor = SkipSpaces(Cursor);
+		}
+
+		// The en passant square, either "-" or a square on the third or sixth rank.
+		if (*Cursor == '-' && FieldEnds(Cursor[1])) { Cursor = SkipSpaces(Cursor + 1); }
+		else if (*Cursor >= 'a' && *Cursor <= 'h' && Cursor[1] >= '1' && Cursor[1] <= '8' && FieldEnds(Cursor[2]))
+		{
+			if (Cursor[1] != '3' && Cursor[1] != '6') { return false; }
+			Position.EnPassantSquare = 8 * ('8' - Cursor[1]) + (Cursor[0] - 'a');
+			Cursor = SkipSpaces(Cursor + 2);
+		}
+
+		// The two move counters.
+		if (ReadNumber(Cursor, Position.HalfmoveClock))
+		{
+			Cursor = SkipSpaces(Cursor);
+			if (ReadNumber(Cursor, Position.FullmoveNumber)) { Cursor = SkipSpaces(Cursor); }
+			if (Position.FullmoveNumber < 1) { Position.FullmoveNumber = 1; }
+		}
+	}
+
+	// Tell the caller where reading stopped, so that anything after the FEN string can be read.
+	if (End) { *End = Cursor; }
+	return true;
+
+}
+
+// Function to read a FEN string into a position.
+bool FenNamespace::ParseFEN(const char* Text, FENPosition& Position, const char** End)
+{
+	return ReadFEN(Text, Position, End) && !PlacementProblem(Position);
+}
+
+// Function to return what is wrong with a FEN string.
+const char* FenNamespace::FENProblem(const char* Text)
+{
+	FENPosition Position;
+	if (!ReadFEN(Text, Position, nullptr)) { return "it is malformed"; }
+	return PlacementProblem(Position);
+}
+
+// Function to write a position as a FEN string.
+int FenNamespace::WriteFEN(const FENPosition& Position, char Buffer[])
+{
+
+	// The placement, one rank at a time from the eighth, with runs of empty squares written as a digit.
+	char* Cursor{ Buffer };
+	for (int Row = 0; Row < 8; Row++)
+	{
+		int Empty{ 0 };
+		for (int Column = 0; Column < 8; Column++)
+		{
+			int Code{ Position.Codes[8 * Row + Column] };
+			if (Code <= NoPieceCode || Code >= NumberOfPieceCodes) { Empty++; continue; }
+			if (Empty > 0) { *Cursor++ = static_cast<char>('0' + Empty); Empty = 0; }
+			*Cursor++ = PieceCodeToSymbol(Code);
+		}
+		if (Empty > 0) { *Cursor++ = static_cast<char>('0' + Empty); }
+		if (Row < 7) { *Cursor++ = '/'; }
+	}
+
+	// The side to move and the castling rights.
+	*Cursor++ = ' ';
+	*Cursor++ = Position.WhiteToMove ? 'w' : 'b';
+	*Cursor++ = ' ';
+	if (Position.Castling & WhiteKingside)  { *Cursor++ = 'K'; }
+	if (Position.Castling & WhiteQueenside) { *Cursor++ = 'Q'; }
+	if (Position.Castling & BlackKingside)  { *Cursor++ = 'k'; }
+	if (Position.Castling & BlackQueenside) { *Cursor++ = 'q'; }
+	if (!(Position.Castling & 15)) { *Cursor++ = '-'; }
+
+	// The en passant square.
+	*Cursor++ = ' ';
+	if (Position.EnPassantSquare >= 0 && Position.EnPassantSquare < 64)
+	{
+		*Cursor++ = static_cast<char>('a' + Position.EnPassantSquare % 8);
+		*Cursor++ = static_cast<char>('8' - Position.EnPassantSquare / 8);
+	}
+	else { *Cursor++ = '-'; }
+
+	// The move counters.
+	*Cursor++ = ' ';
+	Cursor = WriteNumber(Cursor, Position.HalfmoveClock);
+	*Cursor++ = ' ';
+	Cursor = WriteNumber(Cursor, Position.FullmoveNumber);
+	*Cursor = '\0';
+	return static_cast<int>(Cursor - Buffer);
+
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+// OOP Chess Project: Fen.h.
+// This is the FEN header file.
+// It contains the declarations of the reader and writer of FEN strings, the standard one-line description of a position.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Fen
+#define MY_CLASS_Fen
+
+// Include the relevant libraries.
+#include <cstdint>
+
+// Using a namespace to avoid name collisions.
+namespace FenNamespace
+{
+
+	// The castling rights, as bits of FENPosition::Castling.
+	enum CastlingRight { WhiteKingside = 1, WhiteQueenside = 2, BlackKingside = 4, BlackQueenside = 8 };
+
+	// The longest FEN string the writer can produce, including the terminating null.
+	const int MaximumFENLength{ 128 };
+
+	// The FEN string of the starting position.
+	extern const char StartingFEN[];
+
+	// Everything a FEN string describes.
+	struct FENPosition {
+		// The piece code on every square, with square 8 * x + y standing for row x and column y of the chessboard.
+		uint8_t Codes[64];
+		bool WhiteToMove;
+		// The CastlingRight bits that are still available.
+		uint8_t Castling;
+		// The square a pawn can be captured en passant on, or -1 if there isn't one.
+		int EnPassantSquare;
+		// The half moves since the last capture or pawn move, and the number of the current full move.
+		int HalfmoveClock, FullmoveNumber;
+	};
+
+	// Function to read a FEN string into a position. Nothing is allocated, so it is cheap enough to call in bulk.
+	// Only the placement is required: a missing side to move is white, missing castling and en passant fields are "-",
+	// and missing counters are 0 and 1, so EPD lines and bare placements can be read too.
+	// Returns false if any field that is present is malformed, or if the placement isn't one the board can play from: each side
+	// needs exactly one king, and no pawn may stand on the first or last rank. If End is given, it is set to where reading stopped.
+	bool ParseFEN(const char* Text, FENPosition& Position, const char** End = nullptr);
+
+	// Function to return what is wrong with a FEN string, for error messages, or nullptr if ParseFEN can read it.
+	const char* FENProblem(const char* Text);
+
+	// Function to write a position as a FEN string into a buffer of at least MaximumFENLength characters.
+	// Returns the length of the string, not counting the terminating null.
+	int WriteFEN(const FENPosition& Position, char Buffer[]);
+
+}
+
+#endif
\ No newline at end of file
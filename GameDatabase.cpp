@@ -0,0 +1,502 @@
+// OOP Chess Project: GameDatabase.cpp.
+// This is the GameDatabase class source file.
+// It contains all the definitions related to the game database.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include "GameDatabase.h"
+#include "Zobrist.h"
+
+// Using namespaces.
+using namespace DatabaseNamespace;
+using namespace ZobristNamespace;
+
+// The first four bytes of the games and index files.
+static const char GamesFileMagic[4]{ 'C', 'H', 'D', 'B' };
+static const char IndexFileMagic[4]{ 'C', 'H', 'D', 'X' };
+
+// The number of buckets, and where the entries start in the index file.
+const uint64_t NumberOfBuckets{ 1ULL << IndexBucketBits };
+const size_t EntriesOffset{ sizeof(IndexFileHeader) + (NumberOfBuckets + 1) * sizeof(uint64_t) };
+
+// Function to return the bucket of a key.
+static uint64_t BucketOf(uint64_t Key) { return Key >> (64 - IndexBucketBits); }
+
+// Function to order index entries by key, then by where their game starts.
+static bool EntryBefore(const IndexEntry& First, const IndexEntry& Second)
+{
+	return First.Key != Second.Key ? First.Key < Second.Key : First.GameOffset < Second.GameOffset;
+}
+
+// Functions to convert between a result and how it is stored.
+static uint8_t StoreResult(const string& Result)
+{
+	if (Result == "1-0") { return WhiteWon; }
+	if (Result == "0-1") { return BlackWon; }
+	if (Result == "1/2-1/2") { return Drawn; }
+	return Unfinished;
+}
+static string ResultString(uint8_t Result)
+{
+	const char* Results[4]{ "*", "1-0", "0-1", "1/2-1/2" };
+	return Results[Result & 3];
+}
+
+// Function to unpack a stored game: the starting position, then the moves, each of which needs the position it was made in.
+static void UnpackGame(const uint8_t* Data, PgnGame& Game)
+{
+	GameRecord Record;
+	memcpy(&Record, Data, sizeof(Record));
+	Game.Tags.clear();
+	Game.Result = ResultString(Record.Result);
+	UnpackSavedPosition(Record.StartingPosition, Game.StartingPosition);
+	Game.Moves.resize(Record.NumberOfMoves);
+	FENPosition Position{ Game.StartingPosition };
+	for (size_t i = 0; i < Game.Moves.size(); i++)
+	{
+		uint16_t Packed;
+		memcpy(&Packed, Data + sizeof(Record) + i * sizeof(uint16_t), sizeof(Packed));
+		Game.Moves[i] = UnpackPositionMove(Packed, Position);
+		MakePositionMove(Position, Game.Moves[i]);
+	}
+}
+
+// Default constructor.
+GameDatabase::GameDatabase()
+{
+	Buckets = nullptr;
+	Entries = nullptr;
+	NumberOfEntries = NumberOfGames = GamesEnd = 0;
+}
+
+// Function to open a database.
+bool GameDatabase::Open(const string& Name)
+{
+
+	// The index is opened first, so every game it refers to is already in the games file when that is opened.
+	Close();
+	if (!Index.Open(Name + ".gdx", false) || !Games.Open(Name + ".gdb", false)) { Close(); return false; }
+
+	// Check the index.
+	IndexFileHeader IndexHeader;
+	if (Index.GetSize() < EntriesOffset) { cerr << "Error: " << Name << ".gdx is too short to be a database index." << endl; Close(); return false; }
+	memcpy(&IndexHeader, Index.GetData(), sizeof(IndexHeader));
+	if (memcmp(IndexHeader.Magic, IndexFileMagic, sizeof(IndexFileMagic)) != 0 || IndexHeader.Version != DatabaseVersion || IndexHeader.HeaderSize != sizeof(IndexFileHeader)
+		|| Index.GetSize() < EntriesOffset + IndexHeader.NumberOfEntries * sizeof(IndexEntry))
+	{
+		cerr << "Error: " << Name << ".gdx is not an index of version " << DatabaseVersion << " of the database format." << endl;
+		Close();
+		return false;
+	}
+
+	// Check the games.
+	GamesFileHeader GamesHeader;
+	if (Games.GetSize() < sizeof(GamesHeader)) { cerr << "Error: " << Name << ".gdb is too short to be a database." << endl; Close(); return false; }
+	memcpy(&GamesHeader, Games.GetData(), sizeof(GamesHeader));
+	if (memcmp(GamesHeader.Magic, GamesFileMagic, sizeof(GamesFileMagic)) != 0 || GamesHeader.Version != DatabaseVersion || GamesHeader.HeaderSize != sizeof(GamesFileHeader)
+		|| Games.GetSize() < sizeof(GamesHeader) + GamesHeader.DataSize)
+	{
+		cerr << "Error: " << Name << ".gdb is not a database of version " << DatabaseVersion << " of the format." << endl;
+		Close();
+		return false;
+	}
+
+	// The index is read in place.
+	Buckets = reinterpret_cast<const uint64_t*>(Index.GetData() + sizeof(IndexFileHeader));
+	Entries = reinterpret_cast<const IndexEntry*>(Index.GetData() + EntriesOffset);
+	NumberOfEntries = IndexHeader.NumberOfEntries;
+	NumberOfGames = GamesHeader.NumberOfGames;
+	GamesEnd = sizeof(GamesHeader) + GamesHeader.DataSize;
+	return true;
+
+}
+
+// Function to close the database.
+void GameDatabase::Close()
+{
+	Index.Close();
+	Games.Close();
+	Buckets = nullptr;
+	Entries = nullptr;
+	NumberOfEntries = NumberOfGames = GamesEnd = 0;
+}
+
+// Access functions.
+uint64_t GameDatabase::GetNumberOfGames()     const { return NumberOfGames; }
+uint64_t GameDatabase::GetNumberOfPositions() const { return NumberOfEntries; }
+
+// Function to return the range of index entries with a key.
+pair<const IndexEntry*, const IndexEntry*> GameDatabase::FindEntries(uint64_t Key) const
+{
+
+	// Only the key's bucket needs searching, which is a few pages at most even in a very large index.
+	if (!Entries) { return { nullptr, nullptr }; }
+	uint64_t Bucket{ BucketOf(Key) };
+	const IndexEntry* First{ Entries + Buckets[Bucket] };
+	const IndexEntry* Last{ Entries + Buckets[Bucket + 1] };
+	First = lower_bound(First, Last, Key, [](const IndexEntry& Entry, uint64_t Value) { return Entry.Key < Value; });
+	Last = upper_bound(First, Last, Key, [](uint64_t Value, const IndexEntry& Entry) { return Value < Entry.Key; });
+	return { First, Last };
+
+}
+
+// Function to return the number of games that reached a position.
+size_t GameDatabase::CountGames(uint64_t Key) const
+{
+	auto Range = FindEntries(Key);
+	return static_cast<size_t>(Range.second - Range.first);
+}
+
+// Function to find the games that reached a position.
+void GameDatabase::FindGames(uint64_t Key, vector<uint64_t>& GameOffsets, size_t MaximumGames) const
+{
+	GameOffsets.clear();
+	auto Range = FindEntries(Key);
+	for (const IndexEntry* Entry = Range.first; Entry < Range.second && GameOffsets.size() < MaximumGames; Entry++) { GameOffsets.push_back(Entry->GameOffset); }
+}
+
+// Function to read a game.
+bool GameDatabase::ReadGame(uint64_t GameOffset, PgnGame& Game) const
+{
+
+	// Check the whole game is inside the games file.
+	if (GameOffset < sizeof(GamesFileHeader) || GameOffset + sizeof(GameRecord) > GamesEnd) { return false; }
+	GameRecord Record;
+	memcpy(&Record, Games.GetData() + GameOffset, sizeof(Record));
+	if (GameOffset + sizeof(Record) + Record.NumberOfMoves * sizeof(uint16_t) > GamesEnd) { return false; }
+	UnpackGame(Games.GetData() + GameOffset, Game);
+	return true;
+
+}
+
+// Everything the import threads share: the games file, the index entries waiting to be sorted, and the sorted runs written so far.
+struct ImportState {
+	mutex Lock;
+	fstream File;
+	uint64_t End, NumberOfGames;
+	vector<IndexEntry> Entries;
+	vector<string> Runs;
+	string Name;
+	size_t MemoryEntries;
+	bool Failed;
+};
+
+// The games and index entries one thread has packed but not yet added to the database.
+struct ImportBuffer {
+	vector<uint8_t> Bytes;
+	vector<IndexEntry> Entries;
+	uint64_t NumberOfGames;
+};
+
+// Function to sort the index entries in memory and write them to a temporary file.
+static void WriteRun(ImportState& State)
+{
+	sort(State.Entries.begin(), State.Entries.end(), EntryBefore);
+	string RunName{ State.Name + ".run" + to_string(State.Runs.size()) };
+	ofstream Run(RunName, ios::binary | ios::trunc);
+	Run.write(reinterpret_cast<const char*>(State.Entries.data()), static_cast<streamsize>(State.Entries.size() * sizeof(IndexEntry)));
+	if (!Run) { cerr << "Error: Unable to write " << RunName << "." << endl; State.Failed = true; }
+	State.Runs.push_back(RunName);
+	State.Entries.clear();
+}
+
+// Function to add the games a thread has packed to the games file. The entries' offsets are made relative to the file.
+static void FlushBuffer(ImportState& State, ImportBuffer& Buffer)
+{
+	lock_guard<mutex> Guard(State.Lock);
+	State.File.write(reinterpret_cast<const char*>(Buffer.Bytes.data()), static_cast<streamsize>(Buffer.Bytes.size()));
+	for (auto& Entry : Buffer.Entries) { Entry.GameOffset += State.End; }
+	State.Entries.insert(State.Entries.end(), Buffer.Entries.begin(), Buffer.Entries.end());
+	State.End += Buffer.Bytes.size();
+	State.NumberOfGames += Buffer.NumberOfGames;
+	if (State.Entries.size() >= State.MemoryEntries) { WriteRun(State); }
+	Buffer.Bytes.clear();
+	Buffer.Entries.clear();
+	Buffer.NumberOfGames = 0;
+}
+
+// Function to pack a game into a thread's buffer, with an index entry for each different position in it.
+static void PackGame(const PgnGame& Game, ImportBuffer& Buffer)
+{
+
+	// Games too long for the record are cut short; no real game comes close.
+	size_t NumberOfMoves{ min(Game.Moves.size(), static_cast<size_t>(UINT16_MAX)) };
+	uint64_t Offset{ Buffer.Bytes.size() };
+	GameRecord Record;
+	PackSavedPosition(Game.StartingPosition, Record.StartingPosition);
+	Record.NumberOfMoves = static_cast<uint16_t>(NumberOfMoves);
+	Record.Result = StoreResult(Game.Result);
+	Record.Reserved = 0;
+	Buffer.Bytes.resize(Offset + sizeof(Record) + NumberOfMoves * sizeof(uint16_t));
+	memcpy(Buffer.Bytes.data() + Offset, &Record, sizeof(Record));
+
+	// Pack the moves, and work out the key of every position reached, including the first.
+	FENPosition Position{ Game.StartingPosition };
+	size_t FirstEntry{ Buffer.Entries.size() };
+	Buffer.Entries.push_back({ PositionKey(Position), Offset });
+	for (size_t i = 0; i < NumberOfMoves; i++)
+	{
+		uint16_t Packed{ PackPositionMove(Game.Moves[i]) };
+		memcpy(Buffer.Bytes.data() + Offset + sizeof(Record) + i * sizeof(uint16_t), &Packed, sizeof(Packed));
+		MakePositionMove(Position, Game.Moves[i]);
+		Buffer.Entries.push_back({ PositionKey(Position), Offset });
+	}
+
+	// A position repeated in a game is only indexed once.
+	auto First = Buffer.Entries.begin() + static_cast<ptrdiff_t>(FirstEntry);
+	sort(First, Buffer.Entries.end(), EntryBefore);
+	Buffer.Entries.erase(unique(First, Buffer.Entries.end(), [](const IndexEntry& A, const IndexEntry& B) { return A.Key == B.Key; }), Buffer.Entries.end());
+	Buffer.NumberOfGames++;
+
+}
+
+// Function to merge sorted lists of index entries into a new index file.
+static bool WriteIndex(const string& FileName, const vector<pair<const IndexEntry*, const IndexEntry*>>& Lists, uint64_t NumberOfGames)
+{
+
+	// Leave room for the header and buckets, which are only known at the end.
+	ofstream File(FileName, ios::binary | ios::trunc);
+	if (!File.is_open()) { cerr << "Error: Unable to open " << FileName << " for writing." << endl; return false; }
+	vector<uint64_t> Buckets(NumberOfBuckets + 1, 0);
+	vector<char> Space(EntriesOffset, 0);
+	File.write(Space.data(), static_cast<streamsize>(Space.size()));
+
+	// Repeatedly take the smallest entry at the front of any list, writing them out in blocks.
+	vector<const IndexEntry*> Positions;
+	for (const auto& List : Lists) { Positions.push_back(List.first); }
+	auto LaterFront = [&](size_t First, size_t Second) { return EntryBefore(*Positions[Second], *Positions[First]); };
+	priority_queue<size_t, vector<size_t>, decltype(LaterFront)> Queue(LaterFront);
+	for (size_t i = 0; i < Lists.size(); i++) { if (Positions[i] < Lists[i].second) { Queue.push(i); } }
+	vector<IndexEntry> Block;
+	Block.reserve(1 << 16);
+	uint64_t Written{ 0 };
+	while (!Queue.empty())
+	{
+		size_t List{ Queue.top() };
+		Queue.pop();
+		Block.push_back(*Positions[List]);
+		Buckets[BucketOf(Positions[List]->Key) + 1]++;
+		if (++Positions[List] < Lists[List].second) { Queue.push(List); }
+		if (Block.size() == Block.capacity() || Queue.empty())
+		{
+			File.write(reinterpret_cast<const char*>(Block.data()), static_cast<streamsize>(Block.size() * sizeof(IndexEntry)));
+			Written += Block.size();
+			Block.clear();
+		}
+	}
+
+	// The bucket counts become where each bucket starts. Then the header and buckets are written over the space left for them.
+	for (uint64_t Bucket = 1; Bucket <= NumberOfBuckets; Bucket++) { Buckets[Bucket] += Buckets[Bucket - 1]; }
+	IndexFileHeader Header;
+	memcpy(Header.Magic, IndexFileMagic, sizeof(IndexFileMagic));
+	Header.Version = DatabaseVersion;
+	Header.HeaderSize = sizeof(IndexFileHeader);
+	Header.NumberOfEntries = Written;
+	Header.NumberOfGames = NumberOfGames;
+	File.seekp(0);
+	File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+	File.write(reinterpret_cast<const char*>(Buckets.data()), static_cast<streamsize>(Buckets.size() * sizeof(uint64_t)));
+	if (!File) { cerr << "Error: Unable to write " << FileName << "." << endl; return false; }
+	return true;
+
+}
+
+// Function to add the games in PGN files to a database.
+long long DatabaseNamespace::ImportPgnFiles(const string& Name, const vector<string>& PgnFiles, int Threads, size_t MemoryEntries)
+{
+
+	// Open the games file, creating it with an empty header if it doesn't exist.
+	ImportState State;
+	State.Name = Name;
+	State.MemoryEntries = max(MemoryEntries, static_cast<size_t>(1024));
+	State.Failed = false;
+	string GamesName{ Name + ".gdb" };
+	GamesFileHeader Header;
+	if (!ifstream(GamesName).good())
+	{
+		memcpy(Header.Magic, GamesFileMagic, sizeof(GamesFileMagic));
+		Header.Version = DatabaseVersion;
+		Header.HeaderSize = sizeof(GamesFileHeader);
+		Header.NumberOfGames = Header.DataSize = 0;
+		ofstream NewFile(GamesName, ios::binary);
+		NewFile.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+		if (!NewFile) { cerr << "Error: Unable to create " << GamesName << "." << endl; return -1; }
+	}
+	State.File.open(GamesName, ios::binary | ios::in | ios::out);
+	if (!State.File.is_open()) { cerr << "Error: Unable to open " << GamesName << "." << endl; return -1; }
+	State.File.read(reinterpret_cast<char*>(&Header), sizeof(Header));
+	if (!State.File || memcmp(Header.Magic, GamesFileMagic, sizeof(GamesFileMagic)) != 0 || Header.Version != DatabaseVersion || Header.HeaderSize != sizeof(GamesFileHeader))
+	{
+		cerr << "Error: " << GamesName << " is not a database of version " << DatabaseVersion << " of the format." << endl;
+		return -1;
+	}
+
+	// New games go straight after the last complete one, over anything an interrupted import left behind.
+	uint64_t OldEnd{ sizeof(Header) + Header.DataSize }, OldNumberOfGames{ Header.NumberOfGames };
+	State.End = OldEnd;
+	State.NumberOfGames = Header.NumberOfGames;
+	State.File.seekp(static_cast<streamoff>(State.End));
+
+	// Read the PGN files with several threads, each packing games into its own buffer and adding them to the file a block at a time.
+	vector<ImportBuffer> Buffers(max(Threads, 1));
+	for (auto& Buffer : Buffers) { Buffer.NumberOfGames = 0; }
+	for (const auto& PgnFile : PgnFiles)
+	{
+		long long Skipped;
+		long long Read{ ReadPgnFileParallel(PgnFile, static_cast<int>(Buffers.size()), [&](const PgnGame& Game, int Thread)
+		{
+			PackGame(Game, Buffers[Thread]);
+			if (Buffers[Thread].Bytes.size() >= (1 << 20)) { FlushBuffer(State, Buffers[Thread]); }
+		}, Skipped) };
+		if (Read < 0) { State.Failed = true; break; }
+		if (Skipped > 0) { cerr << "Error: " << Skipped << " games in " << PgnFile << " couldn't be read and were left out." << endl; }
+	}
+	for (auto& Buffer : Buffers) { if (Buffer.NumberOfGames > 0) { FlushBuffer(State, Buffer); } }
+
+	// Only once the games are all written does the header say they are there.
+	State.File.flush();
+	if (!State.File) { cerr << "Error: Unable to write " << GamesName << "." << endl; State.Failed = true; }
+	if (State.Failed)
+	{
+		for (const auto& Run : State.Runs) { remove(Run.c_str()); }
+		return -1;
+	}
+	long long Added{ static_cast<long long>(State.NumberOfGames - Header.NumberOfGames) };
+	Header.NumberOfGames = State.NumberOfGames;
+	Header.DataSize = State.End - sizeof(Header);
+	State.File.seekp(0);
+	State.File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+	State.File.close();
+
+	// Merge the old index, the runs written to disk and the entries still in memory into a new index.
+	// The old index covers the first of the old games, which is all of them unless an import was interrupted after its games
+	// were written but before its index was. Any old games it doesn't cover are indexed again from the games file.
+	// An index that claims more games than the games file holds isn't an index of these games, so it is rebuilt.
+	vector<pair<const IndexEntry*, const IndexEntry*>> Lists;
+	MappedFile OldIndex;
+	IndexFileHeader OldHeader;
+	bool HaveOldIndex{ OldEnd > sizeof(Header) && ifstream(Name + ".gdx").good() && OldIndex.Open(Name + ".gdx") && OldIndex.GetSize() >= EntriesOffset };
+	if (HaveOldIndex)
+	{
+		memcpy(&OldHeader, OldIndex.GetData(), sizeof(OldHeader));
+		HaveOldIndex = memcmp(OldHeader.Magic, IndexFileMagic, sizeof(IndexFileMagic)) == 0 && OldHeader.Version == DatabaseVersion
+			&& OldIndex.GetSize() >= EntriesOffset + OldHeader.NumberOfEntries * sizeof(IndexEntry) && OldHeader.NumberOfGames <= OldNumberOfGames;
+	}
+	uint64_t IndexedGames{ HaveOldIndex ? OldHeader.NumberOfGames : 0 };
+	if (HaveOldIndex)
+	{
+		const IndexEntry* Start{ reinterpret_cast<const IndexEntry*>(OldIndex.GetData() + EntriesOffset) };
+		Lists.push_back({ Start, Start + OldHeader.NumberOfEntries });
+	}
+	if (IndexedGames < OldNumberOfGames)
+	{
+		MappedFile OldGames;
+		if (!OldGames.Open(GamesName)) { return -1; }
+		PgnGame Game;
+		uint64_t Offset{ sizeof(Header) };
+		for (uint64_t GameNumber = 0; GameNumber < OldNumberOfGames && Offset + sizeof(GameRecord) <= OldEnd; GameNumber++)
+		{
+			// Step over the games the old index already has.
+			GameRecord Record;
+			memcpy(&Record, OldGames.GetData() + Offset, sizeof(Record));
+			uint64_t Size{ sizeof(Record) + Record.NumberOfMoves * sizeof(uint16_t) };
+			if (GameNumber < IndexedGames) { Offset += Size; continue; }
+			ImportBuffer Buffer;
+			Buffer.NumberOfGames = 0;
+			UnpackGame(OldGames.GetData() + Offset, Game);
+			PackGame(Game, Buffer);
+			for (auto& Entry : Buffer.Entries) { Entry.GameOffset += Offset; }
+			State.Entries.insert(State.Entries.end(), Buffer.Entries.begin(), Buffer.Entries.end());
+			Offset += Size;
+		}
+		if (IndexedGames > 0) { cout << "The index of " << Name << " was missing " << OldNumberOfGames - IndexedGames << " games, which have been added to it." << endl; }
+	}
+	sort(State.Entries.begin(), State.Entries.end(), EntryBefore);
+	Lists.push_back({ State.Entries.data(), State.Entries.data() + State.Entries.size() });
+	vector<MappedFile> RunFiles(State.Runs.size());
+	for (size_t i = 0; i < State.Runs.size(); i++)
+	{
+		if (!RunFiles[i].Open(State.Runs[i])) { return -1; }
+		const IndexEntry* Start{ reinterpret_cast<const IndexEntry*>(RunFiles[i].GetData()) };
+		Lists.push_back({ Start, Start + RunFiles[i].GetSize() / sizeof(IndexEntry) });
+	}
+
+	// The new index is written beside the old one and then takes its place, so readers always see a complete index.
+	string IndexName{ Name + ".gdx" }, NewIndexName{ Name + ".gdx.new" };
+	bool Written{ WriteIndex(NewIndexName, Lists, Header.NumberOfGames) };
+	OldIndex.Close();
+	for (auto& RunFile : RunFiles) { RunFile.Close(); }
+	for (const auto& Run : State.Runs) { remove(Run.c_str()); }
+	if (!Written) { remove(NewIndexName.c_str()); return -1; }
+	if (rename(NewIndexName.c_str(), IndexName.c_str()) != 0)
+	{
+		// Some systems won't rename over an existing file.
+		remove(IndexName.c_str());
+		if (rename(NewIndexName.c_str(), IndexName.c_str()) != 0) { cerr << "Error: Unable to replace " << IndexName << "." << endl; return -1; }
+	}
+	return Added;
+
+}
+
+// Function to run the game database from the command line.
+int DatabaseNamespace::RunDatabase(int argc, char* argv[])
+{
+
+	// Check the arguments.
+	string Command{ argc > 2 ? argv[2] : "" };
+	if (argc < 5 || (Command != "import" && Command != "find"))
+	{
+		cerr << "Error: Usage is \"db import <database> <pgn file>...\" or \"db find <database> <FEN> [games]\"." << endl;
+		return 1;
+	}
+	string Name{ argv[3] };
+
+	// Add games from PGN files.
+	if (Command == "import")
+	{
+		auto Start = chrono::steady_clock::now();
+		long long Added{ ImportPgnFiles(Name, vector<string>(argv + 4, argv + argc), max(1, static_cast<int>(thread::hardware_concurrency()))) };
+		if (Added < 0) { return 1; }
+		double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+		GameDatabase Database;
+		if (!Database.Open(Name)) { return 1; }
+		cout << "Added " << Added << " games in " << Seconds << " seconds. " << Name << " now holds " << Database.GetNumberOfGames() << " games and "
+			<< Database.GetNumberOfPositions() << " indexed positions." << endl;
+		return 0;
+	}
+
+	// Find the games that reached a position.
+	FENPosition Position;
+	if (!ParseFEN(argv[4], Position)) { cerr << "Error: \"" << argv[4] << "\" is not a valid FEN string: " << FENProblem(argv[4]) << "." << endl; return 1; }
+	GameDatabase Database;
+	if (!Database.Open(Name)) { return 1; }
+	size_t MaximumGames{ argc > 5 ? static_cast<size_t>(atoi(argv[5])) : 10 };
+	uint64_t Key{ PositionKey(Position) };
+	vector<uint64_t> GameOffsets;
+	auto Start = chrono::steady_clock::now();
+	size_t Count{ Database.CountGames(Key) };
+	Database.FindGames(Key, GameOffsets, MaximumGames);
+	double Microseconds{ chrono::duration<double, micro>(chrono::steady_clock::now() - Start).count() };
+	cout << Count << " of " << Database.GetNumberOfGames() << " games reached the position (found in " << Microseconds << " microseconds)." << endl;
+
+	// Print the games found, up to the move that reached the position.
+	PgnGame Game;
+	for (uint64_t GameOffset : GameOffsets)
+	{
+		if (!Database.ReadGame(GameOffset, Game)) { continue; }
+		FENPosition Replay{ Game.StartingPosition };
+		size_t Ply{ 0 };
+		while (PositionKey(Replay) != Key && Ply < Game.Moves.size()) { MakePositionMove(Replay, Game.Moves[Ply++]); }
+		cout << "Game at " << GameOffset << ": " << Game.Result << " after " << Game.Moves.size() << " moves, reached the position after move " << Ply << "." << endl;
+	}
+	return 0;
+
+}
\ No newline at end of file
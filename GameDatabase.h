@@ -0,0 +1,128 @@
+// OOP Chess Project: GameDatabase.h.
+// This is the GameDatabase class header file.
+// It contains the declarations of an on-disk database of games, indexed by the positions reached in them.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_GameDatabase
+#define MY_CLASS_GameDatabase
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "SaveFile.h"
+#include "Pgn.h"
+
+// Using namespaces.
+using namespace FileNamespace;
+using namespace SaveNamespace;
+using namespace PgnNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace DatabaseNamespace
+{
+
+	// A database is two files: the games (name.gdb), which are only ever added to, and the index (name.gdx), which lists the key
+	// of every position in every game in order, with where its game starts. The index is rebuilt whenever games are added.
+
+	// The version of the format written by this program. Files of any other version are refused.
+	const uint16_t DatabaseVersion{ 1 };
+
+	// The number of bits of a key used to split the index into buckets, so a look-up only searches a small part of it.
+	const int IndexBucketBits{ 16 };
+
+	// How a game ended, as it is stored.
+	enum StoredResult : uint8_t { Unfinished, WhiteWon, BlackWon, Drawn };
+
+	// The start of the games file. Only the first DataSize bytes after the header are games, so a file an import
+	// was interrupted in the middle of still reads correctly.
+	struct GamesFileHeader {
+		char Magic[4];
+		uint16_t Version, HeaderSize;
+		uint64_t NumberOfGames, DataSize;
+	};
+	static_assert(sizeof(GamesFileHeader) == 24, "GamesFileHeader must be 24 bytes so that databases are portable.");
+
+	// A stored game: its starting position and result, followed by NumberOfMoves 16-bit moves.
+	struct GameRecord {
+		SavedPosition StartingPosition;
+		uint16_t NumberOfMoves;
+		uint8_t Result, Reserved;
+	};
+	static_assert(sizeof(GameRecord) == 48, "GameRecord must be 48 bytes so that databases are portable.");
+
+	// The start of the index file. It is followed by the first entry of each bucket (plus one past the end), then the entries.
+	struct IndexFileHeader {
+		char Magic[4];
+		uint16_t Version, HeaderSize;
+		uint64_t NumberOfEntries, NumberOfGames;
+	};
+	static_assert(sizeof(IndexFileHeader) == 24, "IndexFileHeader must be 24 bytes so that databases are portable.");
+
+	// An entry in the index: the key of a position and where a game that reached it starts in the games file.
+	struct IndexEntry { uint64_t Key, GameOffset; };
+
+	// GameDatabase class.
+	// The files are memory-mapped and only read, so any number of threads can search one database object at once,
+	// and any number of programs can have the database open while another adds games to it.
+	class GameDatabase {
+
+	// Private member data.
+	private:
+
+		// The mapped files.
+		MappedFile Games, Index;
+		// The buckets and entries of the index, and the end of the games that were there when the database was opened.
+		const uint64_t* Buckets;
+		const IndexEntry* Entries;
+		uint64_t NumberOfEntries, NumberOfGames, GamesEnd;
+
+		// Function to return the range of index entries with a key.
+		pair<const IndexEntry*, const IndexEntry*> FindEntries(uint64_t Key) const;
+
+	// Public member functions.
+	public:
+
+		// Default constructor.
+		GameDatabase();
+		// Destructor.
+		~GameDatabase() {}
+
+		// Function to open a database. Returns false if either file is missing or isn't a database.
+		bool Open(const string& Name);
+
+		// Function to close the database.
+		void Close();
+
+		// Access functions.
+		uint64_t GetNumberOfGames()     const;
+		uint64_t GetNumberOfPositions() const;
+
+		// Function to return the number of games that reached a position.
+		size_t CountGames(uint64_t Key) const;
+
+		// Function to find the games that reached a position, in the order they were added, up to a maximum number.
+		// The games are given by where they start in the games file, which is what ReadGame needs.
+		void FindGames(uint64_t Key, vector<uint64_t>& GameOffsets, size_t MaximumGames = 100) const;
+
+		// Function to read a game. Returns false if there is no game at that offset.
+		bool ReadGame(uint64_t GameOffset, PgnGame& Game) const;
+
+	};
+
+	// Function to add the games in PGN files to a database, creating it if it doesn't exist, then rebuild the index.
+	// The files are read with several threads. At most MemoryEntries index entries are held in memory: beyond that they
+	// are sorted and written to temporary files, which are merged with the old index at the end.
+	// Only one program should add to a database at a time. Returns the number of games added, or -1 if something failed.
+	long long ImportPgnFiles(const string& Name, const vector<string>& PgnFiles, int Threads, size_t MemoryEntries = 1 << 24);
+
+	// Function to run "db import <database> <pgn file>..." or "db find <database> <FEN> [games]" from the command line.
+	int RunDatabase(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -9,6 +9,32 @@
 // Using namespaces.
 using namespace GameNamespace;
 
+// The file games are saved to, and the text file older versions saved them to.
+const string SavedGameFile{ "SavedGame.sav" };
+const string TextSavedGameFile{ "SavedGame.txt" };
+
+// Function to pack a move with its flags.
+PackedMove GameNamespace::PackMove(const uint8_t Codes[64], int From, int To)
+{
+	int Code{ Codes[From] }, Flags{ 0 };
+	bool Pawn{ Code == WhitePawnCode || Code == BlackPawnCode }, King{ Code == WhiteKingCode || Code == BlackKingCode };
+	// A pawn moving diagonally onto an empty square is taking en passant.
+	bool EnPassant{ Pawn && From % 8 != To % 8 && Codes[To] == NoPieceCode };
+	if (Codes[To] != NoPieceCode || EnPassant) { Flags |= CaptureFlag; }
+	if (EnPassant || (King && abs(To % 8 - From % 8) == 2) || (Pawn && (To / 8 == 0 || To / 8 == 7))) { Flags |= SpecialMoveFlag; }
+	return PackMove(From, To, Flags);
+}
+
+// Non member function to convert a time into the local date and time. Windows and POSIX each have their own thread-safe version.
+static void LocalTime(const time_t& RawTime, struct tm& TimeInfo)
+{
+#if defined(_WIN32)
+	localtime_s(&TimeInfo, &RawTime);
+#else
+	localtime_r(&RawTime, &TimeInfo);
+#endif
+}
+
 // Non member function to return the equivalent integer of a char.
 // The value 97 appears because the char 'a' has an ASCII code of 97.
 int ReturnNumber(char Input) { return (int)Input - 97; }
@@ -16,55 +42,44 @@ int ReturnNumber(char Input) { return (int)Input - 97; }
 // Non member function to return the equivalent char of an integer.
 char ReturnChar(int Input) { return (char)(Input + 97); }
 
-// Non member function to return the file of a position on the chessboard.
-int FileInput()
+// Non member function to read the file of a position on the chessboard from a line, as an integer.
+// If the input fails, or it's out of bounds, an error message is printed and false returned. Whatever else was on the line is ignored.
+bool FileInput(const string& Line, int& File)
 {
 
 	// Declare the input.
-	char InputFile;
+	char InputFile{ 0 };
 
-	// While the input fails, or it's out of bounds, loop over this.
-	while (!(cin >> InputFile) || ReturnNumber(tolower(InputFile)) < 0 || ReturnNumber(tolower(InputFile)) > 7)
+	// If the input fails, or it's out of bounds, print an error message.
+	if (!(istringstream(Line) >> InputFile) || ReturnNumber(tolower(InputFile)) < 0 || ReturnNumber(tolower(InputFile)) > 7)
 	{
-		// Print an error message.
 		cerr << "Error: Input failed.\nPlease try again: ";
-		// Clear the error state.
-		cin.clear();
-		// Ignore whatever the user entered.
-		cin.ignore((numeric_limits<streamsize>::max)(), '\n');
+		return false;
 	}
 
-	// Clear the  input buffer.
-	cin.ignore((numeric_limits<streamsize>::max)(), '\n');
-
 	// Return the good input as an integer.
-	return ReturnNumber(tolower(InputFile));
+	File = ReturnNumber(tolower(InputFile));
+	return true;
 
 }
 
-// Non member function to return the rank of a position on the chessboard.
-int GoodNumber()
+// Non member function to read the rank of a position on the chessboard from a line.
+bool GoodNumber(const string& Line, int& Rank)
 {
 
 	// Declare the input number.
-	int InputNumber;
+	int InputNumber{ 0 };
 
-	// While the input fails, or it's out of bounds, enter this loop.
-	while (!(cin >> InputNumber) || InputNumber < 1 || InputNumber > 8)
+	// If the input fails, or it's out of bounds, print an error message.
+	if (!(istringstream(Line) >> InputNumber) || InputNumber < 1 || InputNumber > 8)
 	{
-		// Print an error message.
 		cerr << "Error: Input failed.\nPlease try again: ";
-		// Clear the error state.
-		cin.clear();
-		// Ignore whatever the user entered.
-		cin.ignore((numeric_limits<streamsize>::max)(), '\n');
+		return false;
 	}
 
-	// Clear the input buffer.
-	cin.ignore((numeric_limits<streamsize>::max)(), '\n');
-
 	// Return the good input.
-	return InputNumber;
+	Rank = InputNumber;
+	return true;
 
 }
 
@@ -73,6 +88,16 @@ GameManager::GameManager()
 {
 	TheBoard->InitialiseBoard();
 	GameTurnNumber = CaptureCounter = PawnMoveCounter = GameType = 0;
+	HumanMoveField = 0;
+	MaximiseBoardEvaluation = true;
+	Evaluator = ClassicEvaluation;
+	LazyEvaluationMargin = 10.0;
+	MoveOrdering = true;
+	LazyEvaluationCalls = LazyEvaluationExits = 0;
+	NodeCount = NodeLimit = 0;
+	HasSearchDeadline = SearchStopped = false;
+	StopSignal = nullptr;
+	ParseFEN(StartingFEN, StartingPosition);
 }
 
 // Parameterised constructor.
@@ -80,12 +105,144 @@ GameManager::GameManager(Board *InputBoard)
 {
 	TheBoard = InputBoard;
 	GameTurnNumber = CaptureCounter = PawnMoveCounter = GameType = 0;
+	HumanMoveField = 0;
+	MaximiseBoardEvaluation = true;
+	Evaluator = ClassicEvaluation;
+	LazyEvaluationMargin = 10.0;
+	MoveOrdering = true;
+	LazyEvaluationCalls = LazyEvaluationExits = 0;
+	NodeCount = NodeLimit = 0;
+	HasSearchDeadline = SearchStopped = false;
+	StopSignal = nullptr;
+	ParseFEN(StartingFEN, StartingPosition);
 }
 
 // Access functions
 int  GameManager::GetGameTurnNumber() const { return GameTurnNumber; }
 bool GameManager::GetMaxBoardEval()   const { return MaximiseBoardEvaluation; }
 
+// Mutator function for the side the search is maximising.
+void GameManager::SetMaxBoardEval(bool TrueOrFalse) { MaximiseBoardEvaluation = TrueOrFalse; }
+
+// Function to start the game from the position in a FEN string.
+bool GameManager::SetPositionFromFEN(const string& FEN)
+{
+	FENPosition Position;
+	if (!ParseFEN(FEN.c_str(), Position))
+	{
+		cerr << "Error: Could not read the FEN string \"" << FEN << "\": " << FENProblem(FEN.c_str()) << "." << endl;
+		return false;
+	}
+	SetPosition(Position);
+	return true;
+}
+
+// Function to start the game from a position.
+// The position becomes the starting position, so the game so far is forgotten.
+void GameManager::SetPosition(const FENPosition& Position)
+{
+	StartingPosition = Position;
+	SavedGame.clear();
+	ResetToStartingPosition();
+}
+
+// Function to put the board and counters back to the starting position.
+void GameManager::ResetToStartingPosition()
+{
+
+	// Set up the board.
+	TheBoard->SetPosition(StartingPosition);
+	// The turn number is even when it is white's turn, and counts half moves from the first move of the game.
+	GameTurnNumber = 2 * (StartingPosition.FullmoveNumber - 1) + (StartingPosition.WhiteToMove ? 0 : 1);
+	// Both counters start from the half move clock, so the fifty move rule carries on from where the position left off.
+	CaptureCounter = PawnMoveCounter = StartingPosition.HalfmoveClock;
+	// No moves have been made yet.
+	MoveLog.clear();
+	UndoStack.clear();
+
+}
+
+// Function to add a move to the log, before it is made.
+int GameManager::LogMove(int OldX, int OldY, int NewX, int NewY)
+{
+	int Code{ TheBoard->GetPieceCodes()[8 * OldX + OldY] };
+	MoveLog.push_back({ PackBoardMove(OldX, OldY, NewX, NewY), static_cast<uint8_t>(Code) });
+	return Code;
+}
+
+// Function to return the current position.
+void GameManager::GetPosition(FENPosition& Position) const
+{
+	TheBoard->GetPosition(Position);
+	Position.WhiteToMove = GameTurnNumber % 2 == 0;
+	// The half move clock counts from the last capture or pawn move, whichever was more recent.
+	Position.HalfmoveClock = min(CaptureCounter, PawnMoveCounter);
+	Position.FullmoveNumber = GameTurnNumber / 2 + 1;
+}
+
+// Function to return the current position as a FEN string.
+string GameManager::GetFEN() const
+{
+	FENPosition Position;
+	char Buffer[MaximumFENLength];
+	GetPosition(Position);
+	return string(Buffer, WriteFEN(Position, Buffer));
+}
+
+// Function to take a snapshot of the game.
+GameState GameManager::GetState() const
+{
+	GameState State;
+	GetPosition(State.Position);
+	State.GameTurnNumber = GameTurnNumber;
+	State.CaptureCounter = CaptureCounter;
+	State.PawnMoveCounter = PawnMoveCounter;
+	State.MaximiseBoardEvaluation = MaximiseBoardEvaluation;
+	State.Evaluator = Evaluator;
+	State.LazyEvaluationMargin = LazyEvaluationMargin;
+	State.MoveOrdering = MoveOrdering;
+	return State;
+}
+
+// Function to set the game up from a snapshot.
+void GameManager::SetState(const GameState& State)
+{
+	SetPosition(State.Position);
+	// The two counters are kept apart, as the position only has the smaller of them.
+	GameTurnNumber = State.GameTurnNumber;
+	CaptureCounter = State.CaptureCounter;
+	PawnMoveCounter = State.PawnMoveCounter;
+	MaximiseBoardEvaluation = State.MaximiseBoardEvaluation;
+	LazyEvaluationMargin = State.LazyEvaluationMargin;
+	MoveOrdering = State.MoveOrdering;
+	if (State.Evaluator != Evaluator && (State.Evaluator == ClassicEvaluation || Network)) { SetEvaluator(State.Evaluator); }
+}
+
+// Function to make this game a copy of another on its own board.
+void GameManager::CloneFrom(const GameManager& Source)
+{
+
+	// Copy the record of the game, which is all plain values.
+	StartingPosition = Source.StartingPosition;
+	MoveLog = Source.MoveLog;
+	SavedGame = Source.SavedGame;
+	GameType = Source.GameType;
+	UndoStack.clear();
+
+	// Set up the board with new pieces in the source's position, then copy the counters and settings.
+	GameState State{ Source.GetState() };
+	TheBoard->SetPosition(State.Position);
+	GameTurnNumber = State.GameTurnNumber;
+	CaptureCounter = State.CaptureCounter;
+	PawnMoveCounter = State.PawnMoveCounter;
+	MaximiseBoardEvaluation = State.MaximiseBoardEvaluation;
+	LazyEvaluationMargin = State.LazyEvaluationMargin;
+	MoveOrdering = State.MoveOrdering;
+	Network = Source.Network;
+	SetEvaluator(State.Evaluator);
+
+}
+
 // Function to inform the user that a pawn has been promoted.
 void GameManager::PrintPawnPromotion()
 {
@@ -106,12 +263,35 @@ void GameManager::PrintPawnPromotion()
 
 }
 
-// Function to print the list of moves and save them to a file.
-void GameManager::PrintList()
+// Function to write a move from the log into a buffer, in one of the notations, numbered with the full move it was made in.
+// The position is the one the move was made in, which algebraic notation needs.
+static void WriteLoggedMove(const LoggedMove& Move, MoveNotation Notation, const FENPosition& Position, int MoveNumber, char Buffer[], size_t Size)
 {
+	const char* PieceNames[6]{ "Pawn", "Knight", "Bishop", "Rook", "Queen", "King" };
+	int From{ MoveFrom(Move.Move) }, To{ MoveTo(Move.Move) };
+	int FromX{ From / 8 }, FromY{ From % 8 }, ToX{ To / 8 }, ToY{ To % 8 };
+	if (Notation == AlgebraicNotation)
+	{
+		char SAN[16];
+		WriteSAN(Position, { static_cast<uint8_t>(From), static_cast<uint8_t>(To), NoPieceCode }, SAN);
+		snprintf(Buffer, Size, "%d) %s", MoveNumber, SAN);
+	}
+	else if (Notation == CoordinateNotation)
+	{
+		// A pawn reaching the far row is always promoted to a queen.
+		bool Promotion{ (Move.Piece == WhitePawnCode && ToX == 0) || (Move.Piece == BlackPawnCode && ToX == 7) };
+		snprintf(Buffer, Size, "%d) %c%d%c%d%s", MoveNumber, ReturnChar(FromY), 8 - FromX, ReturnChar(ToY), 8 - ToX, Promotion ? "q" : "");
+	}
+	else
+	{
+		snprintf(Buffer, Size, "%d) %s %s was moved from (%c, %d) to (%c, %d).", MoveNumber, Move.Piece <= WhiteKingCode ? "White" : "Black", PieceNames[(Move.Piece - 1) % 6],
+			ReturnChar(FromY), 8 - FromX, ReturnChar(ToY), 8 - ToX);
+	}
+}
 
-	// Print the list of moves from the multimap.
-	for (const auto& it : ListOfMoves) { cout << it.first << ") " << it.second << endl; }
+// Function to print the list of moves and save them to a file.
+void GameManager::PrintList(MoveNotation Notation)
+{
 
 	// Creat the file to save the game to.
 	ofstream myFile("ChessGame.txt");
@@ -123,15 +303,26 @@ void GameManager::PrintList()
 		time_t rawtime;
 		struct tm timeinfo;
 		time(&rawtime);
-		localtime_s(&timeinfo, &rawtime);
+		LocalTime(rawtime, timeinfo);
 		
 		// Print the title, date, and time to the file.
 		myFile << "Chess Game by James Cummins." << endl;
 		myFile << "Date: " << timeinfo.tm_mday << "/" << (timeinfo.tm_mon + 1) << "/" << (timeinfo.tm_year + 1900) << endl;
 		myFile << "Time: " << timeinfo.tm_hour << ":" << timeinfo.tm_min << ":" << timeinfo.tm_sec << "\n" << endl;
 		
-		// Print the lise of moves to the file.
-		for (const auto& it : ListOfMoves) { myFile << it.first << ") " << it.second << endl; }
+		// Print the list of moves to the screen and the file, writing each one into the same buffer in turn.
+		// The position is followed along from the start of the game, since algebraic notation depends on it.
+		FENPosition Position{ StartingPosition };
+		int TurnNumber{ 2 * (StartingPosition.FullmoveNumber - 1) + (StartingPosition.WhiteToMove ? 0 : 1) };
+		char Buffer[128];
+		for (const auto& Move : MoveLog)
+		{
+			WriteLoggedMove(Move, Notation, Position, TurnNumber / 2 + 1, Buffer, sizeof(Buffer));
+			cout << Buffer << endl;
+			myFile << Buffer << endl;
+			MakePositionMove(Position, { static_cast<uint8_t>(MoveFrom(Move.Move)), static_cast<uint8_t>(MoveTo(Move.Move)), NoPieceCode });
+			TurnNumber++;
+		}
 
 		// Close the file.
 		myFile.close();
@@ -140,101 +331,139 @@ void GameManager::PrintList()
 	// If it failed, print an appropriate error message.
 	catch (exception& e) { cout << "Error: " << e.what() << endl; }
 
+	// Save the game as PGN too.
+	ExportPgn("ChessGame.pgn");
+
 }
 
-// Function to make a human move.
-void GameManager::HumanMove()
+// Function to write the game to a PGN file.
+void GameManager::ExportPgn(const string& FileName) const
 {
 
-	// Declare some useful variables.
-	string Colour1, Colour2;
-	bool GoodHumanInput{ false };
+	// Replay the saved moves from the starting position, so each one can be written in algebraic notation.
+	// The board always promotes to a queen, which is what a move without a promotion piece means.
+	PgnGame Game;
+	Game.StartingPosition = StartingPosition;
+	FENPosition Position{ StartingPosition };
+	for (const auto& Move : SavedGame)
+	{
+		Game.Moves.push_back({ static_cast<uint8_t>(MoveFrom(Move)), static_cast<uint8_t>(MoveTo(Move)), NoPieceCode });
+		MakePositionMove(Position, Game.Moves.back());
+	}
 
-	// Set Colour1 and Colour2 according to whose turn it is.
-	// An even GameTurnNumber corresponds to white's turn, and odd corresponds to black's turn.
-	if (GameTurnNumber % 2 == 0) { Colour1 = "White"; Colour2 = "Black"; }
-	else { Colour2 = "White"; Colour1 = "Black"; }
+	// Work out the result: checkmate, stalemate, the fifty move rule or too little material end the game, otherwise it is unfinished.
+	Game.Result = GameEndingResult(Position, FindGameEnding(Position));
+
+	// The seven standard tags, and the starting position if the game didn't start from the usual one.
+	time_t rawtime;
+	struct tm timeinfo;
+	time(&rawtime);
+	LocalTime(rawtime, timeinfo);
+	char Date[48];
+	snprintf(Date, sizeof(Date), "%04d.%02d.%02d", timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday);
+	Game.Tags = { {"Event", "Chess Game by James Cummins"}, {"Site", "?"}, {"Date", Date}, {"Round", "-"}, {"White", "?"}, {"Black", "?"}, {"Result", Game.Result} };
+	char FEN[MaximumFENLength];
+	string StartFEN(FEN, WriteFEN(StartingPosition, FEN));
+	if (StartFEN != StartingFEN) { Game.Tags.push_back({ "SetUp", "1" }); Game.Tags.push_back({ "FEN", StartFEN }); }
+
+	// Write the file.
+	ofstream myFile(FileName);
+	if (!myFile.is_open()) { cerr << "Error: Unable to write " << FileName << "." << endl; return; }
+	WritePgnGame(myFile, Game);
+
+}
+
+// The questions asked for the coordinates of a human move, in the order they are asked.
+static const char* const HumanMovePrompts[4]{
+	"\nEnter the current file of the piece you'd like to move (e.g. 'a') : ",
+	"Enter the current rank of the piece you'd like to move (e.g. '1') : ",
+	"Enter the file of the position you'd like to move the piece to    : ",
+	"Enter the rank of the position you'd like to move the piece to    : "
+};
+
+// Function to start a human move.
+void GameManager::BeginHumanMove()
+{
 
 	// Print a message of whose turn it is.
-	if (Colour1 == "White") { cout << "\n" << (GameTurnNumber) / 2 + 1 << ") White Turn." << endl; }
-	if (Colour1 == "Black") { cout << "\n" << (GameTurnNumber + 1) / 2 << ") Black Turn." << endl; }
+	// An even GameTurnNumber corresponds to white's turn, and odd corresponds to black's turn.
+	if (GameTurnNumber % 2 == 0) { cout << "\n" << (GameTurnNumber) / 2 + 1 << ") White Turn." << endl; }
+	else { cout << "\n" << (GameTurnNumber + 1) / 2 << ") Black Turn." << endl; }
 
 	// Get the current time to measure the elapsed time of the move.
-	auto Start = chrono::system_clock::now();
+	HumanMoveStart = chrono::system_clock::now();
 
-	// While the GoodHumanInput bool is false, do this loop.
-	while (!GoodHumanInput)
-	{
-
-		// Ask the user to enter the coordinates.
-		cout << "\nEnter the current file of the piece you'd like to move (e.g. 'a') : ";
-		int OldY{ FileInput() };
-		cout << "Enter the current rank of the piece you'd like to move (e.g. '1') : ";
-		int OldX{ 8 - GoodNumber() };
-		cout << "Enter the file of the position you'd like to move the piece to    : ";
-		int NewY{ FileInput() };
-		cout << "Enter the rank of the position you'd like to move the piece to    : ";
-		int NewX{ 8 - GoodNumber() };
-
-		// If the coordinates correspond to a valid move, enter this section.
-		if (TheBoard->GetPiece(OldX, OldY) && TheBoard->GetPiece(OldX, OldY)->GetColour() == Colour1 && TheBoard->CanPieceMove(OldX, OldY, NewX, NewY) && WillPieceAvoidCheckMate(OldX, OldY, NewX, NewY, Colour1)) {
-			
-			// If the moved piece was a pawn, then reset the PawnMoveCounter to zero. Else, iterate it by one.
-			if (TheBoard->GetPiece(OldX, OldY)->GetName() == "Pawn") { PawnMoveCounter = 0; }
-			else { PawnMoveCounter++; }
-
-			// If the turn colour is white, then insert the move into the multimap with the correct adjusted GameTurnNumber.
-			if (Colour1 == "White")
-			{
-				ListOfMoves.insert(pair <int, string> ((GameTurnNumber)/2 + 1, TheBoard->GetPiece(OldX, OldY)->GetColour() + " " + TheBoard->GetPiece(OldX, OldY)->GetName() + " was moved from (" + ReturnChar(OldY) + ", " + to_string(8 - OldX) + ") to (" + ReturnChar(NewY) + ", " + to_string(8 - NewX) + ")."));
-			}
-			// Else if the colour is black, then do the same thing with the different adjusted GameTurnNumber.
-			else
-			{
-				ListOfMoves.insert(pair <int, string>((GameTurnNumber + 1) / 2, TheBoard->GetPiece(OldX, OldY)->GetColour() + " " + TheBoard->GetPiece(OldX, OldY)->GetName() + " was moved from (" + ReturnChar(OldY) + ", " + to_string(8 - OldX) + ") to (" + ReturnChar(NewY) + ", " + to_string(8 - NewX) + ")."));
-			}
-			// Add the coordinates to the SavedGame vector.
-			SavedGame.push_back({ OldX, OldY, NewX, NewY });
+	// Ask the user to enter the first coordinate.
+	HumanMoveField = 0;
+	cout << HumanMovePrompts[0];
 
-			// If the move is an en passant move, print out a personalised message.
-			if (TheBoard->EnPassantMove(OldX, OldY, NewX, NewY)) {
-				cout << "\nCongratulations! " << Colour1 << " Pawn took " << Colour2 << " Pawn via en passant." << endl;
-				CaptureCounter = 0;
-			}
-			// If the move captured a piece, print out a personalised message.
-			if (TheBoard->GetPiece(NewX, NewY)) {
-				cout << "\nCongratulations! " << Colour1 << " " << TheBoard->GetPiece(OldX, OldY)->GetName() << " took " << Colour2 << " " << TheBoard->GetPiece(NewX, NewY)->GetName() << "." << endl;
-				CaptureCounter = 0;
-			}
-			// If no piece was captured, iterate the capture counter by one.
-			if (!TheBoard->EnPassantMove(OldX, OldY, NewX, NewY) && !TheBoard->GetPiece(NewX, NewY)) { CaptureCounter++; }
+}
 
-			// Set the computer pieces to null pointers.
-			TheBoard->SetComputerEnPassantPiece(nullptr);
-			TheBoard->SetComputerPromotedPawn(nullptr);
+// Function to take the user's answer to a question of a human move.
+bool GameManager::AnswerHumanMove(const string& Line)
+{
 
-			// Move the piece.
-			TheBoard->MovePiece(OldX, OldY, NewX, NewY);
-			// If the move was a pawn promotion, this function will print out a message saying so.
-			PrintPawnPromotion();
+	// Read the coordinate asked for: a file, then a rank, for each of the two positions. Ask again if it's no good,
+	// and ask for the next one if there is one.
+	int Coordinate;
+	if (!(HumanMoveField % 2 == 0 ? FileInput(Line, Coordinate) : GoodNumber(Line, Coordinate))) { return false; }
+	HumanMoveInput[HumanMoveField] = HumanMoveField % 2 == 0 ? Coordinate : 8 - Coordinate;
+	if (++HumanMoveField < 4) { cout << HumanMovePrompts[HumanMoveField]; return false; }
+	HumanMoveField = 0;
 
-			// Set the variable LastPiece to false for all the piece.
-			TheBoard->SetBoardLastPieceFalse();
-			// Then set LastPiece to true for the piece that was just moved.
-			TheBoard->GetPiece(NewX, NewY)->SetLastPiece(true);
+	// Declare some useful variables.
+	string Colour1, Colour2;
+	int OldY{ HumanMoveInput[0] }, OldX{ HumanMoveInput[1] }, NewY{ HumanMoveInput[2] }, NewX{ HumanMoveInput[3] };
 
-			// To get here the input was good so set the GoodHumanInput bool to true.
-			GoodHumanInput = true;
-		}
-		// If it was not a valid move, print out a message.
-		else { cout << "Error: Invalid " << Colour1 << " move.\nPlease try again." << endl; }
+	// Set Colour1 and Colour2 according to whose turn it is.
+	if (GameTurnNumber % 2 == 0) { Colour1 = "White"; Colour2 = "Black"; }
+	else { Colour2 = "White"; Colour1 = "Black"; }
+
+	// If the coordinates don't correspond to a valid move, print out a message and ask for the move again.
+	if (!(TheBoard->GetPiece(OldX, OldY) && TheBoard->GetPiece(OldX, OldY)->GetColour() == Colour1 && TheBoard->CanPieceMove(OldX, OldY, NewX, NewY) && WillPieceAvoidCheckMate(OldX, OldY, NewX, NewY, Colour1)))
+	{
+		cout << "Error: Invalid " << Colour1 << " move.\nPlease try again." << endl;
+		cout << HumanMovePrompts[0];
+		return false;
+	}
+
+	// Add the move to the log. If the moved piece was a pawn, then reset the PawnMoveCounter to zero. Else, iterate it by one.
+	int MovedCode{ LogMove(OldX, OldY, NewX, NewY) };
+	if (MovedCode == WhitePawnCode || MovedCode == BlackPawnCode) { PawnMoveCounter = 0; }
+	else { PawnMoveCounter++; }
+
+	// Add the move to the SavedGame vector.
+	SavedGame.push_back(PackBoardMove(OldX, OldY, NewX, NewY));
 
+	// If the move is an en passant move, print out a personalised message.
+	if (TheBoard->EnPassantMove(OldX, OldY, NewX, NewY)) {
+		cout << "\nCongratulations! " << Colour1 << " Pawn took " << Colour2 << " Pawn via en passant." << endl;
+		CaptureCounter = 0;
 	}
+	// If the move captured a piece, print out a personalised message.
+	if (TheBoard->GetPiece(NewX, NewY)) {
+		cout << "\nCongratulations! " << Colour1 << " " << TheBoard->GetPiece(OldX, OldY)->GetName() << " took " << Colour2 << " " << TheBoard->GetPiece(NewX, NewY)->GetName() << "." << endl;
+		CaptureCounter = 0;
+	}
+	// If no piece was captured, iterate the capture counter by one.
+	if (!TheBoard->EnPassantMove(OldX, OldY, NewX, NewY) && !TheBoard->GetPiece(NewX, NewY)) { CaptureCounter++; }
+
+	// Set the computer pieces to null pointers.
+	TheBoard->SetComputerEnPassantPiece(nullptr);
+	TheBoard->SetComputerPromotedPawn(nullptr);
+
+	// Move the piece.
+	TheBoard->MovePiece(OldX, OldY, NewX, NewY);
+	// If the move was a pawn promotion, this function will print out a message saying so.
+	PrintPawnPromotion();
+
+	// The piece that was just moved is now the last piece to have moved.
+	TheBoard->SetLastPieceSquare(8 * NewX + NewY);
 
 	// Get the current time now that the move has finished.
 	auto End = chrono::system_clock::now();
 	// Print out the elapsed time in seconds to two decimal places.
-	cout << fixed << setprecision(2) << "\nElapsed time: " << chrono::duration<double>(End - Start).count() << " seconds." << endl;
+	cout << fixed << setprecision(2) << "\nElapsed time: " << chrono::duration<double>(End - HumanMoveStart).count() << " seconds." << endl;
 
 	// Print the updated chessboard.
 	TheBoard->PrintBoard();
@@ -245,6 +474,7 @@ void GameManager::HumanMove()
 	GameTurnNumber++;
 	// Reset the computer en passant piece to a null pointer.
 	TheBoard->SetComputerEnPassantPiece(nullptr);
+	return true;
 
 }
 
@@ -254,7 +484,7 @@ void GameManager::ComputerMove(bool IntelligentTrueRandomFalse)
 	
 	// Declare some useful variables.
 	string Colour1, Colour2;
-	bool GoodComputerInput{ false };
+	bool GoodComputerInput{ false }, TriedBook{ false };
 	int OldX, OldY, NewX, NewY;
 	PossibleMove AIMove;
 
@@ -268,6 +498,8 @@ void GameManager::ComputerMove(bool IntelligentTrueRandomFalse)
 
 	// Get the current time to measure the elapsed time of the move.
 	auto Start = chrono::system_clock::now();
+	// Reset the lazy evaluation counters so that they only cover this move.
+	ResetLazyEvaluationCounters();
 
 	// While the computer input is not good, loop this.
 	while (!GoodComputerInput)
@@ -286,18 +518,29 @@ void GameManager::ComputerMove(bool IntelligentTrueRandomFalse)
 			// A depth further than three will really take too long so I wouldn't do that.
 			// Note: Depth can be 1,2,3,4,... (NOT ZERO).
 			const int MinimaxDepth{ 2 }; // <- Set minimax depth here.
-			if (Colour1 == "White") { MaximiseBoardEvaluation = true; AIMove = MinimaxMove(MinimaxDepth, true); }
+			// If the opening book has the position, play one of its moves instead, which needs no search at all.
+			// The board always promotes to a queen, so a book move promoting to anything else is left to the search.
+			PositionMove BookMove;
+			FENPosition Position;
+			if (!TriedBook && ActiveBook().IsOpen()) { GetPosition(Position); }
+			if (!TriedBook && ActiveBook().IsOpen() && ActiveBook().ChooseMove(Position, false, BookMove) && (BookMove.Promotion == NoPieceCode || (BookMove.Promotion - 1) % 6 == 4))
+			{
+				AIMove = { BookMove.From / 8, BookMove.From % 8, BookMove.To / 8, BookMove.To % 8 };
+				cout << "Move taken from the opening book." << endl;
+			}
+			else if (Colour1 == "White") { MaximiseBoardEvaluation = true; AIMove = MinimaxMove(MinimaxDepth, true); }
 			else { MaximiseBoardEvaluation = false; AIMove = MinimaxMove(MinimaxDepth, false); }
+			TriedBook = true;
 		}
 		// Else if we just want a random move.
 		else
 		{
 			// Get a vector of all the possible moves that can be made.
-			vector<PossibleMove> GameMoves{ AllPossibleMoves(Colour1) };
+			vector<PackedMove> GameMoves{ AllPossibleMoves(Colour1) };
 			// Randomly shuffle the vector.
 			random_shuffle(GameMoves.begin(), GameMoves.end());
 			// Select the first element of the vector. This will then be a randomly selected move.
-			AIMove = GameMoves[0];
+			AIMove = ToPossibleMove(GameMoves[0]);
 		}
 
 		// Set the coordinates to what the computer has come up with.
@@ -314,22 +557,13 @@ void GameManager::ComputerMove(bool IntelligentTrueRandomFalse)
 
 	}
 
-	// If the moved piece was a pawn, then reset the PawnMoveCounter to zero. Else, iterate it by one.
-	if (TheBoard->GetPiece(OldX, OldY)->GetName() == "Pawn") { PawnMoveCounter = 0; }
+	// Add the move to the log. If the moved piece was a pawn, then reset the PawnMoveCounter to zero. Else, iterate it by one.
+	int MovedCode{ LogMove(OldX, OldY, NewX, NewY) };
+	if (MovedCode == WhitePawnCode || MovedCode == BlackPawnCode) { PawnMoveCounter = 0; }
 	else { PawnMoveCounter++; }
 
-	// If the turn colour is white, then insert the move into the multimap with the correct adjusted GameTurnNumber.
-	if (Colour1 == "White")
-	{
-		ListOfMoves.insert(pair <int, string>((GameTurnNumber) / 2 + 1, TheBoard->GetPiece(OldX, OldY)->GetColour() + " " + TheBoard->GetPiece(OldX, OldY)->GetName() + " was moved from (" + ReturnChar(OldY) + ", " + to_string(8 - OldX) + ") to (" + ReturnChar(NewY) + ", " + to_string(8 - NewX) + ")."));
-	}
-	// Else if the colour is black, then do the same thing with the different adjusted GameTurnNumber.
-	else
-	{
-		ListOfMoves.insert(pair <int, string>((GameTurnNumber + 1) / 2, TheBoard->GetPiece(OldX, OldY)->GetColour() + " " + TheBoard->GetPiece(OldX, OldY)->GetName() + " was moved from (" + ReturnChar(OldY) + ", " + to_string(8 - OldX) + ") to (" + ReturnChar(NewY) + ", " + to_string(8 - NewX) + ")."));
-	}
-	// Add the coordinates to the SavedGame vector.
-	SavedGame.push_back({ OldX, OldY, NewX, NewY });
+	// Add the move to the SavedGame vector.
+	SavedGame.push_back(PackBoardMove(OldX, OldY, NewX, NewY));
 
 	// If the move is an en passant move, print out a personalised message.
 	if (TheBoard->EnPassantMove(OldX, OldY, NewX, NewY)) {
@@ -349,10 +583,8 @@ void GameManager::ComputerMove(bool IntelligentTrueRandomFalse)
 	// If the move was a pawn promotion, this function will print out a message saying so.
 	PrintPawnPromotion();
 
-	// Set the variable LastPiece to false for all the piece.
-	TheBoard->SetBoardLastPieceFalse();
-	// Then set LastPiece to true for the piece that was just moved.
-	TheBoard->GetPiece(NewX, NewY)->SetLastPiece(true);
+	// The piece that was just moved is now the last piece to have moved.
+	TheBoard->SetLastPieceSquare(8 * NewX + NewY);
 
 	// Get the current time now that the move has finished.
 	auto End = chrono::system_clock::now();
@@ -360,6 +592,11 @@ void GameManager::ComputerMove(bool IntelligentTrueRandomFalse)
 	if (IntelligentTrueRandomFalse)
 	{
 		cout << fixed << setprecision(2) << "\nElapsed time: " << chrono::duration<double>(End - Start).count() << " seconds." << endl;
+		// Also print how often the lazy evaluation exited early, so that the margin can be tuned.
+		if (LazyEvaluationCalls > 0)
+		{
+			cout << "Lazy evaluation: " << LazyEvaluationExits << " of " << LazyEvaluationCalls << " leaf evaluations exited early (" << 100.0 * LazyEvaluationExits / LazyEvaluationCalls << "%)." << endl;
+		}
 	}
 	else
 	{
@@ -380,22 +617,13 @@ void GameManager::ComputerMove(bool IntelligentTrueRandomFalse)
 void GameManager::SpecifiedMove(int OldX, int OldY, int NewX, int NewY, bool Save)
 {
 
-	// If the moved piece was a pawn, then reset the PawnMoveCounter to zero. Else, iterate it by one.
-	if (TheBoard->GetPiece(OldX, OldY)->GetName() == "Pawn") { PawnMoveCounter = 0; }
+	// Add the move to the log. If the moved piece was a pawn, then reset the PawnMoveCounter to zero. Else, iterate it by one.
+	int MovedCode{ LogMove(OldX, OldY, NewX, NewY) };
+	if (MovedCode == WhitePawnCode || MovedCode == BlackPawnCode) { PawnMoveCounter = 0; }
 	else { PawnMoveCounter++; }
 
-	// If the turn colour is white, then insert the move into the multimap with the correct adjusted GameTurnNumber.
-	if (GameTurnNumber % 2 == 0)
-	{
-		ListOfMoves.insert(pair <int, string>((GameTurnNumber) / 2 + 1, TheBoard->GetPiece(OldX, OldY)->GetColour() + " " + TheBoard->GetPiece(OldX, OldY)->GetName() + " was moved from (" + ReturnChar(OldY) + ", " + to_string(8 - OldX) + ") to (" + ReturnChar(NewY) + ", " + to_string(8 - NewX) + ")."));
-	}
-	// Else if the colour is black, then do the same thing with the different adjusted GameTurnNumber.
-	else
-	{
-		ListOfMoves.insert(pair <int, string>((GameTurnNumber + 1) / 2, TheBoard->GetPiece(OldX, OldY)->GetColour() + " " + TheBoard->GetPiece(OldX, OldY)->GetName() + " was moved from (" + ReturnChar(OldY) + ", " + to_string(8 - OldX) + ") to (" + ReturnChar(NewY) + ", " + to_string(8 - NewX) + ")."));
-	}
-	// Add the coordinates to the SavedGame vector if specified.
-	if (Save) { SavedGame.push_back({ OldX, OldY, NewX, NewY }); }
+	// Add the move to the SavedGame vector if specified.
+	if (Save) { SavedGame.push_back(PackBoardMove(OldX, OldY, NewX, NewY)); }
 
 	// If the move captured an opposing piece, reset CaptureCounter to zero.
 	if (TheBoard->EnPassantMove(OldX, OldY, NewX, NewY)) { CaptureCounter = 0; }
@@ -405,17 +633,82 @@ void GameManager::SpecifiedMove(int OldX, int OldY, int NewX, int NewY, bool Sav
 
 	// Move the piece.
 	TheBoard->MovePiece(OldX, OldY, NewX, NewY);
-	// Set the variable LastPiece to false for all the piece.
-	TheBoard->SetBoardLastPieceFalse();
-	// Then set LastPiece to true for the piece that was just moved.
-	TheBoard->GetPiece(NewX, NewY)->SetLastPiece(true);
+	// The piece that was just moved is now the last piece to have moved.
+	TheBoard->SetLastPieceSquare(8 * NewX + NewY);
 	// Iterate the GameTurnNumber.
 	GameTurnNumber++;
 
 }
 
+// Function to make a move given as coordinates.
+void GameManager::MakeMove(const PossibleMove& TheMove) { MakeMove(PackBoardMove(TheMove.OriginalX, TheMove.OriginalY, TheMove.MovedX, TheMove.MovedY)); }
+
+// Function to make a move and remember how to take it back.
+void GameManager::MakeMove(PackedMove TheMove)
+{
+
+	// Start the undo record with the move and the counters as they are now.
+	int OriginalX{ MoveFrom(TheMove) / 8 }, OriginalY{ MoveFrom(TheMove) % 8 }, MovedX{ MoveTo(TheMove) / 8 }, MovedY{ MoveTo(TheMove) % 8 };
+	UndoRecord Record;
+	Record.Move = TheMove;
+	Record.CaptureCounter = CaptureCounter;
+	Record.PawnMoveCounter = PawnMoveCounter;
+	// The board keeps the square of the piece that moved last, since its 'LastPiece' variable is about to be cleared.
+	Record.PreviousLastSquare = TheBoard->GetLastPieceSquare();
+
+	// Update the counters in the same way as SpecifiedMove.
+	int MovedCode{ TheBoard->GetPieceCodes()[MoveFrom(TheMove)] };
+	if (MovedCode == WhitePawnCode || MovedCode == BlackPawnCode) { PawnMoveCounter = 0; }
+	else { PawnMoveCounter++; }
+	if (TheBoard->EnPassantMove(OriginalX, OriginalY, MovedX, MovedY) || TheBoard->GetPiece(MovedX, MovedY)) { CaptureCounter = 0; }
+	else { CaptureCounter++; }
+
+	// Move the piece and copy what the board recorded about the move into the undo record.
+	TheBoard->MovePiece(OriginalX, OriginalY, MovedX, MovedY);
+	Record.MovedPiece = TheBoard->GetComputerMovedPiece();
+	Record.CapturedPiece = TheBoard->GetComputerCapturedPiece();
+	Record.EnPassantPiece = TheBoard->GetComputerEnPassantPiece();
+	Record.PromotedPawn = TheBoard->GetComputerPromotedPawn();
+
+	// The piece that was just moved is now the last piece to have moved.
+	TheBoard->SetLastPieceSquare(MoveTo(TheMove));
+
+	// Iterate the GameTurnNumber and keep the undo record.
+	GameTurnNumber++;
+	UndoStack.push_back(Record);
+
+}
+
+// Function to take back the last move made with MakeMove.
+void GameManager::UnmakeMove()
+{
+
+	// If there is nothing to take back, print an error message.
+	if (UndoStack.empty()) { cerr << "Error: There is no move to unmake." << endl; return; }
+	UndoRecord Record{ UndoStack.back() };
+	UndoStack.pop_back();
+
+	// Give the board back the pieces and coordinates of the move, since other moves may have been tried since.
+	int OriginalX{ MoveFrom(Record.Move) / 8 }, OriginalY{ MoveFrom(Record.Move) % 8 };
+	TheBoard->SetComputerPositions(OriginalX, OriginalY, MoveTo(Record.Move) / 8, MoveTo(Record.Move) % 8);
+	TheBoard->SetComputerPieces(Record.MovedPiece, Record.CapturedPiece);
+	TheBoard->SetComputerEnPassantPiece(Record.EnPassantPiece);
+	TheBoard->SetComputerPromotedPawn(Record.PromotedPawn);
+	// Now the board can undo the move itself.
+	UndoLastComputerMove();
+
+	// Restore the 'LastPiece' variables and the counters. The moved piece is back on its original square,
+	// so clear its variable there before the board makes the previous last piece (which may be the same one) last again.
+	TheBoard->GetPiece(OriginalX, OriginalY)->SetLastPiece(false);
+	TheBoard->SetLastPieceSquare(Record.PreviousLastSquare);
+	CaptureCounter = Record.CaptureCounter;
+	PawnMoveCounter = Record.PawnMoveCounter;
+	GameTurnNumber--;
+
+}
+
 // Function to give the user a choice of game modes.
-int  GameManager::GameModeSelection()
+void GameManager::AskGameMode()
 {
 
 	// Inform the user of the game modes to choose from.
@@ -426,35 +719,25 @@ int  GameManager::GameModeSelection()
 	cout << "[4] Computer (Intelligent) VS Computer (Random).\n" << endl;
 	cout << "Please enter the corresponding number: ";
 
-	// Get an input for the game mode, using the template function.
-	int Mode{ GoodInput(1, 2, 3, 4) };
-
-	// Return the corresponding game mode.
-	if (Mode == 1) { return 1; }
-	if (Mode == 2) { return 2; }
-	if (Mode == 3) { return 3; }
-	if (Mode == 4) { return 4; }
-
-	// As a backup, if the good input function fails (which it definetly shouldn't)...
-	// then print an error message and return game mode 1.
-	if (Mode != 1 && Mode != 2 && Mode != 3 && Mode != 4)
-	{
-		cerr << "Error: Could not determine game mode.\nDefault selected." << endl;
-	}
-	
-	return 1;
-
 }
 
+// Function to take the user's choice of game mode, using the template function.
+bool GameManager::AnswerGameMode(const string& Line, int& Mode) { return GoodInput(Line, 1, 2, 3, 4, Mode); }
+
 // Function to give the user a choice to load a saved game.
-void GameManager::LoadGameSelection()
+void GameManager::AskLoadGame()
 {
-
 	// Ask the user if they would like to load a game.
 	cout << "\nWould you like to load a previously saved game (Y/N)? ";
+}
+
+// Function to take the user's choice to load a saved game.
+bool GameManager::AnswerLoadGame(const string& Line)
+{
 
 	// Use the template function to get the user's input.
-	char Answer{ GoodInput('Y', 'Y', 'N', 'N') };
+	char Answer;
+	if (!GoodInput(Line, 'Y', 'Y', 'N', 'N', Answer)) { return false; }
 
 	// If the answer was a yes, then enter this section.
 	if (Answer == 'Y')
@@ -472,11 +755,117 @@ void GameManager::LoadGameSelection()
 		TheBoard->PrintBoard();
 	}
 	// If the answer was a no then do nothing.
+	return true;
+
+}
+
+// The neural network is looked for next to the program.
+const string NeuralNetworkFile{ "ChessNet.nnue" };
+
+// Function to give the user a choice of evaluation function, if a neural network file is available.
+bool GameManager::AskEvaluator()
+{
+
+	// If there isn't a network, keep the classic evaluation.
+	if (!ifstream(NeuralNetworkFile).good()) { return false; }
+
+	// Ask the user if they would like to use it.
+	cout << "\nA neural network (" << NeuralNetworkFile << ") was found. Would you like the computer to use it (Y/N)? ";
+	return true;
 
 }
 
+// Function to take the user's choice of evaluation function.
+bool GameManager::AnswerEvaluator(const string& Line)
+{
+
+	char Answer;
+	if (!GoodInput(Line, 'Y', 'Y', 'N', 'N', Answer)) { return false; }
+
+	// If the answer was a yes, then load the network and switch to it.
+	if (Answer == 'Y' && LoadNeuralNetwork(NeuralNetworkFile))
+	{
+		SetEvaluator(NeuralEvaluation);
+		cout << "Neural evaluation selected." << endl;
+	}
+	return true;
+
+}
+
+// Function to load a neural network from a file.
+bool GameManager::LoadNeuralNetwork(const string& FileName)
+{
+	shared_ptr<NeuralNetwork> NewNetwork{ make_shared<NeuralNetwork>() };
+	if (!NewNetwork->LoadFromFile(FileName)) { return false; }
+	Network = NewNetwork;
+	// If the network is already in use, give the board the new one.
+	if (Evaluator == NeuralEvaluation) { TheBoard->EnableNeuralEvaluation(Network); }
+	return true;
+}
+
+// Access function for the evaluation function.
+EvaluationType GameManager::GetEvaluator() const { return Evaluator; }
+
+// Mutator function for the evaluation function.
+// The neural evaluation can only be selected once a network has been loaded.
+void GameManager::SetEvaluator(EvaluationType NewEvaluator)
+{
+	if (NewEvaluator == NeuralEvaluation && !Network)
+	{
+		cerr << "Error: No neural network has been loaded.\nClassic evaluation selected." << endl;
+		NewEvaluator = ClassicEvaluation;
+	}
+	Evaluator = NewEvaluator;
+	// The board only keeps an accumulator while the neural evaluation is in use.
+	if (Evaluator == NeuralEvaluation) { TheBoard->EnableNeuralEvaluation(Network); }
+	else { TheBoard->DisableNeuralEvaluation(); }
+}
+
+// Function to return the evaluation of the current position from white's point of view.
+double GameManager::EvaluatePosition()
+{
+	if (Evaluator == NeuralEvaluation) { return TheBoard->EvaluateNeural(GameTurnNumber % 2 == 0); }
+	return TheBoard->EvaluateBoard() + TheBoard->EvaluatePositionalTerms();
+}
+
+// Function to return the leaf evaluation used by the minimax search.
+double GameManager::LazyEvaluation(double Alpha, double Beta)
+{
+
+	// The neural evaluation is a single step, so there is nothing to skip.
+	if (Evaluator == NeuralEvaluation || LazyEvaluationMargin < 0)
+	{
+		return GetMaxBoardEval() ? EvaluatePosition() : -EvaluatePosition();
+	}
+
+	// Start with the cheap estimate: material and piece positions.
+	LazyEvaluationCalls++;
+	double Sign{ GetMaxBoardEval() ? 1.0 : -1.0 };
+	double Estimate{ Sign * TheBoard->EvaluateBoard() };
+
+	// If the estimate is so far outside the window that the expensive terms can't bring it back, return it now.
+	if (Estimate + LazyEvaluationMargin <= Alpha || Estimate - LazyEvaluationMargin >= Beta)
+	{
+		LazyEvaluationExits++;
+		return Estimate;
+	}
+
+	// Otherwise add the expensive terms.
+	return Estimate + Sign * TheBoard->EvaluatePositionalTerms();
+
+}
+
+// Access and mutator functions for the lazy evaluation.
+double GameManager::GetLazyEvaluationMargin() const { return LazyEvaluationMargin; }
+void GameManager::SetLazyEvaluationMargin(double Margin) { LazyEvaluationMargin = Margin; }
+bool GameManager::GetMoveOrdering() const { return MoveOrdering; }
+void GameManager::SetMoveOrdering(bool Ordering) { MoveOrdering = Ordering; }
+long long GameManager::GetLazyEvaluationCalls() const { return LazyEvaluationCalls; }
+long long GameManager::GetLazyEvaluationExits() const { return LazyEvaluationExits; }
+void GameManager::ResetLazyEvaluationCounters() { LazyEvaluationCalls = LazyEvaluationExits = 0; }
+
 // Function to give the user options before making a move.
-void GameManager::BeginOptionMenu()
+void GameManager::AskBeginOption()
 {
 
 	// Define and set the colour.
@@ -486,12 +875,23 @@ void GameManager::BeginOptionMenu()
 
 	// Print out the available options.
 	cout << "\nOptions: [P]lay next " << Colour << " move. Display " << Colour << " [A]llowed moves. [H]int. [Q]uit game." << endl;
-	
+
+}
+
+// Function to take the user's option before making a move.
+bool GameManager::AnswerBeginOption(const string& Line, char& ChosenOption)
+{
+
+	// Define and set the colour.
+	string Colour;
+	if (GameTurnNumber % 2 == 0) { Colour = "White"; }
+	else { Colour = "Black"; }
+
 	// Get the chosen option using the template function.
-	char ChosenOption{ GoodInput('P', 'A', 'H', 'Q') };
+	if (!GoodInput(Line, 'P', 'A', 'H', 'Q', ChosenOption)) { return false; }
 
-	// If Q, then quit the game.
-	if (ChosenOption == 'Q') { cout << "Thank you for playing." << endl; exit(1); }
+	// If Q, then say goodbye. The game is ended by whoever is running it.
+	if (ChosenOption == 'Q') { cout << "Thank you for playing." << endl; }
 	// If A, then print the allowed moves.
 	if (ChosenOption == 'A') { PrintAllowedMoves(Colour); }
 	// If H, then print out the best move.
@@ -504,11 +904,12 @@ void GameManager::BeginOptionMenu()
 		else { MaximiseBoardEvaluation = false; SuggestedMove = MinimaxMove(2, false); }
 		cout << "Suggested move: (" << ReturnChar(SuggestedMove.OriginalY) << ", " << 8 - SuggestedMove.OriginalX << ") -> (" << ReturnChar(SuggestedMove.MovedY) << ", " << 8 - SuggestedMove.MovedX << ")." << endl;
 	}
+	return true;
 
 }
 
-// Function to give the user options after  making a move.
-void GameManager::EndOptionMenu()
+// Function to give the user options after making a move.
+void GameManager::AskEndOption()
 {
 
 	// Define and set the colour.
@@ -519,13 +920,19 @@ void GameManager::EndOptionMenu()
 	// Print out the available options.
 	cout << "\nOptions: [G]ive turn over to " << Colour << ". [U]ndo last move. [S]ave game. [Q]uit game." << endl;
 
+}
+
+// Function to take the user's option after making a move.
+bool GameManager::AnswerEndOption(const string& Line, char& ChosenOption)
+{
+
 	// Get the chosen option using the template function.
-	char ChosenOption{ GoodInput('G', 'U', 'S', 'Q') };
+	if (!GoodInput(Line, 'G', 'U', 'S', 'Q', ChosenOption)) { return false; }
 
 	// If S, save the game.
-	if (ChosenOption == 'S') { cout << "Game saved to file (SavedGame.txt)." << endl; SaveGame(); }
-	// If Q, quit the game.
-	if (ChosenOption == 'Q') { cout << "Thank you for playing." << endl; exit(1); }
+	if (ChosenOption == 'S') { cout << "Game saved to file (" << SavedGameFile << ")." << endl; SaveGame(); }
+	// If Q, then say goodbye. The game is ended by whoever is running it.
+	if (ChosenOption == 'Q') { cout << "Thank you for playing." << endl; }
 	// If U, undo the last move, and print the updated chessboard.
 	if (ChosenOption == 'U')
 	{
@@ -533,6 +940,7 @@ void GameManager::EndOptionMenu()
 		UndoAnyNumberOfMoves(1);
 		TheBoard->PrintBoard();
 	}
+	return true;
 
 }
 
@@ -623,11 +1031,11 @@ int  GameManager::NumberOfAllowedMoves(string Colour)
 }
 
 // Function to return a vector of all the allowed moves.
-vector<PossibleMove> GameManager::AllPossibleMoves(string Colour)
+vector<PackedMove> GameManager::AllPossibleMoves(string Colour)
 {
 
 	// Define the vector of all possible moves.
-	vector<PossibleMove> PossibleMovesVector;
+	vector<PackedMove> PossibleMovesVector;
 
 	// Iterate through the entire chessboard checking all the moves that can be made.
 	for (int i = 0; i < 8; i++)
@@ -644,7 +1052,7 @@ vector<PossibleMove> GameManager::AllPossibleMoves(string Colour)
 						if (TheBoard->CanPieceMove(i, j, k, l) && WillPieceAvoidCheckMate(i, j, k, l, Colour))
 						{
 							// If the move is allowed, add it to the vector.
-							PossibleMovesVector.push_back({i, j, k, l});
+							PossibleMovesVector.push_back(PackBoardMove(i, j, k, l));
 						}
 					}
 				}
@@ -657,6 +1065,9 @@ vector<PossibleMove> GameManager::AllPossibleMoves(string Colour)
 
 }
 
+// Function to pack a move on the board as it is now, with its flags.
+PackedMove GameManager::PackBoardMove(int OldX, int OldY, int NewX, int NewY) const { return PackMove(TheBoard->GetPieceCodes(), 8 * OldX + OldY, 8 * NewX + NewY); }
+
 // Function to check if the king is in checkmate or not.
 bool GameManager::KingInCheckMate(string Colour)
 {
@@ -779,7 +1190,7 @@ void GameManager::UndoAnyNumberOfMoves(int Number)
 {
 
 	// Declare a back up game as a vector of moves.
-	vector<PossibleMove> BackUpGame;
+	vector<PackedMove> BackUpGame;
 
 	// Delete the specified number of elements in the saved game vector.
 	if (!SavedGame.empty())
@@ -790,12 +1201,8 @@ void GameManager::UndoAnyNumberOfMoves(int Number)
 		}
 	}
 
-	// Initialise the board.
-	TheBoard->InitialiseBoard();
-	// Set all the variables to zero.
-	GameTurnNumber = CaptureCounter = PawnMoveCounter = 0;
-	// Clear the list of moves.
-	ListOfMoves.clear();
+	// Go back to the starting position, with the variables and list of moves reset.
+	ResetToStartingPosition();
 	// Set the back up game as the edited saved game.
 	BackUpGame = SavedGame;
 	// Clear the saved game.
@@ -806,10 +1213,10 @@ void GameManager::UndoAnyNumberOfMoves(int Number)
 	if (!BackUpGame.empty())
 	{
 		// Use a lambda function to iterate through the back up game.
-		for_each(BackUpGame.begin(), BackUpGame.end(), [&](PossibleMove &TheMove)
+		for_each(BackUpGame.begin(), BackUpGame.end(), [&](PackedMove TheMove)
 		{
 			// Make each move as it was made.
-			SpecifiedMove(TheMove.OriginalX, TheMove.OriginalY, TheMove.MovedX, TheMove.MovedY, true);
+			SpecifiedMove(MoveFrom(TheMove) / 8, MoveFrom(TheMove) % 8, MoveTo(TheMove) / 8, MoveTo(TheMove) % 8, true);
 		});
 	}
 
@@ -819,23 +1226,23 @@ void GameManager::UndoAnyNumberOfMoves(int Number)
 void GameManager::SaveGame()
 {
 
-	// Create the text file to save the game to.
-	ofstream myFile("SavedGame.txt");
+	// Fill in the starting and current positions and the counters.
+	SaveFileHeader Header{};
+	FENPosition CurrentPosition;
+	GetPosition(CurrentPosition);
+	PackSavedPosition(StartingPosition, Header.StartingPosition);
+	PackSavedPosition(CurrentPosition, Header.CurrentPosition);
+	Header.GameTurnNumber = GameTurnNumber;
+	Header.CaptureCounter = CaptureCounter;
+	Header.PawnMoveCounter = PawnMoveCounter;
 
-	// If the file is open, enter this section.
-	if (myFile.is_open())
-	{
-		// Use a lambda function to iterate through the saved game.
-		for_each(SavedGame.begin(), SavedGame.end(), [&](PossibleMove &TheMove)
-		{
-			// Print each move to the file.
-			myFile << TheMove.OriginalX << " " << TheMove.OriginalY << " " << TheMove.MovedX << " " << TheMove.MovedY << endl;
-		});
-		// Close the file.
-		myFile.close();
-	}
-	// Otherwise print an error message.
-	else { cerr << "Error: Unable to open file for saving." << endl; }
+	// The moves of the game are already 16 bits each, so they are written as they are.
+	vector<uint16_t> Moves;
+	Moves.reserve(SavedGame.size());
+	for (PackedMove TheMove : SavedGame) { Moves.push_back(TheMove.Bits); }
+
+	// Write the file. If it can't be written, an error message is printed.
+	WriteSaveFile(SavedGameFile, Header, Moves);
 
 }
 
@@ -843,10 +1250,57 @@ void GameManager::SaveGame()
 void GameManager::LoadGame()
 {
 
-	// Set all the variables to zero.
-	GameTurnNumber = CaptureCounter = PawnMoveCounter = 0;
+	// If there is only a text file from an older version of the program, its moves have to be replayed.
+	if (!ifstream(SavedGameFile).good() && ifstream(TextSavedGameFile).good()) { LoadTextGame(TextSavedGameFile); return; }
+
+	// Read the file. If it is missing or corrupt, an error message is printed and the game is left alone.
+	SaveFileHeader Header;
+	vector<uint16_t> Moves;
+	if (!ReadSaveFile(SavedGameFile, Header, Moves)) { return; }
+	FENPosition FirstPosition, CurrentPosition;
+	UnpackSavedPosition(Header.StartingPosition, FirstPosition);
+	UnpackSavedPosition(Header.CurrentPosition, CurrentPosition);
+
+	// Rebuild the saved game and the log of moves, following the pieces on a copy of the starting piece codes.
+	// Only 64 bytes change per move, so this is far cheaper than replaying the moves on the board.
+	uint8_t Codes[64];
+	for (int Square = 0; Square < 64; Square++) { Codes[Square] = FirstPosition.Codes[Square]; }
+	vector<PackedMove> LoadedGame;
+	vector<LoggedMove> LoadedLog;
+	LoadedGame.reserve(Moves.size());
+	LoadedLog.reserve(Moves.size());
+	for (uint16_t Move : Moves)
+	{
+		// The flags are worked out again rather than trusted, since files written by older versions don't have them.
+		int From{ SavedMoveFrom(Move) }, To{ SavedMoveTo(Move) };
+		PackedMove TheMove{ PackMove(Codes, From, To) };
+		int Code{ ApplyMoveToCodes(Codes, From, To) };
+		if (Code == NoPieceCode) { cerr << "Error: Move " << LoadedGame.size() + 1 << " of " << SavedGameFile << " moves from an empty square." << endl; return; }
+		LoadedGame.push_back(TheMove);
+		LoadedLog.push_back({ TheMove, static_cast<uint8_t>(Code) });
+	}
+	if (!equal(Codes, Codes + 64, CurrentPosition.Codes)) { cerr << "Error: The moves in " << SavedGameFile << " don't lead to the saved position." << endl; return; }
+
+	// Everything checks out, so set up the current position directly.
+	StartingPosition = FirstPosition;
+	TheBoard->SetPosition(CurrentPosition);
+	GameTurnNumber = Header.GameTurnNumber;
+	CaptureCounter = Header.CaptureCounter;
+	PawnMoveCounter = Header.PawnMoveCounter;
+	SavedGame.swap(LoadedGame);
+	MoveLog.swap(LoadedLog);
+	UndoStack.clear();
+
+}
+
+// Function to load a game saved by older versions as a text file of moves.
+void GameManager::LoadTextGame(const string& FileName)
+{
+
+	// Go back to the starting position, with the variables reset.
+	ResetToStartingPosition();
 	// Find the saved game file.
-	ifstream theFile("SavedGame.txt");
+	ifstream theFile(FileName);
 	// Define a temporary move.
 	PossibleMove TemporaryMove;
 	// Clear the saved game vector (it should be empty already anyway) 
@@ -859,23 +1313,20 @@ void GameManager::LoadGame()
 		if (theFile.is_open())
 		{
 
-			// While we're not at the end of the file.
-			while (!theFile.eof())
+			// Read in each move, stopping at the end of the file.
+			vector<PossibleMove> TextMoves;
+			while (theFile >> TemporaryMove.OriginalX >> TemporaryMove.OriginalY >> TemporaryMove.MovedX >> TemporaryMove.MovedY)
 			{
-				// Read in the move and add it to the SavedGame vector.
-				theFile >> TemporaryMove.OriginalX >> TemporaryMove.OriginalY >> TemporaryMove.MovedX >> TemporaryMove.MovedY;
-				SavedGame.push_back(TemporaryMove);
+				TextMoves.push_back(TemporaryMove);
 			}
 			// Close the file
 			theFile.close();
-			// Delete the last element because it duplicates it.
-			SavedGame.pop_back();
 
-			// Use a lambda function to iterate through the saved game.
-			for_each(SavedGame.begin(), SavedGame.end(), [&](PossibleMove &TheMove)
+			// Use a lambda function to iterate through the moves, which adds each one to the SavedGame vector as it is made.
+			for_each(TextMoves.begin(), TextMoves.end(), [&](PossibleMove &TheMove)
 			{
 				// Make each move as it was made.
-				SpecifiedMove(TheMove.OriginalX, TheMove.OriginalY, TheMove.MovedX, TheMove.MovedY, false);
+				SpecifiedMove(TheMove.OriginalX, TheMove.OriginalY, TheMove.MovedX, TheMove.MovedY, true);
 			});
 		}
 		// Otherwise print an error message.
@@ -891,7 +1342,7 @@ PossibleMove GameManager::MinimaxMove(int Depth, bool Maximise)
 {
 
 	// Make sure the depth isn't less than or equal to zero.
-	if (Depth <= 0) { cout << "Error: Minimax depth cannot be zero." << endl; exit(1); }
+	if (Depth <= 0) { cout << "Error: Minimax depth cannot be zero.\nA depth of one is used instead." << endl; Depth = 1; }
 
 	// Define and set the colour.
 	string Colour;
@@ -901,23 +1352,23 @@ PossibleMove GameManager::MinimaxMove(int Depth, bool Maximise)
 	// Initialise the best score to a very large negative number.
 	double BestScore{ -9999 };
 	// Declare the best move.
-	PossibleMove BestMove;
+	PackedMove BestMove{ 0 };
 
 	// Get the vector of all possible moves.
-	vector<PossibleMove> GameMoves{ AllPossibleMoves(Colour) };
+	vector<PackedMove> GameMoves{ AllPossibleMoves(Colour) };
 	// Shuffle the vector to avoid the same moves being played.
 	random_shuffle(GameMoves.begin(), GameMoves.end());
 
 	// Iterate through the possible moves.
 	for (auto it = GameMoves.begin(); it != GameMoves.end(); it++)
 	{
-		PossibleMove TheMove = *it;
+		PackedMove TheMove = *it;
 		// Make the possible move.
-		SpecifiedMove(TheMove.OriginalX, TheMove.OriginalY, TheMove.MovedX, TheMove.MovedY, true);
+		MakeMove(TheMove);
 		// Use recursion to get the value of the state of the board.
 		double Value{ Minimax(Depth - 1, -10000, 10000, !Maximise) };
 		// Undo that last move.
-		UndoAnyNumberOfMoves(1);
+		UnmakeMove();
 		// If the value is better than or equal to the best score...
 		// then update the best score and also the best move.
 		if (Value >= BestScore)
@@ -927,22 +1378,147 @@ PossibleMove GameManager::MinimaxMove(int Depth, bool Maximise)
 		}
 	}
 
-	// Retun the best move that was found.
-	return BestMove;
+	// Retun the best move that was found, as coordinates for the user interface.
+	return ToPossibleMove(BestMove);
 
 };
 
+// Function to check the time and stop limits of the search.
+bool GameManager::SearchLimitReached()
+{
+	if (StopSignal && StopSignal->load(memory_order_relaxed)) { return true; }
+	return HasSearchDeadline && chrono::steady_clock::now() >= SearchDeadline;
+}
+
+// Access function for the number of nodes visited by the search.
+long long GameManager::GetNodeCount() const { return NodeCount; }
+
+// Function to search for the best move one depth at a time until a limit is reached.
+SearchResult GameManager::LimitedSearch(const SearchLimits& Limits, const atomic<bool>* Stop, const function<void(const SearchResult&)>& Report, const vector<PackedMove>& Excluded)
+{
+
+	// Set the limits. A time limit becomes a deadline so the search only has to compare clocks.
+	auto Start = chrono::steady_clock::now();
+	NodeCount = 0;
+	NodeLimit = Limits.Nodes;
+	HasSearchDeadline = Limits.Seconds > 0;
+	if (HasSearchDeadline) { SearchDeadline = Start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(Limits.Seconds)); }
+	StopSignal = Stop;
+	SearchStopped = false;
+
+	// The evaluation is from white's point of view, so white maximises it and black minimises it at every depth.
+	bool White{ GameTurnNumber % 2 == 0 };
+	MaximiseBoardEvaluation = true;
+
+	// Get the moves of the side to move. They are ordered once here, and after that by the previous depth's best move.
+	vector<PackedMove> GameMoves{ AllPossibleMoves(White ? "White" : "Black") };
+	if (!Excluded.empty()) { GameMoves.erase(remove_if(GameMoves.begin(), GameMoves.end(), [&](PackedMove TheMove) { return find(Excluded.begin(), Excluded.end(), TheMove) != Excluded.end(); }), GameMoves.end()); }
+	SearchResult Result{ {0}, 0.0, 0, 0, 0.0 };
+	if (GameMoves.empty()) { return Result; }
+	OrderMoves(GameMoves, White);
+	Result.Move = GameMoves.front();
+
+	for (int Depth = 1; Limits.Depth <= 0 || Depth <= Limits.Depth; Depth++)
+	{
+		// Search every move with an alpha-beta window that narrows as better moves are found.
+		double Alpha{ -10000 }, Beta{ 10000 }, BestScore{ White ? -10000.0 : 10000.0 };
+		size_t Best{ 0 }, Searched{ 0 };
+		for (size_t i = 0; i < GameMoves.size(); i++)
+		{
+			MakeMove(GameMoves[i]);
+			double Value{ Minimax(Depth - 1, Alpha, Beta, !White) };
+			UnmakeMove();
+			if (SearchStopped) { break; }
+			Searched++;
+			if (White ? Value > BestScore : Value < BestScore) { BestScore = Value; Best = i; }
+			if (White) { Alpha = max(Alpha, BestScore); }
+			else { Beta = min(Beta, BestScore); }
+		}
+
+		// Keep the depth if it finished. If even the first depth didn't, the best of the moves it searched is better than nothing.
+		if (SearchStopped && (Depth > 1 || Searched == 0)) { break; }
+		rotate(GameMoves.begin(), GameMoves.begin() + Best, GameMoves.begin() + Best + 1);
+		Result.Move = GameMoves.front();
+		Result.Score = BestScore;
+		Result.Depth = Depth;
+		Result.Nodes = NodeCount;
+		Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+		if (Report) { Report(Result); }
+
+		// Stop once a mate has been found, or if the next depth has no chance of finishing in the time that is left.
+		if (SearchStopped || fabs(BestScore) >= MateScore) { break; }
+		if (HasSearchDeadline && Result.Seconds > Limits.Seconds / 2) { break; }
+	}
+
+	// Take the limits off again, so the other searches aren't affected.
+	Result.Nodes = NodeCount;
+	Result.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	NodeLimit = 0;
+	HasSearchDeadline = false;
+	StopSignal = nullptr;
+	SearchStopped = false;
+	return Result;
+
+}
+
+// Function to put the moves most likely to cause an alpha-beta cut-off first.
+void GameManager::OrderMoves(vector<PackedMove>& Moves, bool White)
+{
+
+	// If move ordering has been switched off, leave the moves in the order they were generated (or shuffled) in.
+	if (!MoveOrdering) { return; }
+
+	// The attack maps are the same ones the evaluation reads, so they are only built once for this position.
+	const AttackMaps& Maps{ TheBoard->GetAttackMaps() };
+	const uint8_t* Codes{ TheBoard->GetPieceCodes() };
+	int Own{ White ? WhiteSide : BlackSide }, Enemy{ White ? BlackSide : WhiteSide };
+	Bitboard EnemyPawnAttacks{ Maps.GetAttacksBy(White ? BlackPawnCode : WhitePawnCode) };
+
+	// Score every move. The piece types run from pawn (0) to king (5), so they double as a rough value.
+	vector<pair<int, PackedMove>> Scored;
+	Scored.reserve(Moves.size());
+	for (PackedMove TheMove : Moves)
+	{
+		int From{ MoveFrom(TheMove) }, To{ MoveTo(TheMove) };
+		int Moving{ (Codes[From] - 1) % 6 }, Score{ 0 };
+		if (Codes[To] != NoPieceCode)
+		{
+			// Most valuable victim first, and of those the least valuable attacker first.
+			Score = 1000 + 10 * ((Codes[To] - 1) % 6) - Moving;
+		}
+		else
+		{
+			// A piece that is attacked and either undefended or attacked by something cheaper should move.
+			int Attacker{ Maps.LeastValuableAttacker(From, Enemy) };
+			if (Attacker != NoPieceCode && (!Maps.IsAttacked(From, Own) || (Attacker - 1) % 6 < Moving)) { Score += 50; }
+			// Moving a piece where an enemy pawn can take it is usually bad.
+			if (Moving != PawnType && ((EnemyPawnAttacks >> To) & 1)) { Score -= 50; }
+		}
+		Scored.emplace_back(Score, TheMove);
+	}
+
+	// Sort with the highest scores first. The sort is stable, so moves with equal scores keep their shuffled order.
+	stable_sort(Scored.begin(), Scored.end(), [](const pair<int, PackedMove>& a, const pair<int, PackedMove>& b) { return a.first > b.first; });
+	for (size_t i = 0; i < Moves.size(); i++) { Moves[i] = Scored[i].second; }
+
+}
+
 // Function to return the minimax value of a chessboard.
 double GameManager::Minimax(int Depth, double Alpha, double Beta, bool Maximise)
 {
 
+	// Count the node. If a limit has been reached the value doesn't matter, because the unfinished search is thrown away.
+	// The clock and the stop flag are only checked every 256 nodes, as reading them costs more than a node's bookkeeping.
+	NodeCount++;
+	if (SearchStopped) { return 0; }
+	if ((NodeLimit > 0 && NodeCount >= NodeLimit) || ((NodeCount & 255) == 0 && SearchLimitReached())) { SearchStopped = true; return 0; }
+
 	// If the depth is equal to zero then evaluate the state of the board.
 	// This provides the condition to ensure recursion doesn't go on forever.
 	if (Depth == 0)
 	{
-		// White wants to maximise the board, whilst black want to minimise.
-		if (GetMaxBoardEval()) { return  TheBoard->EvaluateBoard(); }
-		else { return -TheBoard->EvaluateBoard(); }
+		// White wants to maximise the board, whilst black want to minimise (LazyEvaluation handles the sign).
+		return LazyEvaluation(Alpha, Beta);
 	}
 
 	// Define and set the colour.
@@ -950,10 +1526,12 @@ double GameManager::Minimax(int Depth, double Alpha, double Beta, bool Maximise)
 	if (Maximise) { Colour = "White"; }
 	else { Colour = "Black"; }
 
-	// Get the vector of all possible moves.
-	vector<PossibleMove> GameMoves{ AllPossibleMoves(Colour) };
-	// Shuffle the vector to avoid the same moves being played.
+	// Get the vector of all possible moves. If there are none the side to move is mated, sooner the more depth is left.
+	vector<PackedMove> GameMoves{ AllPossibleMoves(Colour) };
+	if (GameMoves.empty()) { return Maximise ? -(MateScore + Depth) : MateScore + Depth; }
+	// Shuffle the vector to avoid the same moves being played, then try the most promising moves first.
 	random_shuffle(GameMoves.begin(), GameMoves.end());
+	OrderMoves(GameMoves, Maximise);
 
 	if (Maximise)
 	{
@@ -962,13 +1540,13 @@ double GameManager::Minimax(int Depth, double Alpha, double Beta, bool Maximise)
 		// Iterate through the possible moves.
 		for (auto it = GameMoves.begin(); it != GameMoves.end(); it++)
 		{
-			PossibleMove TheMove = *it;
+			PackedMove TheMove = *it;
 			// Make the move.
-			SpecifiedMove(TheMove.OriginalX, TheMove.OriginalY, TheMove.MovedX, TheMove.MovedY, true);
+			MakeMove(TheMove);
 			// Maximise the best move value.
 			BestMove = max(BestMove, Minimax(Depth - 1, Alpha, Beta, !Maximise));
 			// Undo that last move.
-			UndoAnyNumberOfMoves(1);
+			UnmakeMove();
 			// Use alpha-beta pruning to skip over pointless recursions.
 			Alpha = max(Alpha, BestMove);
 			if (Beta <= Alpha) { return BestMove; }
@@ -983,13 +1561,13 @@ double GameManager::Minimax(int Depth, double Alpha, double Beta, bool Maximise)
 		// Iterate through the possible moves.
 		for (auto it = GameMoves.begin(); it != GameMoves.end(); it++)
 		{
-			PossibleMove TheMove = *it;
+			PackedMove TheMove = *it;
 			// Make the move.
-			SpecifiedMove(TheMove.OriginalX, TheMove.OriginalY, TheMove.MovedX, TheMove.MovedY, true);
+			MakeMove(TheMove);
 			// Minimise the best move value.
 			BestMove = min(BestMove, Minimax(Depth - 1, Alpha, Beta, !Maximise));
 			// Undo that last move.
-			UndoAnyNumberOfMoves(1);
+			UnmakeMove();
 			// Use alpha-beta pruning to skip over pointless recursions.
 			Beta = min(Beta, BestMove);
 			if (Beta <= Alpha) { return BestMove; }
@@ -13,34 +13,49 @@
 #include <time.h>
 #include <ctime>
 #include <chrono>
+#include <cmath>
 #include <map>
 #include <fstream>
 #include <random>
 #include <iterator>
 #include <algorithm>
 #include <thread>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <sstream>
 #include "Board.h"
+#include "SaveFile.h"
+#include "MoveGenerator.h"
+#include "Pgn.h"
+#include "OpeningBook.h"
+#include "Input.h"
 
 // Using namespaces.
 using namespace BoardNamespace;
+using namespace SaveNamespace;
+using namespace GeneratorNamespace;
+using namespace PgnNamespace;
+using namespace BookNamespace;
+using namespace InputNamespace;
 
 // Using a namespace to avoid name collisions.
 namespace GameNamespace
 {
 
-	// A template function to return a choice of four acceptable values; a, b, c, and d.
+	// A template function to read a choice of four acceptable values; a, b, c, and d, from the start of a line the user typed.
 	// The fact that it's a template function means the acceptable values could be either integers or chars for example.
 	// The template function is unusually (but correctly) declared in the header file.
-	template <class T> T GoodInput(T a, T b, T c, T d)
+	// Returns true with the choice in Choice, or prints an error message asking the user to try again and returns false.
+	template <class T> bool GoodInput(const string& Line, T a, T b, T c, T d, T& Choice)
 	{
 
-		// An input of type T is declared.
-		T Input;
-		// The user enters this input.
-		cin >> Input;
+		// An input of type T is declared, and read from the start of the line. Whatever else was on the line is ignored.
+		T Input{};
+		istringstream(Line) >> Input;
 
 		// The input is checked against the acceptable values.
-		while (toupper(Input) != a && toupper(Input) != b && toupper(Input) != c && toupper(Input) != d)
+		if (toupper(Input) != a && toupper(Input) != b && toupper(Input) != c && toupper(Input) != d)
 		{
 			// If it was a yes/no question, print this output.
 			if (a == 'Y' && b == 'Y' && c == 'N' && d == 'N')
@@ -52,26 +67,96 @@ namespace GameNamespace
 			{
 				cerr << "Error: Did not recognise input.\nPlease try again: ";
 			}
-
-			// Clear the error state.
-			cin.clear();
-			// Ignore whatever the user typed.
-			cin.ignore((numeric_limits<streamsize>::max)(), '\n');;
-			// Allow the user to try again.
-			cin >> Input;
-
+			return false;
 		}
 
-		// Clear the input buffer.
-		cin.ignore((numeric_limits<streamsize>::max)(), '\n');
 		// Return the good input.
-		return toupper(Input);
+		Choice = static_cast<T>(toupper(Input));
+		return true;
 
 	}
 
 	// Define a PossibleMove variable with four integers describing it.
+	// This is how the user interface describes a move. Everything else uses the 16-bit PackedMove below.
 	struct PossibleMove { int OriginalX, OriginalY, MovedX, MovedY; };
 
+	// A move packed into 16 bits, which is what the move lists, the undo stack, the saved game and the log of moves hold.
+	// The square moved from (8 * x + y) is in the low six bits and the square moved to in the next six, as in save files and
+	// PackPositionMove. The next two bits are the promotion piece, which is always zero (a queen) since the board only promotes to one.
+	// The top two bits are flags: the move captures, and the move is special (castling, en passant or a promotion).
+	struct PackedMove { uint16_t Bits; };
+	const uint16_t CaptureFlag{ 1 << 14 }, SpecialMoveFlag{ 1 << 15 };
+
+	// Functions to pack a move and read it back.
+	inline PackedMove PackMove(int From, int To, int Flags = 0) { return { static_cast<uint16_t>((From & 63) | ((To & 63) << 6) | Flags) }; }
+	inline int  MoveFrom(PackedMove Move)        { return Move.Bits & 63; }
+	inline int  MoveTo(PackedMove Move)          { return (Move.Bits >> 6) & 63; }
+	inline bool IsCaptureMove(PackedMove Move)   { return (Move.Bits & CaptureFlag) != 0; }
+	inline bool IsSpecialMove(PackedMove Move)   { return (Move.Bits & SpecialMoveFlag) != 0; }
+	inline bool operator==(PackedMove a, PackedMove b) { return a.Bits == b.Bits; }
+	inline bool operator!=(PackedMove a, PackedMove b) { return a.Bits != b.Bits; }
+
+	// Function to pack a move with its flags, which are worked out from the piece codes of the position it is made in.
+	PackedMove PackMove(const uint8_t Codes[64], int From, int To);
+
+	// Functions to convert between a packed move and the user interface's coordinates. Coordinates have no flags, so they are lost.
+	inline PossibleMove ToPossibleMove(PackedMove Move) { return { MoveFrom(Move) / 8, MoveFrom(Move) % 8, MoveTo(Move) / 8, MoveTo(Move) % 8 }; }
+	inline PackedMove ToPackedMove(const PossibleMove& Move) { return PackMove(8 * Move.OriginalX + Move.OriginalY, 8 * Move.MovedX + Move.MovedY); }
+
+	// A move as it is kept in the log of the game: the move and the code of the piece that moved.
+	// The log is only turned into text when it is printed, so making a move never builds a string.
+	struct LoggedMove { PackedMove Move; uint8_t Piece; };
+
+	// The ways the list of moves can be printed: as sentences, in standard algebraic notation, or as coordinates (e.g. "e2e4").
+	enum MoveNotation { ProseNotation, AlgebraicNotation, CoordinateNotation };
+
+	// Everything needed to take back a move made with MakeMove.
+	struct UndoRecord {
+		// The move, and the pieces the board recorded when it was made.
+		PackedMove Move;
+		shared_ptr<Piece> MovedPiece, CapturedPiece, EnPassantPiece, PromotedPawn;
+		// The square of the piece that had moved last before this move, or -1 if there was none.
+		int PreviousLastSquare;
+		// The counters before the move.
+		int CaptureCounter, PawnMoveCounter;
+	};
+
+	// The limits of a search by LimitedSearch. A limit of zero (or less) means there is no limit of that kind.
+	struct SearchLimits { int Depth; long long Nodes; double Seconds; };
+
+	// The result of a search by LimitedSearch: the best move, its score from white's point of view, the deepest depth finished,
+	// and the nodes searched and seconds taken so far. A depth of zero means no depth finished. The move is then the first of the
+	// ordered moves, or all zero bits if there was no move to find.
+	struct SearchResult { PackedMove Move; double Score; int Depth; long long Nodes; double Seconds; };
+
+	// A mate found with N plies of the search still to go scores MateScore + N (negated if white is mated), so nearer mates score
+	// higher. Any score at least MateScore from zero is a mate.
+	const int MateScore{ 9000 };
+
+	// Function to return the number of moves to the mate behind a score, given from the point of view of the side to move by a
+	// search of the given depth. It is negative if the side to move is the one mated.
+	inline int MateInMoves(double Score, int Depth)
+	{
+		int Plies{ Depth - static_cast<int>(lround(fabs(Score))) + MateScore };
+		return Score > 0 ? (Plies + 1) / 2 : -(Plies / 2);
+	}
+
+	// The evaluation functions that the computer can use.
+	enum EvaluationType { ClassicEvaluation, NeuralEvaluation };
+
+	// A snapshot of a game: the position, the counters and the settings the search uses. It holds no pointers, so copying it
+	// is copying about a hundred bytes, and a copy can be handed to another thread and set up on that thread's own game.
+	// The moves that led to the position aren't included.
+	struct GameState {
+		FENPosition Position;
+		int GameTurnNumber, CaptureCounter, PawnMoveCounter;
+		bool MaximiseBoardEvaluation;
+		EvaluationType Evaluator;
+		double LazyEvaluationMargin;
+		bool MoveOrdering;
+	};
+	static_assert(is_trivially_copyable<GameState>::value, "A game state must be copyable as plain bytes.");
+
 	// GameManager class.
 	class GameManager {
 
@@ -80,14 +165,50 @@ namespace GameNamespace
 
 		// The chessboard.
 		Board *TheBoard;
-		// A multimap of the list of moves.
-		multimap<int, string> ListOfMoves;
-		// A vector of possible moves representing the game.
-		vector<PossibleMove> SavedGame;
+		// The log of the moves made in the game.
+		vector<LoggedMove> MoveLog;
+		// A vector of the moves of the game.
+		vector<PackedMove> SavedGame;
 		// Integers to keep track of how the game develops.
 		int GameTurnNumber, CaptureCounter, PawnMoveCounter, GameType;
 		// Bool that determines if we want to maximise the board evaluation or not.
 		bool MaximiseBoardEvaluation;
+		// The moves made with MakeMove that can still be taken back.
+		vector<UndoRecord> UndoStack;
+		// The evaluation function used by the minimax search, and the neural network if one has been loaded.
+		EvaluationType Evaluator;
+		shared_ptr<NeuralNetwork> Network;
+		// Lazy evaluation: if the cheap evaluation is further than this margin outside the alpha-beta window,
+		// the expensive terms are skipped. A negative margin switches lazy evaluation off.
+		double LazyEvaluationMargin;
+		// Whether the search tries the most promising moves first. Switching it off only changes the search speed, not its scores.
+		bool MoveOrdering;
+		// Counters of leaf evaluations, and of those that exited early.
+		long long LazyEvaluationCalls, LazyEvaluationExits;
+		// The nodes the search has visited, and the limits LimitedSearch stops it at: a number of nodes, a deadline
+		// and a flag another thread can set. Once any is reached SearchStopped is set and the search unwinds.
+		long long NodeCount, NodeLimit;
+		chrono::steady_clock::time_point SearchDeadline;
+		bool HasSearchDeadline, SearchStopped;
+		const atomic<bool>* StopSignal;
+		// Function to check the limits of the search, which is done every so many nodes.
+		bool SearchLimitReached();
+		// The position the game started from. Undoing moves and loading a game replay the saved game from here.
+		FENPosition StartingPosition;
+
+		// Function to put the board and counters back to the starting position, with no moves made.
+		void ResetToStartingPosition();
+
+		// Function to add a move to the log, before it is made. Returns the code of the piece that is moving.
+		int LogMove(int OldX, int OldY, int NewX, int NewY);
+
+		// Function to load a game saved by older versions as a text file of moves, by replaying them.
+		void LoadTextGame(const string& FileName);
+
+		// The move the user is entering: when they started, which of the four coordinates is asked for next, and those already given.
+		chrono::system_clock::time_point HumanMoveStart;
+		int HumanMoveField;
+		int HumanMoveInput[4];
 
 	// Public member functions.
 	public:
@@ -99,18 +220,50 @@ namespace GameNamespace
 		// Destructor.
 		~GameManager() {}
 
+		// A game can't be copied, as the copy would share the board and its pieces. Use GetState or CloneFrom instead.
+		GameManager(const GameManager&) = delete;
+		GameManager& operator=(const GameManager&) = delete;
+
 		// Access function.
 		int  GetGameTurnNumber() const;
 		bool GetMaxBoardEval()   const;
 
+		// Mutator function for the side the search is maximising (true for white).
+		void SetMaxBoardEval(bool TrueOrFalse);
+
+		// Functions to start the game from any position, without replaying the moves that led to it.
+		// The string version returns false, and leaves the game alone, if the FEN string can't be read.
+		bool SetPositionFromFEN(const string& FEN);
+		void SetPosition(const FENPosition& Position);
+
+		// Functions to return the current position, including the side to move and the move counters.
+		void GetPosition(FENPosition& Position) const;
+		string GetFEN() const;
+
+		// Functions to take a snapshot of the game and to set the game up from one. Setting up from a snapshot starts the game
+		// again from its position. The neural evaluation is only taken if this game has a network loaded.
+		GameState GetState() const;
+		void SetState(const GameState& State);
+
+		// Function to make this game a copy of another on its own board: the same moves, position and settings, and the same network,
+		// which is only ever read. Nothing that changes is shared, so the two games can be used on different threads.
+		// Moves made with MakeMove that haven't been taken back can't be taken back on the copy.
+		void CloneFrom(const GameManager& Source);
+
 		// Function to inform the user that a pawn has been promoted.
 		void PrintPawnPromotion();
 
-		// Function to print the list of moves that have happened in the game.
-		void PrintList();
+		// Function to print the list of moves that have happened in the game, and save it to a file.
+		void PrintList(MoveNotation Notation = ProseNotation);
+
+		// Function to write the game to a PGN file, so it can be read by other chess programs.
+		void ExportPgn(const string& FileName) const;
 
-		// Function to make a human move.
-		void HumanMove();
+		// Functions to make a human move, a line the user types at a time. BeginHumanMove says whose turn it is and asks for the first
+		// coordinate, and AnswerHumanMove takes each answer and asks for the next. It returns true once the move has been made;
+		// an invalid move is reported and asked for again.
+		void BeginHumanMove();
+		bool AnswerHumanMove(const string& Line);
 
 		// Function to make a computer move.
 		void ComputerMove(bool IntelligentTrueRandomFalse);
@@ -118,17 +271,61 @@ namespace GameNamespace
 		// Function to make a specified move.
 		void SpecifiedMove(int OldX, int OldY, int NewX, int NewY, bool Save);
 
-		// Function to give the user a choice of game modes.
-		int  GameModeSelection();
+		// Functions to make a move and take it back again without replaying the game.
+		// These are used by the search, so nothing is added to the list of moves or the saved game.
+		void MakeMove(PackedMove TheMove);
+		void MakeMove(const PossibleMove& TheMove);
+		void UnmakeMove();
+
+		// The questions asked before a game, each in two halves: a function to ask it, and one to take the user's answer.
+		// An answer function returns false, having asked the user to try again, if the answer wasn't one of the choices.
+
+		// Functions to give the user a choice of game modes.
+		void AskGameMode();
+		bool AnswerGameMode(const string& Line, int& Mode);
+
+		// Functions to give the user a choice to load a saved game.
+		void AskLoadGame();
+		bool AnswerLoadGame(const string& Line);
+
+		// Functions to give the user a choice of evaluation function. It is only asked if a neural network file is available,
+		// and AskEvaluator returns false if there isn't one.
+		bool AskEvaluator();
+		bool AnswerEvaluator(const string& Line);
+
+		// Function to load a neural network from a file. Returns false if it couldn't be loaded.
+		bool LoadNeuralNetwork(const string& FileName);
+
+		// Access and mutator functions for the evaluation function.
+		EvaluationType GetEvaluator() const;
+		void SetEvaluator(EvaluationType NewEvaluator);
+
+		// Function to return the evaluation of the current position from white's point of view.
+		double EvaluatePosition();
+
+		// Function to return the leaf evaluation used by the minimax search, from the point of view of the side being maximised.
+		// The cheap evaluation is returned straight away if it is far enough outside the (Alpha, Beta) window.
+		double LazyEvaluation(double Alpha, double Beta);
+
+		// Access and mutator functions for the lazy evaluation.
+		double GetLazyEvaluationMargin() const;
+		void SetLazyEvaluationMargin(double Margin);
+		long long GetLazyEvaluationCalls() const;
+		long long GetLazyEvaluationExits() const;
+		void ResetLazyEvaluationCounters();
 
-		// Function to give the user a choice to load a saved game.
-		void LoadGameSelection();
+		// Access and mutator functions for the move ordering.
+		bool GetMoveOrdering() const;
+		void SetMoveOrdering(bool Ordering);
 
-		// Function to give the user options before making a move.
-		void BeginOptionMenu();
+		// Functions to give the user options before making a move. The option chosen is acted on, apart from [Q]uit,
+		// which is left to whoever is running the game.
+		void AskBeginOption();
+		bool AnswerBeginOption(const string& Line, char& Option);
 
-		// Function to give the user options after  making a move.
-		void EndOptionMenu();
+		// Functions to give the user options after making a move, in the same way.
+		void AskEndOption();
+		bool AnswerEndOption(const string& Line, char& Option);
 
 		// Function to print all the allowed moves.
 		void PrintAllowedMoves(string Colour);
@@ -137,7 +334,9 @@ namespace GameNamespace
 		int  NumberOfAllowedMoves(string Colour);
 
 		// Function to return a vector of all the allowed moves.
-		vector<PossibleMove> AllPossibleMoves(string Colour);
+		vector<PackedMove> AllPossibleMoves(string Colour);
+		// Function to pack a move on the board as it is now, with its flags. It must be called before the move is made.
+		PackedMove PackBoardMove(int OldX, int OldY, int NewX, int NewY) const;
 
 		// Function to see if the king is in check mate.
 		bool KingInCheckMate(string Colour);
@@ -158,6 +357,7 @@ namespace GameNamespace
 		void UndoAnyNumberOfMoves(int Number);
 
 		// Function to save the current game.
+		// The current position is saved with the moves, so the game can be loaded without replaying them.
 		void SaveGame();
 
 		// Function to load a saved game.
@@ -168,6 +368,17 @@ namespace GameNamespace
 
 		// Function to return the minimax value of a chessboard.
 		double Minimax(int Depth, double Alpha, double Beta, bool Maximise);
+		// Function to search for the side to move's best move one depth at a time, until a depth, node or time limit is reached
+		// or Stop is set. The best move of each finished depth is searched first at the next, and passed to Report if it is given.
+		// An unfinished depth is thrown away, so the result is always the best move of the deepest finished depth.
+		// Moves in Excluded aren't searched, which is how the second best move and those after it are found.
+		SearchResult LimitedSearch(const SearchLimits& Limits, const atomic<bool>* Stop = nullptr, const function<void(const SearchResult&)>& Report = nullptr, const vector<PackedMove>& Excluded = {});
+		// Access function for the number of nodes visited by the search.
+		long long GetNodeCount() const;
+
+		// Function to put the moves most likely to cause an alpha-beta cut-off first, using the board's attack maps:
+		// captures of valuable pieces by cheap ones, then pieces escaping an attack, and moves onto squares enemy pawns attack last.
+		void OrderMoves(vector<PackedMove>& Moves, bool White);
 
 	};
 
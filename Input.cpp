@@ -0,0 +1,97 @@
+// OOP Chess Project: Input.cpp.
+// This is the input source file.
+// It contains all the definitions related to reading what the user types.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Input.h"
+
+// Using namespaces.
+using namespace InputNamespace;
+
+// The queue of lines. The reader thread only writes Tail and the game only writes Head, so each sees the other's lines
+// through the release and acquire of those counters. The counters only go up, and a line's slot is its count modulo the length.
+// The lock is only for sleeping: a side waits on a condition with it, and the other side takes it before waking it up.
+struct LineQueue {
+	string Lines[InputQueueLength];
+	atomic<size_t> Head, Tail;
+	atomic<bool> Ended;
+	mutex Lock;
+	condition_variable LineAdded, SlotFreed;
+};
+static LineQueue Queue{ {}, { 0 }, { 0 }, { false }, {}, {}, {} };
+
+// Function to wake up the other side. Taking the lock first means the wake-up can't be lost between its check and its wait.
+static void Wake(condition_variable& Condition)
+{
+	{ lock_guard<mutex> Guard(Queue.Lock); }
+	Condition.notify_one();
+}
+
+// Function to read the standard input into the queue until it ends.
+static void ReadLines()
+{
+	string Line;
+	while (getline(cin, Line))
+	{
+		// Sleep while the queue is full, then put the line in the next slot and wake the game.
+		size_t Tail{ Queue.Tail.load(memory_order_relaxed) };
+		if (Tail - Queue.Head.load(memory_order_acquire) == InputQueueLength)
+		{
+			unique_lock<mutex> Lock(Queue.Lock);
+			Queue.SlotFreed.wait(Lock, [Tail]() { return Tail - Queue.Head.load(memory_order_acquire) < InputQueueLength; });
+		}
+		Queue.Lines[Tail % InputQueueLength] = move(Line);
+		Queue.Tail.store(Tail + 1, memory_order_release);
+		Wake(Queue.LineAdded);
+	}
+	Queue.Ended.store(true, memory_order_release);
+	Wake(Queue.LineAdded);
+}
+
+// Function to start the reader thread the first time it is needed. It is left to run on its own, as a thread waiting for the
+// standard input can't be woken up, and it ends with the program.
+static void StartReader()
+{
+	static once_flag Started;
+	call_once(Started, []() { thread(ReadLines).detach(); });
+}
+
+// Function to take the next line typed, without waiting.
+bool InputNamespace::TryReadInputLine(string& Line)
+{
+	StartReader();
+	size_t Head{ Queue.Head.load(memory_order_relaxed) };
+	if (Head == Queue.Tail.load(memory_order_acquire)) { return false; }
+	Line = move(Queue.Lines[Head % InputQueueLength]);
+	Queue.Head.store(Head + 1, memory_order_release);
+	Wake(Queue.SlotFreed);
+	return true;
+}
+
+// Function to wait for the next line typed.
+bool InputNamespace::ReadInputLine(string& Line, const function<bool()>& WhileWaiting)
+{
+	while (!TryReadInputLine(Line))
+	{
+		if (InputEnded()) { return false; }
+		// Only keep polling while there is other work to do. Otherwise sleep until the reader thread adds a line or the input ends.
+		if (WhileWaiting && WhileWaiting()) { continue; }
+		unique_lock<mutex> Lock(Queue.Lock);
+		Queue.LineAdded.wait(Lock, []() { return Queue.Head.load(memory_order_relaxed) != Queue.Tail.load(memory_order_acquire) || Queue.Ended.load(memory_order_acquire); });
+	}
+	return true;
+}
+
+// Function to return whether the input has ended and every line has been taken.
+// The flag is read first: once it is set, every line the reader thread put in the queue can be seen.
+bool InputNamespace::InputEnded()
+{
+	if (!Queue.Ended.load(memory_order_acquire)) { return false; }
+	return Queue.Head.load(memory_order_relaxed) == Queue.Tail.load(memory_order_acquire);
+}
\ No newline at end of file
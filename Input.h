@@ -0,0 +1,45 @@
+// OOP Chess Project: Input.h.
+// This is the input header file.
+// It contains the declarations of the functions that read what the user types, on a thread of their own.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Input
+#define MY_CLASS_Input
+
+// Include the relevant libraries.
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace InputNamespace
+{
+
+	// The standard input is read a line at a time by a reader thread, which puts the lines in a queue for the game to take.
+	// The queue has one writer and one reader, so the lines need no lock. A side that has to wait (the game for a line, or the
+	// reader thread for room) sleeps until the other side wakes it. Waiting for a line never holds up anything else the program
+	// does, and the game can keep working (thinking on the user's time, say) until the user has typed something.
+	// Nothing else may read the standard input once the reader thread has started, which it does the first time a line is asked for.
+
+	// The number of lines the queue holds. The reader thread sleeps while it is full.
+	const size_t InputQueueLength{ 256 };
+
+	// Function to take the next line typed, without waiting. Returns false if there isn't one yet.
+	bool TryReadInputLine(string& Line);
+
+	// Function to wait for the next line typed. WhileWaiting (if there is one) is called over and over for as long as it returns
+	// true, meaning it has more work to do. After that, the game sleeps until a line comes. Returns false if the input has ended
+	// and every line has been taken.
+	bool ReadInputLine(string& Line, const function<bool()>& WhileWaiting = nullptr);
+
+	// Function to return whether the input has ended and every line has been taken.
+	bool InputEnded();
+
+}
+
+#endif
\ No newline at end of file
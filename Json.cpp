@@ -0,0 +1,138 @@
+// OOP Chess Project: Json.cpp.
+// This is the JSON source file.
+// It contains the definitions of the JSON helpers.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iomanip>
+#include <cmath>
+#include <cstring>
+#include "Json.h"
+#include "GameManager.h"
+
+// Function to write a string as JSON.
+void JsonNamespace::WriteJsonString(ostream& Output, const string& Text)
+{
+	Output << '"';
+	for (char Character : Text)
+	{
+		if (Character == '"' || Character == '\\') { Output << '\\' << Character; }
+		else if (static_cast<unsigned char>(Character) < 0x20) { Output << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(Character) << dec << setfill(' '); }
+		else { Output << Character; }
+	}
+	Output << '"';
+}
+
+// Function to write a score as JSON.
+void JsonNamespace::WriteJsonScore(ostream& Output, double Score, int Depth)
+{
+	if (fabs(Score) >= GameNamespace::MateScore) { Output << "\"mate\":" << GameNamespace::MateInMoves(Score, Depth); }
+	else { Output << "\"score\":" << lround(10 * Score); }
+}
+
+// Function to read a JSON string starting at its opening quote, leaving Position after the closing one.
+static bool ReadJsonString(const string& Text, size_t& Position, string& Value)
+{
+	Value.clear();
+	for (Position++; Position < Text.size(); Position++)
+	{
+		char Character{ Text[Position] };
+		if (Character == '"') { Position++; return true; }
+		if (static_cast<unsigned char>(Character) < 0x20) { return false; }
+		if (Character != '\\') { Value += Character; continue; }
+		if (++Position >= Text.size()) { return false; }
+		switch (Text[Position])
+		{
+		case '"': case '\\': case '/': Value += Text[Position]; break;
+		case 'b': Value += '\b'; break;
+		case 'f': Value += '\f'; break;
+		case 'n': Value += '\n'; break;
+		case 'r': Value += '\r'; break;
+		case 't': Value += '\t'; break;
+		case 'u':
+		{
+			// A character code, written out in UTF-8. Surrogate pairs are left as they are, as nothing a request holds needs them.
+			if (Position + 4 >= Text.size()) { return false; }
+			unsigned Code{ 0 };
+			for (int i = 1; i <= 4; i++)
+			{
+				char Digit{ static_cast<char>(tolower(Text[Position + i])) };
+				if (!isxdigit(static_cast<unsigned char>(Digit))) { return false; }
+				Code = 16 * Code + static_cast<unsigned>(Digit <= '9' ? Digit - '0' : Digit - 'a' + 10);
+			}
+			Position += 4;
+			if (Code < 0x80) { Value += static_cast<char>(Code); }
+			else if (Code < 0x800) { Value += static_cast<char>(0xC0 | (Code >> 6)); Value += static_cast<char>(0x80 | (Code & 0x3F)); }
+			else { Value += static_cast<char>(0xE0 | (Code >> 12)); Value += static_cast<char>(0x80 | ((Code >> 6) & 0x3F)); Value += static_cast<char>(0x80 | (Code & 0x3F)); }
+			break;
+		}
+		default: return false;
+		}
+	}
+	return false;
+}
+
+// Function to read a JSON object whose values are all strings, numbers, true, false or null.
+bool JsonNamespace::ReadFlatJsonObject(const string& Text, vector<JsonField>& Fields, string& Error)
+{
+
+	Fields.clear();
+	size_t Position{ 0 };
+	auto SkipSpace = [&]() { while (Position < Text.size() && isspace(static_cast<unsigned char>(Text[Position]))) { Position++; } };
+	auto Fail = [&](const string& Problem) { Error = Problem + " at character " + to_string(Position + 1); return false; };
+
+	SkipSpace();
+	if (Position >= Text.size() || Text[Position] != '{') { return Fail("Expected an object"); }
+	Position++;
+	SkipSpace();
+	bool Empty{ Position < Text.size() && Text[Position] == '}' };
+	if (Empty) { Position++; }
+	while (!Empty)
+	{
+		// A name in quotes, a colon, and a value.
+		JsonField Field;
+		SkipSpace();
+		if (Position >= Text.size() || Text[Position] != '"' || !ReadJsonString(Text, Position, Field.Name)) { return Fail("Expected a name in quotes"); }
+		SkipSpace();
+		if (Position >= Text.size() || Text[Position] != ':') { return Fail("Expected ':'"); }
+		Position++;
+		SkipSpace();
+		if (Position >= Text.size()) { return Fail("Expected a value"); }
+		Field.IsString = Text[Position] == '"';
+		if (Field.IsString)
+		{
+			if (!ReadJsonString(Text, Position, Field.Value)) { return Fail("Expected a string"); }
+		}
+		else
+		{
+			// A number or a word runs until the next comma, brace or space, and is checked against what JSON allows.
+			size_t End{ Text.find_first_of(",} \t\r\n", Position) };
+			Field.Value = Text.substr(Position, End == string::npos ? string::npos : End - Position);
+			if (Field.Value.empty() || Field.Value[0] == '{' || Field.Value[0] == '[') { return Fail("Only strings, numbers, true, false and null are understood"); }
+			bool Word{ Field.Value == "true" || Field.Value == "false" || Field.Value == "null" };
+			char* NumberEnd{ nullptr };
+			strtod(Field.Value.c_str(), &NumberEnd);
+			bool Number{ *NumberEnd == '\0' && Field.Value.find_first_not_of("0123456789+-.eE") == string::npos };
+			if (!Word && !Number) { return Fail("Expected a value"); }
+			Position += Field.Value.size();
+		}
+		Fields.push_back(move(Field));
+
+		// Then a comma and another field, or the end of the object.
+		SkipSpace();
+		if (Position < Text.size() && Text[Position] == ',') { Position++; continue; }
+		if (Position < Text.size() && Text[Position] == '}') { Position++; break; }
+		return Fail("Expected ',' or '}'");
+	}
+	SkipSpace();
+	if (Position != Text.size()) { return Fail("Unexpected text after the object"); }
+	return true;
+
+}
+
+// Function to find a field of an object by its name.
+const JsonNamespace::JsonField* JsonNamespace::FindJsonField(const vector<JsonField>& Fields, const string& Name)
+{
+	for (const JsonField& Field : Fields) { if (Field.Name == Name) { return &Field; } }
+	return nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+// OOP Chess Project: Json.h.
+// This is the JSON header file.
+// It contains the declarations of the helpers used to read and write the JSON lines that the command line tools use.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Json
+#define MY_CLASS_Json
+
+// Include the relevant libraries.
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace JsonNamespace
+{
+
+	// Function to write a string as JSON, in quotes with quotes, backslashes and control characters escaped.
+	void WriteJsonString(ostream& Output, const string& Text);
+
+	// Function to write a score, given from the point of view of the side to move with a pawn as 10, as "score" in centipawns,
+	// or as "mate" in a number of moves (negative if the side to move is the one mated) for a mate found at a depth.
+	void WriteJsonScore(ostream& Output, double Score, int Depth);
+
+	// A field of a JSON object: its name, and its value as it was written. A string has its quotes taken off and its escapes undone.
+	struct JsonField { string Name, Value; bool IsString; };
+
+	// Function to read a JSON object whose values are all strings, numbers, true, false or null, which is all a request needs.
+	// Returns false, with a description in Error, if the text isn't one.
+	bool ReadFlatJsonObject(const string& Text, vector<JsonField>& Fields, string& Error);
+
+	// Function to find a field of an object by its name. Returns nullptr if there isn't one.
+	const JsonField* FindJsonField(const vector<JsonField>& Fields, const string& Name);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+// OOP Chess Project: MappedFile.cpp.
+// This is the MappedFile class source file.
+// It contains the definitions of a read-only memory-mapped file.
+// James Cummins.
+
+// Include the MappedFile header file and the operating system headers.
+#include <iostream>
+#include "MappedFile.h"
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// Using namespaces.
+using namespace FileNamespace;
+
+// Default constructor.
+MappedFile::MappedFile()
+{
+	Data = nullptr;
+	Size = 0;
+#if defined(_WIN32)
+	FileHandle = MappingHandle = nullptr;
+#else
+	FileDescriptor = -1;
+#endif
+}
+
+// Destructor.
+MappedFile::~MappedFile() { Close(); }
+
+// Function to map a file for reading.
+bool MappedFile::Open(const string& FileName, bool Sequential)
+{
+
+	// Unmap any file that is already open.
+	Close();
+
+#if defined(_WIN32)
+	// Open the file, then create a read-only mapping of the whole of it. Other programs may still add to or replace the file.
+	HANDLE File{ CreateFileA(FileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr) };
+	if (File == INVALID_HANDLE_VALUE) { cerr << "Error: Unable to open " << FileName << "." << endl; return false; }
+	LARGE_INTEGER FileSize;
+	GetFileSizeEx(File, &FileSize);
+	FileHandle = File;
+	Size = static_cast<size_t>(FileSize.QuadPart);
+	// An empty file can't be mapped, but it is still a valid (empty) file.
+	if (Size == 0) { return true; }
+	MappingHandle = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (MappingHandle) { Data = static_cast<const uint8_t*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0)); }
+#else
+	// Open the file, then create a read-only mapping of the whole of it.
+	FileDescriptor = open(FileName.c_str(), O_RDONLY);
+	if (FileDescriptor < 0) { cerr << "Error: Unable to open " << FileName << "." << endl; return false; }
+	struct stat FileStatus;
+	fstat(FileDescriptor, &FileStatus);
+	Size = static_cast<size_t>(FileStatus.st_size);
+	// An empty file can't be mapped, but it is still a valid (empty) file.
+	if (Size == 0) { return true; }
+	void* Mapping{ mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, FileDescriptor, 0) };
+	if (Mapping != MAP_FAILED)
+	{
+		Data = static_cast<const uint8_t*>(Mapping);
+		// Tell the operating system whether the file will be read from start to end, so it can read ahead, or jumped around in.
+		madvise(Mapping, Size, Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+	}
+#endif
+
+	// If the mapping failed, print an error message and tidy up.
+	if (!Data)
+	{
+		cerr << "Error: Unable to map " << FileName << " into memory." << endl;
+		Close();
+		return false;
+	}
+	return true;
+
+}
+
+// Function to unmap the file.
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+	if (Data) { UnmapViewOfFile(Data); }
+	if (MappingHandle) { CloseHandle(MappingHandle); }
+	if (FileHandle) { CloseHandle(FileHandle); }
+	FileHandle = MappingHandle = nullptr;
+#else
+	if (Data) { munmap(const_cast<uint8_t*>(Data), Size); }
+	if (FileDescriptor >= 0) { close(FileDescriptor); }
+	FileDescriptor = -1;
+#endif
+	Data = nullptr;
+	Size = 0;
+}
+
+// Access functions.
+bool MappedFile::IsOpen() const
+{
+#if defined(_WIN32)
+	return FileHandle != nullptr;
+#else
+	return FileDescriptor >= 0;
+#endif
+}
+const uint8_t* MappedFile::GetData() const { return Data; }
+size_t MappedFile::GetSize() const { return Size; }
\ No newline at end of file
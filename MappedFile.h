@@ -0,0 +1,69 @@
+// OOP Chess Project: MappedFile.h.
+// This is the MappedFile class header file.
+// It contains the declarations of a read-only memory-mapped file, used for large data files.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_MappedFile
+#define MY_CLASS_MappedFile
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace FileNamespace
+{
+
+	// MappedFile class.
+	// The operating system pages the file in as it is read, so files much larger than memory can be used.
+	class MappedFile {
+
+	// Private member data.
+	private:
+
+		// The start and size of the mapped file.
+		const uint8_t* Data;
+		size_t Size;
+		// The handles the operating system needs to unmap the file.
+#if defined(_WIN32)
+		void* FileHandle;
+		void* MappingHandle;
+#else
+		int FileDescriptor;
+#endif
+
+	// Public member functions.
+	public:
+
+		// Default constructor.
+		MappedFile();
+		// Destructor. Unmaps the file.
+		~MappedFile();
+
+		// A mapping can't be shared, so copying is not allowed.
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Function to map a file for reading. Returns false if the file can't be opened.
+		// Files that are read from start to end are read ahead; others, such as indexes, are read a page at a time.
+		bool Open(const string& FileName, bool Sequential = true);
+
+		// Function to unmap the file.
+		void Close();
+
+		// Access functions.
+		bool IsOpen() const;
+		const uint8_t* GetData() const;
+		size_t GetSize() const;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,474 @@
+// OOP Chess Project: MoveGenerator.cpp.
+// This is the move generator source file.
+// It contains the definitions of the light move generator and of standard algebraic notation.
+// James Cummins.
+
+// Include the relevant header files.
+#include "MoveGenerator.h"
+#include "Pieces.h"
+
+// Using namespaces.
+using namespace GeneratorNamespace;
+using namespace PieceNamespace;
+
+// The squares the kings and rooks start on, which the castling rights depend on.
+const int WhiteKingSquare{ 60 }, BlackKingSquare{ 4 };
+const int WhiteKingsideRook{ 63 }, WhiteQueensideRook{ 56 }, BlackKingsideRook{ 7 }, BlackQueensideRook{ 0 };
+
+// Function to return the set of occupied squares.
+static Bitboard OccupiedSquares(const uint8_t Codes[64])
+{
+	Bitboard Occupied{ 0 };
+	for (int Square = 0; Square < 64; Square++) { Occupied |= static_cast<Bitboard>(Codes[Square] != NoPieceCode) << Square; }
+	return Occupied;
+}
+
+// Function to return the castling rights a square takes away when a piece moves from or to it.
+static uint8_t RightsLostOnSquare(int Square)
+{
+	switch (Square) {
+	case WhiteKingSquare:    return WhiteKingside | WhiteQueenside;
+	case BlackKingSquare:    return BlackKingside | BlackQueenside;
+	case WhiteKingsideRook:  return WhiteKingside;
+	case WhiteQueensideRook: return WhiteQueenside;
+	case BlackKingsideRook:  return BlackKingside;
+	case BlackQueensideRook: return BlackQueenside;
+	default:                 return 0;
+	}
+}
+
+// Function to find the square of a king, or -1 if there isn't one.
+static int FindKing(const uint8_t Codes[64], int KingCode)
+{
+	for (int Square = 0; Square < 64; Square++) { if (Codes[Square] == KingCode) { return Square; } }
+	return -1;
+}
+
+// Function to check if a move would leave the mover's own king in check.
+static bool LeavesKingInCheck(const FENPosition& Position, int From, int To, int Promotion)
+{
+	uint8_t Codes[64];
+	for (int Square = 0; Square < 64; Square++) { Codes[Square] = Position.Codes[Square]; }
+	ApplyMoveToCodes(Codes, From, To, Promotion);
+	int King{ FindKing(Codes, Position.WhiteToMove ? WhiteKingCode : BlackKingCode) };
+	return King >= 0 && IsSquareAttacked(Codes, King, !Position.WhiteToMove);
+}
+
+// Function to check if a square is attacked by a side.
+bool GeneratorNamespace::IsSquareAttacked(const uint8_t Codes[64], int Square, bool ByWhite)
+{
+
+	// The codes of the attacking side run from pawn to king.
+	int Pawn{ ByWhite ? WhitePawnCode : BlackPawnCode };
+	int Knight{ Pawn + 1 }, Bishop{ Pawn + 2 }, Rook{ Pawn + 3 }, Queen{ Pawn + 4 }, King{ Pawn + 5 };
+
+	// Look outwards from the square: a piece attacks it if the square attacks the piece in the same way.
+	// A pawn attacks the square if a pawn of the other colour on the square would attack the pawn.
+	for (Bitboard Squares = PawnAttacks(Square, !ByWhite); Squares; Squares &= Squares - 1) { if (Codes[LowestBit(Squares)] == Pawn) { return true; } }
+	for (Bitboard Squares = KnightAttacks(Square); Squares; Squares &= Squares - 1) { if (Codes[LowestBit(Squares)] == Knight) { return true; } }
+	for (Bitboard Squares = KingAttacks(Square); Squares; Squares &= Squares - 1) { if (Codes[LowestBit(Squares)] == King) { return true; } }
+	Bitboard Occupied{ OccupiedSquares(Codes) };
+	for (Bitboard Squares = SlidingAttacks(Square, Occupied, true, false); Squares; Squares &= Squares - 1)
+	{
+		int Code{ Codes[LowestBit(Squares)] };
+		if (Code == Rook || Code == Queen) { return true; }
+	}
+	for (Bitboard Squares = SlidingAttacks(Square, Occupied, false, true); Squares; Squares &= Squares - 1)
+	{
+		int Code{ Codes[LowestBit(Squares)] };
+		if (Code == Bishop || Code == Queen) { return true; }
+	}
+	return false;
+
+}
+
+// Function to check if the side to move is in check.
+bool GeneratorNamespace::InCheck(const FENPosition& Position)
+{
+	int King{ FindKing(Position.Codes, Position.WhiteToMove ? WhiteKingCode : BlackKingCode) };
+	return King >= 0 && IsSquareAttacked(Position.Codes, King, !Position.WhiteToMove);
+}
+
+// Function to return whether the game is over in a position.
+GameEnding GeneratorNamespace::FindGameEnding(const FENPosition& Position)
+{
+
+	// With no legal moves it is checkmate or stalemate, whatever else is true.
+	PositionMove Moves[MaximumMoves];
+	if (GenerateLegalMoves(Position, Moves) == 0) { return InCheck(Position) ? Checkmate : Stalemate; }
+	if (Position.HalfmoveClock >= 100) { return FiftyMoveRule; }
+
+	// Neither side can mate with only a king and a bishop or knight against a king.
+	int Minor{ 0 };
+	for (int Square = 0; Square < 64; Square++)
+	{
+		int Code{ Position.Codes[Square] };
+		if (Code == NoPieceCode || Code == WhiteKingCode || Code == BlackKingCode) { continue; }
+		if (Code != WhiteKnightCode && Code != BlackKnightCode && Code != WhiteBishopCode && Code != BlackBishopCode) { return NotFinished; }
+		Minor++;
+	}
+	return Minor <= 1 ? InsufficientMaterial : NotFinished;
+
+}
+
+// Function to return the result of a game that ended in a position.
+const char* GeneratorNamespace::GameEndingResult(const FENPosition& Position, GameEnding Ending)
+{
+	if (Ending == NotFinished) { return "*"; }
+	if (Ending != Checkmate) { return "1/2-1/2"; }
+	return Position.WhiteToMove ? "0-1" : "1-0";
+}
+
+// Function to return the name of an ending.
+const char* GeneratorNamespace::GameEndingName(GameEnding Ending)
+{
+	switch (Ending) {
+	case Checkmate:            return "checkmate";
+	case Stalemate:            return "stalemate";
+	case FiftyMoveRule:        return "fifty move rule";
+	case InsufficientMaterial: return "insufficient material";
+	default:                   return "unfinished";
+	}
+}
+
+// Function to make a move on 64 piece codes.
+int GeneratorNamespace::ApplyMoveToCodes(uint8_t Codes[64], int From, int To, int Promotion)
+{
+
+	int Code{ Codes[From] };
+	int FromRow{ From / 8 }, FromColumn{ From % 8 }, ToRow{ To / 8 }, ToColumn{ To % 8 };
+
+	// A king moving two squares is castling, so the rook jumps over it.
+	if ((Code == WhiteKingCode || Code == BlackKingCode) && ToColumn - FromColumn == 2)
+	{
+		Codes[8 * FromRow + 5] = Codes[8 * FromRow + 7];
+		Codes[8 * FromRow + 7] = NoPieceCode;
+	}
+	if ((Code == WhiteKingCode || Code == BlackKingCode) && ToColumn - FromColumn == -2)
+	{
+		Codes[8 * FromRow + 3] = Codes[8 * FromRow];
+		Codes[8 * FromRow] = NoPieceCode;
+	}
+
+	// A pawn moving diagonally onto an empty square is capturing en passant, so the pawn beside it is taken.
+	bool IsPawn{ Code == WhitePawnCode || Code == BlackPawnCode };
+	if (IsPawn && FromColumn != ToColumn && Codes[To] == NoPieceCode) { Codes[8 * FromRow + ToColumn] = NoPieceCode; }
+
+	// Move the piece, promoting a pawn that reaches the far side.
+	Codes[To] = static_cast<uint8_t>(Code);
+	Codes[From] = NoPieceCode;
+	if (Code == WhitePawnCode && ToRow == 0) { Codes[To] = static_cast<uint8_t>(Promotion != NoPieceCode ? Promotion : WhiteQueenCode); }
+	if (Code == BlackPawnCode && ToRow == 7) { Codes[To] = static_cast<uint8_t>(Promotion != NoPieceCode ? Promotion : BlackQueenCode); }
+	return Code;
+
+}
+
+// Function to make a move on a FEN position.
+void GeneratorNamespace::MakePositionMove(FENPosition& Position, const PositionMove& Move)
+{
+
+	// Work out what kind of move it is before the board changes.
+	int Code{ Position.Codes[Move.From] };
+	bool IsPawn{ Code == WhitePawnCode || Code == BlackPawnCode };
+	bool IsCapture{ Position.Codes[Move.To] != NoPieceCode || (IsPawn && Move.From % 8 != Move.To % 8) };
+
+	// Make the move, and take away the castling rights of any king or rook that moves or is captured.
+	ApplyMoveToCodes(Position.Codes, Move.From, Move.To, Move.Promotion);
+	Position.Castling &= static_cast<uint8_t>(~(RightsLostOnSquare(Move.From) | RightsLostOnSquare(Move.To)));
+
+	// A double step can be captured en passant on the square the pawn passed over.
+	int Step{ Move.To - Move.From };
+	Position.EnPassantSquare = (IsPawn && (Step == 16 || Step == -16)) ? (Move.From + Move.To) / 2 : -1;
+
+	// Update the counters and the side to move.
+	Position.HalfmoveClock = (IsPawn || IsCapture) ? 0 : Position.HalfmoveClock + 1;
+	if (!Position.WhiteToMove) { Position.FullmoveNumber++; }
+	Position.WhiteToMove = !Position.WhiteToMove;
+
+}
+
+// Function to pack a move into 16 bits.
+uint16_t GeneratorNamespace::PackPositionMove(const PositionMove& Move)
+{
+	// The piece codes run pawn, knight, bishop, rook, queen for each colour, so a queen (or no promotion) packs to zero.
+	int Kind{ Move.Promotion == NoPieceCode ? 0 : (Move.Promotion - 1) % 6 % 4 };
+	return static_cast<uint16_t>((Move.From & 63) | ((Move.To & 63) << 6) | (Kind << 12));
+}
+
+// Function to read back a packed move.
+PositionMove GeneratorNamespace::UnpackPositionMove(uint16_t Packed, const FENPosition& Position)
+{
+	PositionMove Move{ static_cast<uint8_t>(Packed & 63), static_cast<uint8_t>((Packed >> 6) & 63), NoPieceCode };
+	int Code{ Position.Codes[Move.From] }, Kind{ (Packed >> 12) & 3 };
+	if ((Code == WhitePawnCode && Move.To / 8 == 0) || (Code == BlackPawnCode && Move.To / 8 == 7)) { Move.Promotion = static_cast<uint8_t>(Code + (Kind == 0 ? 4 : Kind)); }
+	return Move;
+}
+
+// Function to fill an array with every legal move.
+int GeneratorNamespace::GenerateLegalMoves(const FENPosition& Position, PositionMove Moves[])
+{
+
+	// The codes of the side to move run from pawn to king, and the other side's follow six later or come six earlier.
+	bool White{ Position.WhiteToMove };
+	int Pawn{ White ? WhitePawnCode : BlackPawnCode };
+	Bitboard Own{ 0 }, Enemy{ 0 };
+	for (int Square = 0; Square < 64; Square++)
+	{
+		int Code{ Position.Codes[Square] };
+		if (Code == NoPieceCode) { continue; }
+		if ((Code <= WhiteKingCode) == White) { Own |= 1ULL << Square; }
+		else { Enemy |= 1ULL << Square; }
+	}
+	Bitboard Occupied{ Own | Enemy };
+
+	// Collect the moves that obey the piece rules, and then keep only those that don't leave the king in check.
+	PositionMove Candidates[MaximumMoves];
+	int Count{ 0 };
+	auto Add = [&](int From, int To, int Promotion) { Candidates[Count++] = { static_cast<uint8_t>(From), static_cast<uint8_t>(To), static_cast<uint8_t>(Promotion) }; };
+	// A pawn reaching the far side can become any of the four pieces.
+	auto AddPawnMove = [&](int From, int To)
+	{
+		if (To / 8 == (White ? 0 : 7)) { for (int Promotion = Pawn + 4; Promotion >= Pawn + 1; Promotion--) { Add(From, To, Promotion); } }
+		else { Add(From, To, NoPieceCode); }
+	};
+
+	for (Bitboard Pieces = Own; Pieces; Pieces &= Pieces - 1)
+	{
+		int From{ LowestBit(Pieces) };
+		Bitboard Targets{ 0 };
+		switch (Position.Codes[From] - Pawn) {
+		case 0:
+		{
+			// Pawns move one square forward, two from their starting rank, and capture diagonally (including en passant).
+			int Forward{ White ? -8 : 8 };
+			if (!(Occupied & (1ULL << (From + Forward))))
+			{
+				AddPawnMove(From, From + Forward);
+				if (From / 8 == (White ? 6 : 1) && !(Occupied & (1ULL << (From + 2 * Forward)))) { Add(From, From + 2 * Forward, NoPieceCode); }
+			}
+			Bitboard Captures{ Enemy };
+			if (Position.EnPassantSquare >= 0 && Position.EnPassantSquare < 64) { Captures |= 1ULL << Position.EnPassantSquare; }
+			for (Bitboard Squares = PawnAttacks(From, White) & Captures; Squares; Squares &= Squares - 1) { AddPawnMove(From, LowestBit(Squares)); }
+			continue;
+		}
+		case 1: Targets = KnightAttacks(From); break;
+		case 2: Targets = SlidingAttacks(From, Occupied, false, true); break;
+		case 3: Targets = SlidingAttacks(From, Occupied, true, false); break;
+		case 4: Targets = SlidingAttacks(From, Occupied, true, true); break;
+		case 5: Targets = KingAttacks(From); break;
+		}
+		for (Targets &= ~Own; Targets; Targets &= Targets - 1) { Add(From, LowestBit(Targets), NoPieceCode); }
+	}
+
+	// Castling needs the right, an empty path between the king and rook, and a king that doesn't start, pass or land in check.
+	int King{ White ? WhiteKingSquare : BlackKingSquare };
+	int KingsideRight{ White ? WhiteKingside : BlackKingside }, QueensideRight{ White ? WhiteQueenside : BlackQueenside };
+	if (Position.Codes[King] == Pawn + 5 && (Position.Castling & (KingsideRight | QueensideRight)) && !IsSquareAttacked(Position.Codes, King, !White))
+	{
+		if ((Position.Castling & KingsideRight) && Position.Codes[King + 3] == Pawn + 3 && !(Occupied & (3ULL << (King + 1)))
+			&& !IsSquareAttacked(Position.Codes, King + 1, !White)) { Add(King, King + 2, NoPieceCode); }
+		if ((Position.Castling & QueensideRight) && Position.Codes[King - 4] == Pawn + 3 && !(Occupied & (7ULL << (King - 3)))
+			&& !IsSquareAttacked(Position.Codes, King - 1, !White)) { Add(King, King - 2, NoPieceCode); }
+	}
+
+	// Keep the legal moves. Landing in check is caught here, along with pins.
+	int Legal{ 0 };
+	for (int i = 0; i < Count; i++)
+	{
+		if (!LeavesKingInCheck(Position, Candidates[i].From, Candidates[i].To, Candidates[i].Promotion)) { Moves[Legal++] = Candidates[i]; }
+	}
+	return Legal;
+
+}
+
+// Function to count the positions at the end of every sequence of legal moves.
+uint64_t GeneratorNamespace::Perft(const FENPosition& Position, int Depth)
+{
+
+	// At the last move the moves only need counting, not making.
+	if (Depth <= 0) { return 1; }
+	PositionMove Moves[MaximumMoves];
+	int Count{ GenerateLegalMoves(Position, Moves) };
+	if (Depth == 1) { return static_cast<uint64_t>(Count); }
+	uint64_t Nodes{ 0 };
+	for (int i = 0; i < Count; i++)
+	{
+		FENPosition After{ Position };
+		MakePositionMove(After, Moves[i]);
+		Nodes += Perft(After, Depth - 1);
+	}
+	return Nodes;
+
+}
+
+// Function to read a move in standard algebraic notation.
+bool GeneratorNamespace::ParseSAN(const FENPosition& Position, const char* Text, int Length, PositionMove& Move)
+{
+
+	// Ignore the check, mate and annotation symbols at the end.
+	while (Length > 0 && (Text[Length - 1] == '+' || Text[Length - 1] == '#' || Text[Length - 1] == '!' || Text[Length - 1] == '?')) { Length--; }
+	if (Length < 2) { return false; }
+	bool White{ Position.WhiteToMove };
+	int Pawn{ White ? WhitePawnCode : BlackPawnCode };
+
+	// Castling is written with letter O (or sometimes zero).
+	if ((Text[0] == 'O' || Text[0] == '0') && Length >= 3 && Text[1] == '-')
+	{
+		int King{ White ? WhiteKingSquare : BlackKingSquare };
+		bool Queenside{ Length >= 5 };
+		Move = { static_cast<uint8_t>(King), static_cast<uint8_t>(Queenside ? King - 2 : King + 2), NoPieceCode };
+		if (Position.Codes[King] != Pawn + 5) { return false; }
+
+		// The legal moves already check the right, the rook, the empty squares and the attacked squares.
+		PositionMove Moves[MaximumMoves];
+		int Count{ GenerateLegalMoves(Position, Moves) };
+		for (int i = 0; i < Count; i++) { if (Moves[i].From == Move.From && Moves[i].To == Move.To) { return true; } }
+		return false;
+	}
+
+	// The piece letter, if there is one. Pawn moves have none.
+	int Code{ Pawn }, Start{ 0 };
+	switch (Text[0]) {
+	case 'N': Code = Pawn + 1; Start = 1; break;
+	case 'B': Code = Pawn + 2; Start = 1; break;
+	case 'R': Code = Pawn + 3; Start = 1; break;
+	case 'Q': Code = Pawn + 4; Start = 1; break;
+	case 'K': Code = Pawn + 5; Start = 1; break;
+	}
+
+	// The promotion piece, written "=Q" or just "Q" after the destination.
+	int Promotion{ NoPieceCode };
+	if (Code == Pawn && Length >= 3)
+	{
+		switch (Text[Length - 1]) {
+		case 'N': Promotion = Pawn + 1; break;
+		case 'B': Promotion = Pawn + 2; break;
+		case 'R': Promotion = Pawn + 3; break;
+		case 'Q': Promotion = Pawn + 4; break;
+		}
+		if (Promotion != NoPieceCode) { Length--; if (Text[Length - 1] == '=') { Length--; } }
+	}
+
+	// The destination is the last two characters.
+	if (Length - Start < 2) { return false; }
+	char File{ Text[Length - 2] }, Rank{ Text[Length - 1] };
+	if (File < 'a' || File > 'h' || Rank < '1' || Rank > '8') { return false; }
+	int To{ 8 * ('8' - Rank) + (File - 'a') };
+	bool OwnPieceThere{ Position.Codes[To] != NoPieceCode && (Position.Codes[To] <= WhiteKingCode) == White };
+	if (OwnPieceThere) { return false; }
+
+	// Anything between the piece and the destination narrows down where the piece came from.
+	int FromFile{ -1 }, FromRank{ -1 };
+	for (int i = Start; i < Length - 2; i++)
+	{
+		if (Text[i] >= 'a' && Text[i] <= 'h') { FromFile = Text[i] - 'a'; }
+		else if (Text[i] >= '1' && Text[i] <= '8') { FromRank = '8' - Text[i]; }
+		else if (Text[i] != 'x' && Text[i] != '-' && Text[i] != ':') { return false; }
+	}
+
+	// Find the squares the piece could have come from.
+	Bitboard Sources{ 0 };
+	if (Code == Pawn)
+	{
+		int Backward{ White ? 8 : -8 };
+		if (FromFile >= 0 && FromFile != To % 8)
+		{
+			// A capture comes from the square diagonally behind, in the file given.
+			int From{ To + Backward + (FromFile - To % 8) };
+			if (From >= 0 && From < 64 && (FromFile - To % 8 == 1 || FromFile - To % 8 == -1)) { Sources = 1ULL << From; }
+		}
+		else if (To + Backward >= 0 && To + Backward < 64)
+		{
+			// A push comes from the square behind, or two behind if that is empty and the pawn is double stepping.
+			if (Position.Codes[To + Backward] == Pawn) { Sources = 1ULL << (To + Backward); }
+			else if (Position.Codes[To + Backward] == NoPieceCode && To / 8 == (White ? 4 : 3)) { Sources = 1ULL << (To + 2 * Backward); }
+		}
+		if (Promotion == NoPieceCode && To / 8 == (White ? 0 : 7)) { Promotion = Pawn + 4; }
+	}
+	else
+	{
+		Bitboard Occupied{ OccupiedSquares(Position.Codes) };
+		switch (Code - Pawn) {
+		case 1: Sources = KnightAttacks(To); break;
+		case 2: Sources = SlidingAttacks(To, Occupied, false, true); break;
+		case 3: Sources = SlidingAttacks(To, Occupied, true, false); break;
+		case 4: Sources = SlidingAttacks(To, Occupied, true, true); break;
+		case 5: Sources = KingAttacks(To); break;
+		}
+	}
+
+	// Keep the sources that hold the piece, match the hints, and don't leave the king in check.
+	int Found{ 0 };
+	for (; Sources; Sources &= Sources - 1)
+	{
+		int From{ LowestBit(Sources) };
+		if (Position.Codes[From] != Code) { continue; }
+		if ((FromFile >= 0 && From % 8 != FromFile && Code != Pawn) || (FromRank >= 0 && From / 8 != FromRank)) { continue; }
+		if (Code == Pawn && From % 8 != To % 8 && Position.Codes[To] == NoPieceCode && To != Position.EnPassantSquare) { continue; }
+		if (Code == Pawn && From % 8 == To % 8 && Position.Codes[To] != NoPieceCode) { continue; }
+		if (LeavesKingInCheck(Position, From, To, Promotion)) { continue; }
+		Move = { static_cast<uint8_t>(From), static_cast<uint8_t>(To), static_cast<uint8_t>(Promotion) };
+		Found++;
+	}
+	return Found == 1;
+
+}
+
+// Function to write a legal move in standard algebraic notation.
+int GeneratorNamespace::WriteSAN(const FENPosition& Position, const PositionMove& Move, char Buffer[])
+{
+
+	char* Cursor{ Buffer };
+	int Code{ Position.Codes[Move.From] };
+	int Type{ (Code - 1) % 6 };
+	int FromColumn{ Move.From % 8 }, ToColumn{ Move.To % 8 };
+	bool IsCapture{ Position.Codes[Move.To] != NoPieceCode || (Type == PawnType && FromColumn != ToColumn) };
+
+	if (Type == KingType && (ToColumn - FromColumn == 2 || ToColumn - FromColumn == -2))
+	{
+		// Castling.
+		*Cursor++ = 'O'; *Cursor++ = '-'; *Cursor++ = 'O';
+		if (ToColumn < FromColumn) { *Cursor++ = '-'; *Cursor++ = 'O'; }
+	}
+	else if (Type == PawnType)
+	{
+		// Pawn captures start with the file the pawn came from, and promotions end with the new piece.
+		if (IsCapture) { *Cursor++ = static_cast<char>('a' + FromColumn); *Cursor++ = 'x'; }
+		*Cursor++ = static_cast<char>('a' + ToColumn);
+		*Cursor++ = static_cast<char>('8' - Move.To / 8);
+		int Promotion{ Move.Promotion != NoPieceCode ? Move.Promotion : (Move.To / 8 == 0 || Move.To / 8 == 7 ? Code + 4 : NoPieceCode) };
+		if (Promotion != NoPieceCode) { *Cursor++ = '='; *Cursor++ = "NBRQ"[(Promotion - 1) % 6 - 1]; }
+	}
+	else
+	{
+		// Other pieces start with their letter, then the file, rank or both if another piece of the same kind could make the move.
+		*Cursor++ = "PNBRQK"[Type];
+		PositionMove Moves[MaximumMoves];
+		int Count{ GenerateLegalMoves(Position, Moves) };
+		bool Ambiguous{ false }, SameFile{ false }, SameRank{ false };
+		for (int i = 0; i < Count; i++)
+		{
+			if (Moves[i].To != Move.To || Moves[i].From == Move.From || Position.Codes[Moves[i].From] != Code) { continue; }
+			Ambiguous = true;
+			SameFile = SameFile || Moves[i].From % 8 == FromColumn;
+			SameRank = SameRank || Moves[i].From / 8 == Move.From / 8;
+		}
+		if (Ambiguous && (!SameFile || SameRank)) { *Cursor++ = static_cast<char>('a' + FromColumn); }
+		if (Ambiguous && SameFile) { *Cursor++ = static_cast<char>('8' - Move.From / 8); }
+		if (IsCapture) { *Cursor++ = 'x'; }
+		*Cursor++ = static_cast<char>('a' + ToColumn);
+		*Cursor++ = static_cast<char>('8' - Move.To / 8);
+	}
+
+	// Check and mate.
+	FENPosition After{ Position };
+	MakePositionMove(After, Move);
+	if (InCheck(After))
+	{
+		PositionMove Replies[MaximumMoves];
+		*Cursor++ = GenerateLegalMoves(After, Replies) == 0 ? '#' : '+';
+	}
+	*Cursor = '\0';
+	return static_cast<int>(Cursor - Buffer);
+
+}
\ No newline at end of file
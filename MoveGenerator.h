@@ -0,0 +1,93 @@
+// OOP Chess Project: MoveGenerator.h.
+// This is the move generator header file.
+// It contains the declarations of a light move generator that works directly on FEN positions, and of standard algebraic notation.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_MoveGenerator
+#define MY_CLASS_MoveGenerator
+
+// Include the relevant libraries.
+#include <cstdint>
+#include "Fen.h"
+#include "AttackMaps.h"
+
+// Using namespaces.
+using namespace FenNamespace;
+using namespace AttackNamespace;
+
+// Using a namespace to avoid name collisions.
+namespace GeneratorNamespace
+{
+
+	// More than the number of legal moves in any chess position.
+	const int MaximumMoves{ 256 };
+
+	// A move on a FEN position: the squares moved from and to, and the code of the piece a pawn is promoted to (or NoPieceCode).
+	struct PositionMove { uint8_t From, To, Promotion; };
+
+	// The chessboard works one move at a time through piece objects, which is far too slow for reading or checking
+	// millions of games, so these functions do the same job on the 64 piece codes of a FEN position using the attack tables.
+
+	// Function to check if a square is attacked by a side.
+	bool IsSquareAttacked(const uint8_t Codes[64], int Square, bool ByWhite);
+
+	// Function to check if the side to move is in check.
+	bool InCheck(const FENPosition& Position);
+
+	// Function to make a move on 64 piece codes, including the rook of a castling move, a pawn taken en passant and a promotion.
+	// The move is assumed to be legal, so nothing is checked. If no promotion piece is given, a pawn is promoted to a queen.
+	// Returns the code of the piece that moved.
+	int ApplyMoveToCodes(uint8_t Codes[64], int From, int To, int Promotion = NoPieceCode);
+
+	// Function to make a move on a FEN position, updating the castling rights, en passant square, counters and side to move.
+	void MakePositionMove(FENPosition& Position, const PositionMove& Move);
+
+	// Functions to pack a move into 16 bits and read it back: the square moved from in the low six bits, the square moved to
+	// in the next six and the promotion piece in the next two (zero for a queen or no promotion, then knight, bishop and rook),
+	// so a move packed by a save file reads back the same. Reading needs the position the move is made in, for the colour of the pawn.
+	uint16_t PackPositionMove(const PositionMove& Move);
+	PositionMove UnpackPositionMove(uint16_t Packed, const FENPosition& Position);
+
+	// Function to fill an array of at least MaximumMoves moves with every legal move. Returns the number of moves.
+	int GenerateLegalMoves(const FENPosition& Position, PositionMove Moves[]);
+
+	// Function to count the positions at the end of every sequence of Depth legal moves (perft), which is compared with
+	// published counts to check the move generator.
+	uint64_t Perft(const FENPosition& Position, int Depth);
+
+	// A position with a published perft count, for checking the move generator.
+	struct PerftCheck { const char* FEN; int Depth; uint64_t Nodes; };
+
+	// The standard checks: the starting position, "Kiwipete", which is full of castling, en passant and promotions,
+	// and an endgame with discovered checks and en passant pins.
+	const PerftCheck StandardPerftChecks[3]{
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 197281 },
+		{ "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862 },
+		{ "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4, 43238 }
+	};
+
+	// The ways a game can be over in a position. A repetition depends on the game before the position, so it isn't one of them.
+	enum GameEnding { NotFinished, Checkmate, Stalemate, FiftyMoveRule, InsufficientMaterial };
+
+	// Function to return whether the game is over in a position: there are no legal moves, a hundred half moves have passed
+	// without a capture or pawn move, or nothing is left but the kings and at most one bishop or knight.
+	GameEnding FindGameEnding(const FENPosition& Position);
+
+	// Functions to return the result of a game that ended in a position as PGN writes it ("1-0", "0-1", "1/2-1/2", or "*" if it
+	// hasn't ended), and the name of the ending (e.g. "checkmate").
+	const char* GameEndingResult(const FENPosition& Position, GameEnding Ending);
+	const char* GameEndingName(GameEnding Ending);
+
+	// Function to read a move in standard algebraic notation (e.g. "Nf3", "exd5", "O-O" or "e8=Q+"), given its length.
+	// Annotations such as "!?" are ignored. Returns false if the text isn't a legal move in the position.
+	bool ParseSAN(const FENPosition& Position, const char* Text, int Length, PositionMove& Move);
+
+	// Function to write a legal move in standard algebraic notation into a buffer of at least 10 characters, including
+	// the check or mate symbol. Returns the length of the move, not counting the terminating null.
+	int WriteSAN(const FENPosition& Position, const PositionMove& Move, char Buffer[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -3,102 +3,125 @@
 // It contains structure of how the game is played.
 // James Cummins.
 
-// Include the GameManager header file.
+// Include the GameManager, Benchmark and Tuner header files.
 #include "GameManager.h"
+#include "Benchmark.h"
+#include "Tuner.h"
+#include "GameDatabase.h"
+#include "Zobrist.h"
+#include "BookBuilder.h"
+#include "Epd.h"
+#include "SelfPlay.h"
+#include "Uci.h"
+#include "Batch.h"
+#include "Server.h"
+#include "Tournament.h"
+#include "Renderer.h"
+#include "Session.h"
 
 // Using namespaces.
 using namespace GameNamespace;
+using namespace BenchmarkNamespace;
+using namespace TunerNamespace;
+using namespace DatabaseNamespace;
+using namespace ZobristNamespace;
+using namespace BookBuilderNamespace;
+using namespace EpdNamespace;
+using namespace SelfPlayNamespace;
+using namespace UciNamespace;
+using namespace BatchNamespace;
+using namespace ServerNamespace;
+using namespace TournamentNamespace;
+using namespace RenderNamespace;
+using namespace SessionNamespace;
 
-// Main function
-int main()
+// Function to set up the position in a FEN string and describe it: "fen <FEN string> [depth]".
+// If a depth is given, the move the computer would make at that depth is printed too.
+int DescribePosition(int argc, char* argv[])
 {
 
-	// Seed the random generator.
-	srand(static_cast<unsigned int>(time(NULL)));
-	// Initialise the FinishedProgram bool to zero.
-	bool FinishedProgram{ false };
+	// Set up the board and the game from the FEN string.
+	Board myBoard;
+	myBoard.SetColourAndBackground(15, 0);
+	GameManager TheGame(&myBoard);
+	if (!TheGame.SetPositionFromFEN(argv[2])) { return 1; }
 
-	// While the FinishedProgram bool is false, loop over this.
-	while (!FinishedProgram)
+	// Print the chessboard and what is known about the position.
+	string Colour{ TheGame.GetGameTurnNumber() % 2 == 0 ? "White" : "Black" };
+	myBoard.PrintBoard();
+	cout << "\nFEN: " << TheGame.GetFEN() << endl;
+	cout << Colour << " to move, with " << TheGame.NumberOfAllowedMoves(Colour) << " allowed moves." << endl;
+	if (myBoard.KingInCheck(Colour)) { cout << Colour << " King is in check." << endl; }
+	cout << "Evaluation: " << TheGame.EvaluatePosition() << " (from white's point of view, a pawn is worth 10)." << endl;
+
+	// Search for the best move if a depth was given.
+	if (argc > 3)
 	{
-		// Define the board.
-		Board myBoard;
-		// Set the colour scheme.
-		myBoard.SetColourAndBackground(15, 0);
-		// Initialise the board.
-		myBoard.InitialiseBoard();
-		// Define the game.
-		GameManager TheGame(&myBoard);
+		int Depth{ atoi(argv[3]) };
+		if (Depth <= 0) { cerr << "Error: The search depth must be a positive number." << endl; return 1; }
+		if (TheGame.NumberOfAllowedMoves(Colour) == 0) { cerr << "Error: " << Colour << " has no allowed moves." << endl; return 1; }
+		TheGame.SetMaxBoardEval(Colour == "White");
+		PossibleMove Best{ TheGame.MinimaxMove(Depth, Colour == "White") };
+		cout << "Best move at depth " << Depth << ": (" << static_cast<char>('a' + Best.OriginalY) << ", " << 8 - Best.OriginalX << ") -> (" << static_cast<char>('a' + Best.MovedY) << ", " << 8 - Best.MovedX << ")." << endl;
+	}
+	return 0;
 
-		// Print useful information.
-		cout << "Chess Game by James Cummins." << endl;
-		cout << "For maximum gaming pleasure it is recommended to maximise the console screen.\n" << endl;
+}
 
-		// Print the chessboard.
-		myBoard.PrintBoard();
-		// Select the game mode.
-		int GameMode{ TheGame.GameModeSelection() };
-		// Give the user an option to load a previously saved game. 
-		TheGame.LoadGameSelection();
+// Main function
+int main(int argc, char* argv[])
+{
+
+	// Load the tuned evaluation parameters, if there are any next to the program.
+	const string ParameterFile{ "EvalParameters.txt" };
+	if (ifstream(ParameterFile).good()) { LoadParameters(ParameterFile, ActiveParameters()); }
+	// Open the opening book, if there is one next to the program, after loading any book random numbers that replace Polyglot's.
+	const string BookFile{ "Book.bin" }, PolyglotRandomsFile{ "PolyglotRandoms.txt" };
+	if (ifstream(PolyglotRandomsFile).good()) { LoadPolyglotRandoms(PolyglotRandomsFile); }
+	if (ifstream(BookFile).good()) { ActiveBook().Open(BookFile); }
 
-		// Structure the game according to the game mode selected.
-		switch (GameMode) {
-		case 1:
-			while (!TheGame.IsGameOver()) {
-				TheGame.BeginOptionMenu();
-				TheGame.HumanMove();
-				if (TheGame.IsGameOver()) { break; }
-				TheGame.EndOptionMenu();
-			}
-			break;
-		case 2:
-			while (!TheGame.IsGameOver()) {
-				while (TheGame.GetGameTurnNumber() % 2 == 0) {
-					TheGame.BeginOptionMenu();
-					TheGame.HumanMove();
-					if (TheGame.IsGameOver()) { goto EndCase2; }
-					TheGame.EndOptionMenu();
-				}
-				TheGame.ComputerMove(false);
-			}
-		EndCase2: break;
-		case 3:
-			while (!TheGame.IsGameOver()) {
-				while (TheGame.GetGameTurnNumber() % 2 == 0) {
-					TheGame.BeginOptionMenu();
-					TheGame.HumanMove();
-					if (TheGame.IsGameOver()) { goto EndCase3; }
-					TheGame.EndOptionMenu();
-				}
-				TheGame.ComputerMove(true);
-			}
-		EndCase3: break;
-		case 4:
-			while (!TheGame.IsGameOver()) {
-				TheGame.ComputerMove(true);
-				if (TheGame.IsGameOver()) { break; }
-				TheGame.ComputerMove(false);
-			}
-			break;
-		default:
-			cerr << "Error: Game mode not recongised." << endl;
-		}
+	// If the program was started with "bench", run the benchmarks instead of the game.
+	if (argc > 1 && string(argv[1]) == "bench") { return RunBenchmarks(argc, argv); }
+	// If the program was started with "pack" or "tune", run the evaluation tuner instead of the game.
+	if (argc > 1 && (string(argv[1]) == "pack" || string(argv[1]) == "tune")) { return RunTuner(argc, argv); }
+	// If the program was started with "fen" and a FEN string, describe that position instead of playing a game.
+	if (argc > 2 && string(argv[1]) == "fen") { return DescribePosition(argc, argv); }
+	// If the program was started with "pgn" and a file, read every game in it instead of playing a game.
+	if (argc > 1 && string(argv[1]) == "pgn") { return RunPgn(argc, argv); }
+	// If the program was started with "db", add games to or search a game database instead of playing a game.
+	if (argc > 1 && string(argv[1]) == "db") { return RunDatabase(argc, argv); }
+	// If the program was started with "book", list the book moves in a position instead of playing a game.
+	if (argc > 1 && string(argv[1]) == "book") { return RunBook(argc, argv); }
+	// If the program was started with "makebook", make an opening book from PGN files instead of playing a game.
+	if (argc > 1 && string(argv[1]) == "makebook") { return RunBookBuilder(argc, argv); }
+	// If the program was started with "epd", search the positions of a test suite instead of playing a game.
+	if (argc > 1 && string(argv[1]) == "epd") { return RunEpd(argc, argv); }
+	// If the program was started with "selfplay", write training data from games against itself instead of playing a game.
+	if (argc > 1 && string(argv[1]) == "selfplay") { return RunSelfPlay(argc, argv); }
+	// If the program was started with "uci", be driven by another chess program through the Universal Chess Interface.
+	if (argc > 1 && string(argv[1]) == "uci") { return RunUci(); }
+	// If the program was started with "batch", play or analyse positions without asking anything.
+	if (argc > 1 && string(argv[1]) == "batch") { return RunBatchCommand(argc, argv); }
+	// If the program was started with "server", play games for clients connecting to a local socket, and with "client", connect to one.
+	if (argc > 1 && string(argv[1]) == "server") { return RunServer(argc, argv); }
+	if (argc > 1 && string(argv[1]) == "client") { return RunClient(argc, argv); }
+	// If the program was started with "tournament", play two settings of the engine against each other instead of playing a game.
+	if (argc > 1 && string(argv[1]) == "tournament") { return RunTournamentCommand(argc, argv); }
 
-		// Allow the user to view all the moves and save them to a file,
-		cout << "\nWould you like to display all the moves and print them to a file (Y/N)? ";
-		char Display{ GoodInput('Y', 'Y', 'N', 'N') };
-		if (toupper(Display) == 'Y')
-		{
-			cout << "\nPrinting moves:" << endl;
-			TheGame.PrintList();
-			cout << "\nMoves printed to file (ChessGame.txt)." << endl;
-		}
+	// If the program was started with "redraw", play the game as usual but redraw only the squares that change, below a fixed board.
+	if (argc > 1 && string(argv[1]) == "redraw") { SetIncrementalDrawing(true); }
 
-		// Allow the user to play the chess game again.
-		cout << "\nWould you like to use the play another game (Y/N)? ";
-		char Repeat{ GoodInput('Y', 'Y', 'N', 'N') };
-		if (toupper(Repeat) == 'N') { FinishedProgram = true; }
-		else { for (int i = 0; i < 100; i++) { cout << "\n" << endl; } }
+	// Seed the random generator.
+	srand(static_cast<unsigned int>(time(NULL)));
+	// Play the game as a session, giving it each line the user types and letting the computer move when it is waiting to,
+	// until the user quits or doesn't want to play again.
+	GameSession Session;
+	for (SessionStatus Status{ Session.Start() }; Status != SessionFinished; )
+	{
+		if (Status == NeedsComputerMove) { Status = Session.PlayComputerMove(); continue; }
+		string Line;
+		if (!ReadInputLine(Line)) { cerr << "Error: The input has ended." << endl; return 1; }
+		Status = Session.GiveInput(Line);
 	}
 
 	return 0;
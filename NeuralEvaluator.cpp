@@ -0,0 +1,373 @@
+// OOP Chess Project: NeuralEvaluator.cpp.
+// This is the neural evaluator source file.
+// It contains all the definitions related to the efficiently updatable neural network evaluation.
+// James Cummins.
+
+// Include the relevant header files.
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include "NeuralEvaluator.h"
+#include "CpuFeatures.h"
+#include "Pieces.h"
+
+// Using namespaces.
+using namespace NeuralNamespace;
+using namespace CpuNamespace;
+using namespace PieceNamespace;
+
+// The first four bytes and the version of a network file.
+const char NetworkMagic[4]{ 'C', 'N', 'U', 'E' };
+const uint32_t NetworkVersion{ 1 };
+
+// Non member functions for the scalar kernels.
+// Clip the two accumulators into the 0 to 127 range and join them into one byte vector.
+void ClipScalar(const int16_t* SideToMove, const int16_t* OtherSide, uint8_t* Output)
+{
+	for (int i = 0; i < HalfSize; i++)
+	{
+		Output[i]            = static_cast<uint8_t>(min<int>(max<int>(SideToMove[i], 0), 127));
+		Output[HalfSize + i] = static_cast<uint8_t>(min<int>(max<int>(OtherSide[i],  0), 127));
+	}
+}
+
+// Dot product of a byte vector and an int8 weight row.
+int32_t DotScalar(const uint8_t* Input, const int8_t* Weights, int Size)
+{
+	int32_t Sum{ 0 };
+	for (int i = 0; i < Size; i++) { Sum += Input[i] * Weights[i]; }
+	return Sum;
+}
+
+// Add or subtract a feature column to or from an accumulator.
+void AddColumnScalar(int16_t* Accumulator, const int16_t* Column)      { for (int i = 0; i < HalfSize; i++) { Accumulator[i] += Column[i]; } }
+void SubtractColumnScalar(int16_t* Accumulator, const int16_t* Column) { for (int i = 0; i < HalfSize; i++) { Accumulator[i] -= Column[i]; } }
+
+#ifdef CHESS_X86
+
+// Non member functions for the AVX2 kernels. They give exactly the same results as the scalar kernels.
+// Clip sixteen accumulator values at a time and pack them into bytes.
+AVX2_TARGET void ClipAVX2(const int16_t* SideToMove, const int16_t* OtherSide, uint8_t* Output)
+{
+	const __m256i Maximum{ _mm256_set1_epi16(127) };
+	const int16_t* Halves[2]{ SideToMove, OtherSide };
+	for (int h = 0; h < 2; h++)
+	{
+		for (int i = 0; i < HalfSize; i += 32)
+		{
+			__m256i Low{  _mm256_min_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Halves[h] + i)),      Maximum) };
+			__m256i High{ _mm256_min_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Halves[h] + i + 16)), Maximum) };
+			// Packing saturates negative values to zero, but works within each 128 bit lane, so the lanes are put back in order.
+			__m256i Packed{ _mm256_permute4x64_epi64(_mm256_packus_epi16(Low, High), 0xD8) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Output + h * HalfSize + i), Packed);
+		}
+	}
+}
+
+// Dot product of thirty two bytes at a time: multiply into pairs of int16, then add the pairs into int32.
+AVX2_TARGET int32_t DotAVX2(const uint8_t* Input, const int8_t* Weights, int Size)
+{
+	const __m256i Ones{ _mm256_set1_epi16(1) };
+	__m256i Sum{ _mm256_setzero_si256() };
+	for (int i = 0; i < Size; i += 32)
+	{
+		__m256i Products{ _mm256_maddubs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Weights + i))) };
+		Sum = _mm256_add_epi32(Sum, _mm256_madd_epi16(Products, Ones));
+	}
+	// Add the eight int32 values together.
+	__m128i Half{ _mm_add_epi32(_mm256_castsi256_si128(Sum), _mm256_extracti128_si256(Sum, 1)) };
+	Half = _mm_add_epi32(Half, _mm_shuffle_epi32(Half, 0x4E));
+	Half = _mm_add_epi32(Half, _mm_shuffle_epi32(Half, 0xB1));
+	return _mm_cvtsi128_si32(Half);
+}
+
+// Add or subtract a feature column sixteen values at a time.
+AVX2_TARGET void AddColumnAVX2(int16_t* Accumulator, const int16_t* Column)
+{
+	for (int i = 0; i < HalfSize; i += 16)
+	{
+		__m256i* Target{ reinterpret_cast<__m256i*>(Accumulator + i) };
+		_mm256_storeu_si256(Target, _mm256_add_epi16(_mm256_loadu_si256(Target), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Column + i))));
+	}
+}
+AVX2_TARGET void SubtractColumnAVX2(int16_t* Accumulator, const int16_t* Column)
+{
+	for (int i = 0; i < HalfSize; i += 16)
+	{
+		__m256i* Target{ reinterpret_cast<__m256i*>(Accumulator + i) };
+		_mm256_storeu_si256(Target, _mm256_sub_epi16(_mm256_loadu_si256(Target), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Column + i))));
+	}
+}
+
+#else
+
+// Without x86 the AVX2 kernels are just the scalar kernels.
+void ClipAVX2(const int16_t* SideToMove, const int16_t* OtherSide, uint8_t* Output) { ClipScalar(SideToMove, OtherSide, Output); }
+int32_t DotAVX2(const uint8_t* Input, const int8_t* Weights, int Size)              { return DotScalar(Input, Weights, Size); }
+void AddColumnAVX2(int16_t* Accumulator, const int16_t* Column)                      { AddColumnScalar(Accumulator, Column); }
+void SubtractColumnAVX2(int16_t* Accumulator, const int16_t* Column)                 { SubtractColumnScalar(Accumulator, Column); }
+
+#endif
+
+// Non member function to read an array from a binary file.
+template <class T> bool ReadArray(ifstream& File, vector<T>& Array, size_t Size)
+{
+	Array.resize(Size);
+	File.read(reinterpret_cast<char*>(Array.data()), static_cast<streamsize>(Size * sizeof(T)));
+	return static_cast<bool>(File);
+}
+
+// Non member function to write an array to a binary file.
+template <class T> void WriteArray(ofstream& File, const vector<T>& Array)
+{
+	File.write(reinterpret_cast<const char*>(Array.data()), static_cast<streamsize>(Array.size() * sizeof(T)));
+}
+
+// Function to return the feature index of a piece for one side.
+int NeuralNamespace::FeatureIndex(int Perspective, int KingSquare, int Code, int Square)
+{
+
+	// Split the code into a piece type (0 for pawn up to 4 for queen) and a colour (0 for white, 1 for black).
+	int Type{ (Code - 1) % 6 };
+	int Colour{ Code >= BlackPawnCode ? 1 : 0 };
+	// Flip the squares vertically for black.
+	int Flip{ Perspective == 0 ? 0 : 56 };
+
+	// The side's own pieces come before the opponent's pieces of the same type.
+	int PieceIndex{ 2 * Type + (Colour == Perspective ? 0 : 1) };
+	return (KingSquare ^ Flip) * FeaturesPerKing + 1 + PieceIndex * 64 + (Square ^ Flip);
+
+}
+
+// Default constructor. The weights are all zero until a file is loaded.
+NeuralNetwork::NeuralNetwork()
+{
+	FeatureWeights.assign(static_cast<size_t>(NumberOfFeatures) * HalfSize, 0);
+	FeatureBiases.assign(HalfSize, 0);
+	Hidden1Weights.assign(HiddenSize * 2 * HalfSize, 0);
+	Hidden1Biases.assign(HiddenSize, 0);
+	Hidden2Weights.assign(HiddenSize * HiddenSize, 0);
+	Hidden2Biases.assign(HiddenSize, 0);
+	OutputWeights.assign(HiddenSize, 0);
+	OutputBias = 0;
+	UseAVX2 = CpuSupportsAVX2();
+}
+
+// Function to load the weights from a binary file.
+// The file holds a header (magic, version and layer sizes) followed by each layer's biases and weights, little endian.
+bool NeuralNetwork::LoadFromFile(const string& FileName)
+{
+
+	// Open the file.
+	ifstream File(FileName, ios::binary);
+	if (!File.is_open()) { cerr << "Error: Unable to open neural network file " << FileName << "." << endl; return false; }
+
+	// Check the header against the sizes compiled into the program.
+	char Magic[4];
+	uint32_t Header[3];
+	File.read(Magic, 4);
+	File.read(reinterpret_cast<char*>(Header), sizeof(Header));
+	if (!File || !equal(Magic, Magic + 4, NetworkMagic) || Header[0] != NetworkVersion || Header[1] != HalfSize || Header[2] != HiddenSize)
+	{
+		cerr << "Error: " << FileName << " is not a compatible neural network file." << endl;
+		return false;
+	}
+
+	// Read the layers.
+	bool Good{ ReadArray(File, FeatureBiases, HalfSize) && ReadArray(File, FeatureWeights, static_cast<size_t>(NumberOfFeatures) * HalfSize) };
+	Good = Good && ReadArray(File, Hidden1Biases, HiddenSize) && ReadArray(File, Hidden1Weights, HiddenSize * 2 * HalfSize);
+	Good = Good && ReadArray(File, Hidden2Biases, HiddenSize) && ReadArray(File, Hidden2Weights, HiddenSize * HiddenSize);
+	Good = Good && File.read(reinterpret_cast<char*>(&OutputBias), sizeof(OutputBias)) && ReadArray(File, OutputWeights, HiddenSize);
+	if (!Good) { cerr << "Error: " << FileName << " is truncated." << endl; }
+	return Good;
+
+}
+
+// Function to save the weights to a binary file.
+bool NeuralNetwork::SaveToFile(const string& FileName) const
+{
+
+	// Create the file.
+	ofstream File(FileName, ios::binary);
+	if (!File.is_open()) { cerr << "Error: Unable to open " << FileName << " for saving." << endl; return false; }
+
+	// Write the header and then the layers, in the order LoadFromFile reads them.
+	uint32_t Header[3]{ NetworkVersion, static_cast<uint32_t>(HalfSize), static_cast<uint32_t>(HiddenSize) };
+	File.write(NetworkMagic, 4);
+	File.write(reinterpret_cast<const char*>(Header), sizeof(Header));
+	WriteArray(File, FeatureBiases);
+	WriteArray(File, FeatureWeights);
+	WriteArray(File, Hidden1Biases);
+	WriteArray(File, Hidden1Weights);
+	WriteArray(File, Hidden2Biases);
+	WriteArray(File, Hidden2Weights);
+	File.write(reinterpret_cast<const char*>(&OutputBias), sizeof(OutputBias));
+	WriteArray(File, OutputWeights);
+	return static_cast<bool>(File);
+
+}
+
+// Function to fill the network with small random weights.
+void NeuralNetwork::InitialiseRandom(unsigned int Seed)
+{
+
+	// The ranges keep the accumulators and hidden layers mostly inside the clipping range.
+	mt19937 Generator(Seed);
+	uniform_int_distribution<int> Feature(-20, 20), Bias(0, 40), Hidden(-40, 40);
+	for (auto& Weight : FeatureWeights) { Weight = static_cast<int16_t>(Feature(Generator)); }
+	for (auto& Weight : FeatureBiases)  { Weight = static_cast<int16_t>(Bias(Generator)); }
+	for (auto& Weight : Hidden1Weights) { Weight = static_cast<int8_t>(Hidden(Generator)); }
+	for (auto& Weight : Hidden2Weights) { Weight = static_cast<int8_t>(Hidden(Generator)); }
+	for (auto& Weight : OutputWeights)  { Weight = static_cast<int8_t>(Hidden(Generator)); }
+	for (auto& Weight : Hidden1Biases)  { Weight = Bias(Generator) << WeightScaleBits; }
+	for (auto& Weight : Hidden2Biases)  { Weight = Bias(Generator) << WeightScaleBits; }
+	OutputBias = 0;
+
+}
+
+// Access functions.
+const int16_t* NeuralNetwork::GetFeatureColumn(int Feature) const { return FeatureWeights.data() + static_cast<size_t>(Feature) * HalfSize; }
+const int16_t* NeuralNetwork::GetFeatureBiases() const { return FeatureBiases.data(); }
+bool NeuralNetwork::IsUsingAVX2() const { return UseAVX2; }
+
+// Mutator function. AVX2 is only switched on if the processor supports it.
+void NeuralNetwork::SetUseAVX2(bool TrueOrFalse) { UseAVX2 = TrueOrFalse && CpuSupportsAVX2(); }
+
+// Function to return the evaluation in centipawns for the side to move.
+int NeuralNetwork::Evaluate(const int16_t* SideToMove, const int16_t* OtherSide) const
+{
+
+	// Clip both accumulators into one input vector, side to move first.
+	uint8_t Input[2 * HalfSize];
+	if (UseAVX2) { ClipAVX2(SideToMove, OtherSide, Input); }
+	else { ClipScalar(SideToMove, OtherSide, Input); }
+
+	// First hidden layer.
+	uint8_t Hidden1[HiddenSize];
+	for (int r = 0; r < HiddenSize; r++)
+	{
+		const int8_t* Row{ Hidden1Weights.data() + r * 2 * HalfSize };
+		int32_t Sum{ Hidden1Biases[r] + (UseAVX2 ? DotAVX2(Input, Row, 2 * HalfSize) : DotScalar(Input, Row, 2 * HalfSize)) };
+		Hidden1[r] = static_cast<uint8_t>(min(max(Sum >> WeightScaleBits, 0), 127));
+	}
+
+	// Second hidden layer.
+	uint8_t Hidden2[HiddenSize];
+	for (int r = 0; r < HiddenSize; r++)
+	{
+		const int8_t* Row{ Hidden2Weights.data() + r * HiddenSize };
+		int32_t Sum{ Hidden2Biases[r] + (UseAVX2 ? DotAVX2(Hidden1, Row, HiddenSize) : DotScalar(Hidden1, Row, HiddenSize)) };
+		Hidden2[r] = static_cast<uint8_t>(min(max(Sum >> WeightScaleBits, 0), 127));
+	}
+
+	// Output layer.
+	return (OutputBias + DotScalar(Hidden2, OutputWeights.data(), HiddenSize)) / OutputScale;
+
+}
+
+// Parameterised constructor.
+NeuralAccumulator::NeuralAccumulator(shared_ptr<const NeuralNetwork> InputNetwork)
+{
+	Network = InputNetwork;
+	Clear();
+}
+
+// Function to empty the board.
+void NeuralAccumulator::Clear()
+{
+	fill(Mailbox, Mailbox + 64, static_cast<uint8_t>(NoPieceCode));
+	KingSquare[0] = KingSquare[1] = -1;
+	NeedsRefresh[0] = NeedsRefresh[1] = true;
+}
+
+// Functions to add or subtract one feature column.
+void NeuralAccumulator::AddFeature(int Perspective, int Feature)
+{
+	if (Network->IsUsingAVX2()) { AddColumnAVX2(Values[Perspective], Network->GetFeatureColumn(Feature)); }
+	else { AddColumnScalar(Values[Perspective], Network->GetFeatureColumn(Feature)); }
+}
+void NeuralAccumulator::SubtractFeature(int Perspective, int Feature)
+{
+	if (Network->IsUsingAVX2()) { SubtractColumnAVX2(Values[Perspective], Network->GetFeatureColumn(Feature)); }
+	else { SubtractColumnScalar(Values[Perspective], Network->GetFeatureColumn(Feature)); }
+}
+
+// Function to rebuild one side from the mailbox.
+void NeuralAccumulator::Refresh(int Perspective)
+{
+
+	// Start from the biases and add the column of every piece that isn't a king.
+	copy(Network->GetFeatureBiases(), Network->GetFeatureBiases() + HalfSize, Values[Perspective]);
+	for (int Square = 0; Square < 64; Square++)
+	{
+		int Code{ Mailbox[Square] };
+		if (Code != NoPieceCode && Code != WhiteKingCode && Code != BlackKingCode) { AddFeature(Perspective, FeatureIndex(Perspective, KingSquare[Perspective], Code, Square)); }
+	}
+	NeedsRefresh[Perspective] = false;
+
+}
+
+// Function to record a piece being put on a square.
+void NeuralAccumulator::AddPiece(int Code, int Square)
+{
+
+	// Update the mailbox.
+	Mailbox[Square] = static_cast<uint8_t>(Code);
+
+	// A king moving changes every feature of its own side, so that side is rebuilt the next time it is needed.
+	if (Code == WhiteKingCode || Code == BlackKingCode)
+	{
+		int Perspective{ Code == WhiteKingCode ? 0 : 1 };
+		KingSquare[Perspective] = Square;
+		NeedsRefresh[Perspective] = true;
+		return;
+	}
+
+	// Any other piece only adds one column to each side.
+	for (int Perspective = 0; Perspective < 2; Perspective++)
+	{
+		if (!NeedsRefresh[Perspective]) { AddFeature(Perspective, FeatureIndex(Perspective, KingSquare[Perspective], Code, Square)); }
+	}
+
+}
+
+// Function to record a piece being taken off a square.
+void NeuralAccumulator::RemovePiece(int Code, int Square)
+{
+
+	// Update the mailbox.
+	Mailbox[Square] = NoPieceCode;
+
+	// Kings are not features, but their side can't be kept up to date while the king is off the board.
+	if (Code == WhiteKingCode || Code == BlackKingCode)
+	{
+		int Perspective{ Code == WhiteKingCode ? 0 : 1 };
+		if (KingSquare[Perspective] == Square) { KingSquare[Perspective] = -1; }
+		NeedsRefresh[Perspective] = true;
+		return;
+	}
+
+	// Any other piece only subtracts one column from each side.
+	for (int Perspective = 0; Perspective < 2; Perspective++)
+	{
+		if (!NeedsRefresh[Perspective]) { SubtractFeature(Perspective, FeatureIndex(Perspective, KingSquare[Perspective], Code, Square)); }
+	}
+
+}
+
+// Function to return the evaluation in centipawns from white's point of view.
+int NeuralAccumulator::Evaluate(bool WhiteToMove)
+{
+
+	// Without both kings there is nothing sensible to evaluate.
+	if (KingSquare[0] < 0 || KingSquare[1] < 0) { return 0; }
+
+	// Rebuild any side whose king has moved.
+	for (int Perspective = 0; Perspective < 2; Perspective++) { if (NeedsRefresh[Perspective]) { Refresh(Perspective); } }
+
+	// The network scores the position for the side to move.
+	int SideToMove{ WhiteToMove ? 0 : 1 };
+	int Score{ Network->Evaluate(Values[SideToMove], Values[1 - SideToMove]) };
+	return WhiteToMove ? Score : -Score;
+
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+// OOP Chess Project: NeuralEvaluator.h.
+// This is the neural evaluator header file.
+// It contains all the declarations related to the efficiently updatable neural network evaluation.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_NeuralEvaluator
+#define MY_CLASS_NeuralEvaluator
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace NeuralNamespace
+{
+
+	// The sizes of the network.
+	// Each side sees the board as (own king square, piece, square) features: 64 king squares...
+	// times 10 non-king pieces times 64 squares, plus one unused feature per king square.
+	const int FeaturesPerKing{ 10 * 64 + 1 };
+	const int NumberOfFeatures{ 64 * FeaturesPerKing };
+	// The number of accumulator values per side.
+	const int HalfSize{ 256 };
+	// The number of neurons in each of the two hidden layers.
+	const int HiddenSize{ 32 };
+	// The hidden layer outputs are shifted down by this many bits before clipping.
+	const int WeightScaleBits{ 6 };
+	// The final output is divided by this number to give centipawns.
+	const int OutputScale{ 16 };
+
+	// Function to return the feature index of a piece for one side (0 for white, 1 for black).
+	// Squares are flipped vertically for black so that both sides see the board from their own end.
+	int FeatureIndex(int Perspective, int KingSquare, int Code, int Square);
+
+	// NeuralNetwork class holding the quantised weights.
+	// The feature layer uses int16 weights and the hidden layers use int8 weights with int32 biases.
+	class NeuralNetwork {
+
+	// Private member data.
+	private:
+
+		// Feature layer: one column of HalfSize weights per feature.
+		vector<int16_t> FeatureWeights;
+		vector<int16_t> FeatureBiases;
+		// First hidden layer: HiddenSize rows of 2 * HalfSize weights.
+		vector<int8_t>  Hidden1Weights;
+		vector<int32_t> Hidden1Biases;
+		// Second hidden layer: HiddenSize rows of HiddenSize weights.
+		vector<int8_t>  Hidden2Weights;
+		vector<int32_t> Hidden2Biases;
+		// Output layer: a single row of HiddenSize weights.
+		vector<int8_t>  OutputWeights;
+		int32_t OutputBias;
+		// Bool that determines if the AVX2 kernels are used.
+		bool UseAVX2;
+
+	// Public member functions.
+	public:
+
+		// Default constructor. The weights are all zero until a file is loaded.
+		NeuralNetwork();
+		// Destructor.
+		~NeuralNetwork() {}
+
+		// Function to load the weights from a binary file. Returns false if the file is missing or malformed.
+		bool LoadFromFile(const string& FileName);
+
+		// Function to save the weights to a binary file.
+		bool SaveToFile(const string& FileName) const;
+
+		// Function to fill the network with small random weights (useful for benchmarks).
+		void InitialiseRandom(unsigned int Seed);
+
+		// Access functions.
+		const int16_t* GetFeatureColumn(int Feature) const;
+		const int16_t* GetFeatureBiases() const;
+		bool IsUsingAVX2() const;
+
+		// Mutator function. AVX2 is only switched on if the processor supports it.
+		void SetUseAVX2(bool TrueOrFalse);
+
+		// Function to return the evaluation in centipawns for the side to move,
+		// given the accumulators of the side to move and of the other side.
+		int Evaluate(const int16_t* SideToMove, const int16_t* OtherSide) const;
+
+	};
+
+	// NeuralAccumulator class.
+	// It keeps the feature layer output of the current position for both sides and is told about...
+	// every piece that is put on or taken off the board, so that only the changed features are added or removed.
+	class NeuralAccumulator {
+
+	// Private member data.
+	private:
+
+		// The network the accumulator belongs to.
+		shared_ptr<const NeuralNetwork> Network;
+		// The accumulator values of each side.
+		int16_t Values[2][HalfSize];
+		// The piece code on each square, needed when a side has to be rebuilt from scratch.
+		uint8_t Mailbox[64];
+		// The square of each king, or -1 if the king is not on the board.
+		int KingSquare[2];
+		// A side needs rebuilding after its king has moved, since every one of its features changes.
+		bool NeedsRefresh[2];
+
+		// Functions to add or subtract one feature column.
+		void AddFeature(int Perspective, int Feature);
+		void SubtractFeature(int Perspective, int Feature);
+
+		// Function to rebuild one side from the mailbox.
+		void Refresh(int Perspective);
+
+	// Public member functions.
+	public:
+
+		// Parameterised constructor.
+		NeuralAccumulator(shared_ptr<const NeuralNetwork> InputNetwork);
+		// Destructor.
+		~NeuralAccumulator() {}
+
+		// Function to empty the board.
+		void Clear();
+
+		// Functions to record a piece being put on or taken off a square.
+		void AddPiece(int Code, int Square);
+		void RemovePiece(int Code, int Square);
+
+		// Function to return the evaluation in centipawns from white's point of view.
+		int Evaluate(bool WhiteToMove);
+
+	};
+
+}
+
+#endif
\ No newline at end of file
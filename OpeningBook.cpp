@@ -0,0 +1,203 @@
+// OOP Chess Project: OpeningBook.cpp.
+// This is the OpeningBook class source file.
+// It contains all the definitions related to the opening book.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include "OpeningBook.h"
+#include "Zobrist.h"
+
+// Using namespaces.
+using namespace BookNamespace;
+using namespace ZobristNamespace;
+
+// Function to read a number stored with the most significant byte first.
+static uint64_t ReadBigEndian(const uint8_t* Data, int Bytes)
+{
+	uint64_t Value{ 0 };
+	for (int i = 0; i < Bytes; i++) { Value = (Value << 8) | Data[i]; }
+	return Value;
+}
+
+// Function to convert a square into Polyglot's numbering, which counts rows from white's side, and back again.
+// Row zero of the chessboard is black's back row, so the numbering is the same with the rows turned over.
+static int FlipRows(int Square) { return 8 * (7 - Square / 8) + Square % 8; }
+
+// Function to convert a move into how Polyglot stores it.
+uint16_t BookNamespace::ToBookMove(const FENPosition& Position, const PositionMove& Move)
+{
+
+	// A king moving two squares is castling, which Polyglot stores as the king moving onto the rook's square.
+	int From{ Move.From }, To{ Move.To };
+	int Code{ Position.Codes[From] };
+	if ((Code == WhiteKingCode || Code == BlackKingCode) && abs(To - From) == 2) { To = To > From ? From + 3 : From - 4; }
+
+	// Polyglot numbers promotions knight, bishop, rook, queen from one, which is the same order as the piece codes.
+	int Promotion{ Move.Promotion == NoPieceCode ? 0 : (Move.Promotion - 1) % 6 };
+	return static_cast<uint16_t>(FlipRows(To) | (FlipRows(From) << 6) | (Promotion << 12));
+
+}
+
+// Function to find a move stored by Polyglot among the legal moves of a position.
+static bool FindBookMove(const FENPosition& Position, uint16_t BookMove, const PositionMove Legal[], int NumberOfMoves, PositionMove& Move)
+{
+
+	// Undo the numbering, turning a king taking its own rook back into a castling move.
+	int To{ FlipRows(BookMove & 63) }, From{ FlipRows((BookMove >> 6) & 63) }, Promotion{ (BookMove >> 12) & 7 };
+	int Code{ Position.Codes[From] };
+	if (Code == WhiteKingCode && Position.Codes[To] == WhiteRookCode) { To = To > From ? From + 2 : From - 2; }
+	if (Code == BlackKingCode && Position.Codes[To] == BlackRookCode) { To = To > From ? From + 2 : From - 2; }
+
+	// Only accept the move if it is one of the legal moves, so a bad book can't make the computer play an illegal move.
+	for (int i = 0; i < NumberOfMoves; i++)
+	{
+		int LegalPromotion{ Legal[i].Promotion == NoPieceCode ? 0 : (Legal[i].Promotion - 1) % 6 };
+		if (Legal[i].From == From && Legal[i].To == To && LegalPromotion == Promotion) { Move = Legal[i]; return true; }
+	}
+	return false;
+
+}
+
+// Function to convert a move stored by Polyglot into a legal move.
+bool BookNamespace::FromBookMove(const FENPosition& Position, uint16_t BookMove, PositionMove& Move)
+{
+	PositionMove Legal[MaximumMoves];
+	int NumberOfMoves{ GenerateLegalMoves(Position, Legal) };
+	return FindBookMove(Position, BookMove, Legal, NumberOfMoves, Move);
+}
+
+// Default constructor.
+OpeningBook::OpeningBook() { NumberOfEntries = 0; }
+
+// Function to open a book.
+bool OpeningBook::Open(const string& FileName)
+{
+	Close();
+	if (!File.Open(FileName, false)) { return false; }
+	if (File.GetSize() % BookEntrySize != 0)
+	{
+		cerr << "Error: " << FileName << " is not a Polyglot book (its size isn't a whole number of entries)." << endl;
+		Close();
+		return false;
+	}
+	NumberOfEntries = File.GetSize() / BookEntrySize;
+	return true;
+}
+
+// Function to close the book.
+void OpeningBook::Close()
+{
+	File.Close();
+	NumberOfEntries = 0;
+}
+
+// Access functions.
+bool   OpeningBook::IsOpen()             const { return NumberOfEntries > 0; }
+size_t OpeningBook::GetNumberOfEntries() const { return NumberOfEntries; }
+
+// Function to return the key of an entry.
+uint64_t OpeningBook::EntryKey(size_t Entry) const { return ReadBigEndian(File.GetData() + Entry * BookEntrySize, 8); }
+
+// Function to find the book's legal moves in a position.
+int OpeningBook::FindMoves(const FENPosition& Position, PositionMove Moves[], int Weights[]) const
+{
+
+	// Binary search for the first entry with the position's key.
+	if (!IsOpen()) { return 0; }
+	uint64_t Key{ PolyglotKey(Position) };
+	size_t Low{ 0 }, High{ NumberOfEntries };
+	while (Low < High)
+	{
+		size_t Middle{ Low + (High - Low) / 2 };
+		if (EntryKey(Middle) < Key) { Low = Middle + 1; }
+		else { High = Middle; }
+	}
+
+	// The entries with the key follow one another. Any that aren't legal moves are left out.
+	if (Low == NumberOfEntries || EntryKey(Low) != Key) { return 0; }
+	PositionMove Legal[MaximumMoves];
+	int NumberOfLegalMoves{ GenerateLegalMoves(Position, Legal) };
+	int NumberOfMoves{ 0 };
+	for (size_t Entry = Low; Entry < NumberOfEntries && NumberOfMoves < MaximumMoves && EntryKey(Entry) == Key; Entry++)
+	{
+		const uint8_t* Data{ File.GetData() + Entry * BookEntrySize };
+		if (!FindBookMove(Position, static_cast<uint16_t>(ReadBigEndian(Data + 8, 2)), Legal, NumberOfLegalMoves, Moves[NumberOfMoves])) { continue; }
+		Weights[NumberOfMoves++] = static_cast<int>(ReadBigEndian(Data + 10, 2));
+	}
+	return NumberOfMoves;
+
+}
+
+// Function to choose a book move.
+bool OpeningBook::ChooseMove(const FENPosition& Position, bool BestMove, PositionMove& Move) const
+{
+
+	// Find the moves and add up their weights.
+	PositionMove Moves[MaximumMoves];
+	int Weights[MaximumMoves];
+	int NumberOfMoves{ FindMoves(Position, Moves, Weights) };
+	if (NumberOfMoves == 0) { return false; }
+	int Best{ 0 }, Total{ 0 };
+	for (int i = 0; i < NumberOfMoves; i++)
+	{
+		if (Weights[i] > Weights[Best]) { Best = i; }
+		Total += Weights[i];
+	}
+
+	// Either take the heaviest move, or pick a point along the total weight and take the move it falls in.
+	// If every weight is zero, the moves are equally likely.
+	if (BestMove) { Move = Moves[Best]; return true; }
+	if (Total == 0) { Move = Moves[rand() % NumberOfMoves]; return true; }
+	int Pick{ static_cast<int>(static_cast<long long>(rand()) * Total / (static_cast<long long>(RAND_MAX) + 1)) };
+	for (int i = 0; i < NumberOfMoves; i++)
+	{
+		if (Pick < Weights[i]) { Move = Moves[i]; return true; }
+		Pick -= Weights[i];
+	}
+	Move = Moves[NumberOfMoves - 1];
+	return true;
+
+}
+
+// Function to return the book the computer player uses.
+OpeningBook& BookNamespace::ActiveBook()
+{
+	static OpeningBook Book;
+	return Book;
+}
+
+// Function to run "book <book file> <FEN>" from the command line.
+int BookNamespace::RunBook(int argc, char* argv[])
+{
+
+	// Check the arguments and open the book.
+	if (argc < 4) { cerr << "Error: Usage is \"book <book file> <FEN>\"." << endl; return 1; }
+	FENPosition Position;
+	if (!ParseFEN(argv[3], Position)) { cerr << "Error: \"" << argv[3] << "\" is not a valid FEN string: " << FENProblem(argv[3]) << "." << endl; return 1; }
+	OpeningBook Book;
+	if (!Book.Open(argv[2])) { return 1; }
+
+	// Find the moves, timing the search.
+	PositionMove Moves[MaximumMoves];
+	int Weights[MaximumMoves];
+	auto Start = chrono::steady_clock::now();
+	int NumberOfMoves{ Book.FindMoves(Position, Moves, Weights) };
+	double Microseconds{ chrono::duration<double, micro>(chrono::steady_clock::now() - Start).count() };
+
+	// Print them with their share of the total weight.
+	int Total{ 0 };
+	for (int i = 0; i < NumberOfMoves; i++) { Total += Weights[i]; }
+	cout << NumberOfMoves << " book moves among " << Book.GetNumberOfEntries() << " entries (found in " << Microseconds << " microseconds)." << endl;
+	char Text[16];
+	for (int i = 0; i < NumberOfMoves; i++)
+	{
+		WriteSAN(Position, Moves[i], Text);
+		cout << setw(8) << Text << setw(8) << Weights[i] << setw(8) << fixed << setprecision(1) << (Total > 0 ? 100.0 * Weights[i] / Total : 0.0) << "%" << endl;
+	}
+	return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+// OOP Chess Project: OpeningBook.h.
+// This is the OpeningBook class header file.
+// It contains the declarations of the opening book, read from Polyglot book files.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_OpeningBook
+#define MY_CLASS_OpeningBook
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+#include "MappedFile.h"
+#include "MoveGenerator.h"
+
+// Using namespaces.
+using namespace FileNamespace;
+using namespace GeneratorNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace BookNamespace
+{
+
+	// The size of an entry in a Polyglot book: the position key, the move, its weight and four bytes for learning,
+	// all stored with the most significant byte first. The entries are in order of key.
+	const size_t BookEntrySize{ 16 };
+
+	// Functions to convert between a move and how Polyglot stores it: the column and row moved to in the low six bits,
+	// the column and row moved from in the next six, and the promotion piece above them, with rows counted from white's side.
+	// A castling move is stored as the king taking its own rook. Reading returns false if the move isn't legal in the position.
+	uint16_t ToBookMove(const FENPosition& Position, const PositionMove& Move);
+	bool FromBookMove(const FENPosition& Position, uint16_t BookMove, PositionMove& Move);
+
+	// OpeningBook class.
+	// The book file is memory-mapped and searched in place, so opening it costs nothing however big it is,
+	// and finding a move takes a binary search of the entries.
+	class OpeningBook {
+
+	// Private member data.
+	private:
+
+		// The mapped book file.
+		MappedFile File;
+		size_t NumberOfEntries;
+
+		// Function to return the key of an entry.
+		uint64_t EntryKey(size_t Entry) const;
+
+	// Public member functions.
+	public:
+
+		// Default constructor.
+		OpeningBook();
+		// Destructor.
+		~OpeningBook() {}
+
+		// Function to open a book. Returns false if it can't be opened or isn't a whole number of entries.
+		bool Open(const string& FileName);
+
+		// Function to close the book.
+		void Close();
+
+		// Access functions.
+		bool   IsOpen()             const;
+		size_t GetNumberOfEntries() const;
+
+		// Function to fill arrays of at least MaximumMoves moves and weights with the book's legal moves in a position.
+		// Returns the number of moves, which is zero if the position isn't in the book.
+		int FindMoves(const FENPosition& Position, PositionMove Moves[], int Weights[]) const;
+
+		// Function to choose a book move: at random in proportion to the weights, or the move with the highest weight.
+		// Returns false if the position isn't in the book.
+		bool ChooseMove(const FENPosition& Position, bool BestMove, PositionMove& Move) const;
+
+	};
+
+	// Function to return the book the computer player uses. It is closed until a book is opened.
+	OpeningBook& ActiveBook();
+
+	// Function to run "book <book file> <FEN>" from the command line: lists the book moves in a position and how long finding them took.
+	int RunBook(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+// OOP Chess Project: PackedPosition.cpp.
+// This is the packed position source file.
+// It contains the definitions of the fixed-size position record used by the training and tuning data files.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <fstream>
+#include "PackedPosition.h"
+#include "Pieces.h"
+#include "Fen.h"
+
+// Using namespaces.
+using namespace PackedNamespace;
+using namespace PieceNamespace;
+using namespace FenNamespace;
+
+// Function to pack 64 piece codes into a record.
+void PackedNamespace::PackPosition(const uint8_t Codes[64], int Score, int Result, bool WhiteToMove, PackedPosition& Packed)
+{
+	for (int i = 0; i < 32; i++) { Packed.Squares[i] = static_cast<uint8_t>((Codes[2 * i] & 15) | ((Codes[2 * i + 1] & 15) << 4)); }
+	// Scores beyond the range of the record are clamped.
+	Packed.Score = static_cast<int16_t>(Score < -32000 ? -32000 : (Score > 32000 ? 32000 : Score));
+	Packed.Result = static_cast<uint8_t>(Result);
+	Packed.WhiteToMove = WhiteToMove ? 1 : 0;
+}
+
+// Function to unpack a record into 64 piece codes.
+void PackedNamespace::UnpackPosition(const PackedPosition& Packed, uint8_t Codes[64])
+{
+	for (int Square = 0; Square < 64; Square++) { Codes[Square] = static_cast<uint8_t>(PackedSquare(Packed, Square)); }
+}
+
+// Function to read the piece placement and side to move from a FEN string.
+bool PackedNamespace::CodesFromFEN(const string& FEN, uint8_t Codes[64], bool& WhiteToMove)
+{
+
+	// Anything after the FEN string (such as the result) is ignored.
+	FENPosition Position;
+	if (!ParseFEN(FEN.c_str(), Position)) { return false; }
+	for (int Square = 0; Square < 64; Square++) { Codes[Square] = Position.Codes[Square]; }
+	WhiteToMove = Position.WhiteToMove;
+	return true;
+
+}
+
+// Function to convert a text file of "FEN result" lines into a packed data file.
+long long PackedNamespace::ConvertTextPositions(const string& TextFile, const string& PackedFile)
+{
+
+	// Open both files.
+	ifstream Input(TextFile);
+	if (!Input.is_open()) { cerr << "Error: Unable to open " << TextFile << "." << endl; return -1; }
+	ofstream Output(PackedFile, ios::binary);
+	if (!Output.is_open()) { cerr << "Error: Unable to open " << PackedFile << " for saving." << endl; return -1; }
+
+	// Convert one line at a time, skipping any that can't be understood.
+	string Line;
+	long long Written{ 0 }, Skipped{ 0 };
+	while (getline(Input, Line))
+	{
+		// Find the result anywhere after the placement.
+		int Result{ -1 };
+		if (Line.find("1/2-1/2") != string::npos || Line.find("[0.5]") != string::npos) { Result = Draw; }
+		else if (Line.find("1-0") != string::npos || Line.find("[1.0]") != string::npos) { Result = WhiteWin; }
+		else if (Line.find("0-1") != string::npos || Line.find("[0.0]") != string::npos) { Result = BlackWin; }
+
+		uint8_t Codes[64];
+		bool WhiteToMove;
+		if (Result < 0 || !CodesFromFEN(Line, Codes, WhiteToMove)) { Skipped += !Line.empty(); continue; }
+		PackedPosition Packed;
+		PackPosition(Codes, 0, Result, WhiteToMove, Packed);
+		Output.write(reinterpret_cast<const char*>(&Packed), sizeof(Packed));
+		Written++;
+	}
+
+	// Report any lines that were skipped.
+	if (Skipped > 0) { cerr << "Error: " << Skipped << " lines of " << TextFile << " could not be read and were skipped." << endl; }
+	return Written;
+
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+// OOP Chess Project: PackedPosition.h.
+// This is the packed position header file.
+// It contains the declarations of the fixed-size position record used by the training and tuning data files.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_PackedPosition
+#define MY_CLASS_PackedPosition
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace PackedNamespace
+{
+
+	// The result of the game a position was taken from.
+	enum GameResult { BlackWin, Draw, WhiteWin };
+
+	// A position packed into 36 bytes, so that a data file is just an array of these records.
+	// Each square is a 4-bit piece code, two squares to a byte, in the same square order as the chessboard.
+	struct PackedPosition {
+		uint8_t Squares[32];
+		// The score of the position in centipawns from white's point of view (zero if unknown).
+		int16_t Score;
+		// The GameResult of the game.
+		uint8_t Result;
+		// One if white is to move, zero if black is.
+		uint8_t WhiteToMove;
+	};
+	static_assert(sizeof(PackedPosition) == 36, "PackedPosition must be 36 bytes so that data files are portable.");
+
+	// Functions to convert between a packed position and 64 piece codes.
+	void PackPosition(const uint8_t Codes[64], int Score, int Result, bool WhiteToMove, PackedPosition& Packed);
+	void UnpackPosition(const PackedPosition& Packed, uint8_t Codes[64]);
+
+	// Function to return the piece code on one square of a packed position.
+	inline int PackedSquare(const PackedPosition& Packed, int Square) { return (Packed.Squares[Square / 2] >> (4 * (Square % 2))) & 15; }
+
+	// Function to return the result of the game as a score for white: 0, 0.5 or 1.
+	inline double ResultScore(const PackedPosition& Packed) { return 0.5 * Packed.Result; }
+
+	// Function to read the piece placement and side to move from a FEN string.
+	// Returns false if the placement is malformed.
+	bool CodesFromFEN(const string& FEN, uint8_t Codes[64], bool& WhiteToMove);
+
+	// Function to convert a text file of "FEN result" lines into a packed data file.
+	// The result can be written as 1-0, 0-1 or 1/2-1/2, or as [1.0], [0.0] or [0.5].
+	// Returns the number of positions written, or -1 if a file can't be opened.
+	long long ConvertTextPositions(const string& TextFile, const string& PackedFile);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,384 @@
+// OOP Chess Project: Pgn.cpp.
+// This is the PGN source file.
+// It contains the definitions of the streaming reader and the writer of PGN files.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include "Pgn.h"
+#include "MappedFile.h"
+
+// Using namespaces.
+using namespace PgnNamespace;
+using namespace FileNamespace;
+
+// What happened when reading a game.
+enum ParseStatus { GameRead, GameSkipped, NeedMoreData, NoMoreGames };
+
+// Function to check if a character ends a move or other token in the move text.
+static bool EndsToken(char Symbol)
+{
+	return Symbol == ' ' || Symbol == '\t' || Symbol == '\r' || Symbol == '\n' || Symbol == '{' || Symbol == '(' || Symbol == ')' || Symbol == ';' || Symbol == '[';
+}
+
+// Function to read one game starting at Cursor, and move Cursor past it.
+// If the text runs out part of the way through a game and there is more data to come, NeedMoreData is returned and Cursor
+// is left alone, so the game can be read again from the start once the rest has arrived.
+static ParseStatus ParseGame(const char*& Cursor, const char* End, bool AtEndOfData, PgnGame& Game)
+{
+
+	// Start from the standard position, unless a FEN tag says otherwise.
+	Game.Tags.clear();
+	Game.Moves.clear();
+	Game.Result = "*";
+	ParseFEN(StartingFEN, Game.StartingPosition);
+	FENPosition Position{ Game.StartingPosition };
+	bool Valid{ true }, InMoveText{ false }, Started{ false };
+	const char* Text{ Cursor };
+
+	while (true)
+	{
+
+		// Skip the white space between tokens. Running out of text ends the game if there is nothing more to come.
+		while (Text < End && (*Text == ' ' || *Text == '\t' || *Text == '\r' || *Text == '\n')) { Text++; }
+		if (Text >= End)
+		{
+			if (!AtEndOfData) { return NeedMoreData; }
+			break;
+		}
+		char Symbol{ *Text };
+
+		// A tag pair: [Name "Value"]. A tag after the moves is the start of the next game.
+		if (Symbol == '[')
+		{
+			if (InMoveText) { break; }
+			const char* Close{ static_cast<const char*>(memchr(Text, '\n', End - Text)) };
+			if (!Close && !AtEndOfData) { return NeedMoreData; }
+			if (!Close) { Close = End; }
+			const char* NameStart{ Text + 1 };
+			const char* NameEnd{ NameStart };
+			while (NameEnd < Close && *NameEnd != ' ' && *NameEnd != '"' && *NameEnd != ']') { NameEnd++; }
+			const char* Quote{ static_cast<const char*>(memchr(NameEnd, '"', Close - NameEnd)) };
+			string Value;
+			if (Quote)
+			{
+				for (const char* Character = Quote + 1; Character < Close && *Character != '"'; Character++)
+				{
+					if (*Character == '\\' && Character + 1 < Close) { Character++; }
+					Value += *Character;
+				}
+			}
+			Game.Tags.emplace_back(string(NameStart, NameEnd), Value);
+			if (Game.Tags.back().first == "FEN")
+			{
+				Valid = Valid && ParseFEN(Value.c_str(), Game.StartingPosition);
+				Position = Game.StartingPosition;
+			}
+			Started = true;
+			Text = Close;
+			continue;
+		}
+
+		// A comment in braces, or to the end of the line, or an escaped line.
+		if (Symbol == '{' || Symbol == ';' || Symbol == '%')
+		{
+			const char* Close{ static_cast<const char*>(memchr(Text, Symbol == '{' ? '}' : '\n', End - Text)) };
+			if (!Close && !AtEndOfData) { return NeedMoreData; }
+			Text = Close ? Close + 1 : End;
+			continue;
+		}
+
+		// A variation, which may hold comments and further variations.
+		if (Symbol == '(')
+		{
+			int Depth{ 0 };
+			for (; Text < End; Text++)
+			{
+				if (*Text == '{') { const char* Close{ static_cast<const char*>(memchr(Text, '}', End - Text)) }; Text = Close ? Close : End - 1; continue; }
+				if (*Text == '(') { Depth++; }
+				if (*Text == ')' && --Depth == 0) { break; }
+			}
+			if (Text >= End && !AtEndOfData) { return NeedMoreData; }
+			Text = Text < End ? Text + 1 : End;
+			continue;
+		}
+
+		// Any other token runs to the next space or bracket.
+		const char* TokenEnd{ Text };
+		while (TokenEnd < End && !EndsToken(*TokenEnd)) { TokenEnd++; }
+		if (TokenEnd >= End && !AtEndOfData) { return NeedMoreData; }
+		int Length{ static_cast<int>(TokenEnd - Text) };
+		InMoveText = Started = true;
+
+		// The result ends the game.
+		if ((Length == 3 && (memcmp(Text, "1-0", 3) == 0 || memcmp(Text, "0-1", 3) == 0)) || (Length == 7 && memcmp(Text, "1/2-1/2", 7) == 0) || (Length == 1 && Symbol == '*'))
+		{
+			Game.Result.assign(Text, Length);
+			Text = TokenEnd;
+			break;
+		}
+
+		// Move numbers ("12." or "12...") and numeric annotations ("$1") are skipped. A move can follow a number without a space.
+		const char* Move{ Text };
+		if (Symbol == '$') { Move = TokenEnd; }
+		else if (Symbol >= '0' && Symbol <= '9')
+		{
+			const char* Digits{ Text };
+			while (Digits < TokenEnd && *Digits >= '0' && *Digits <= '9') { Digits++; }
+			if (Digits < TokenEnd && *Digits == '.')
+			{
+				while (Digits < TokenEnd && *Digits == '.') { Digits++; }
+				Move = Digits;
+			}
+		}
+		if (Symbol == ')') { Move = TokenEnd; TokenEnd++; }
+
+		// Anything left is a move, which is checked against the position and made.
+		if (Move < TokenEnd && Valid)
+		{
+			PositionMove TheMove;
+			if (ParseSAN(Position, Move, static_cast<int>(TokenEnd - Move), TheMove))
+			{
+				Game.Moves.push_back(TheMove);
+				MakePositionMove(Position, TheMove);
+			}
+			else { Valid = false; }
+		}
+		Text = TokenEnd;
+
+	}
+
+	// The game ended at its result, at the next game's tags or at the end of the text.
+	Cursor = Text;
+	if (!Started) { return NoMoreGames; }
+	return Valid ? GameRead : GameSkipped;
+
+}
+
+// Function to find the first tag of a game at or after Text, so that a file can be split between games.
+// A tag at the start of a line begins a game unless the line before it (ignoring blank lines) is also a tag.
+static const char* FindGameStart(const char* Text, const char* End, const char* FileStart)
+{
+	for (const char* Character = Text; Character < End; Character++)
+	{
+		if (*Character != '[' || (Character != FileStart && Character[-1] != '\n')) { continue; }
+		const char* Before{ Character - 1 };
+		while (Before >= FileStart && (*Before == '\n' || *Before == '\r' || *Before == ' ' || *Before == '\t')) { Before--; }
+		if (Before < FileStart) { return Character; }
+		while (Before > FileStart && Before[-1] != '\n') { Before--; }
+		if (*Before != '[') { return Character; }
+	}
+	return End;
+}
+
+// Function to return the value of a tag.
+string PgnGame::GetTag(const string& Name) const
+{
+	for (const auto& Tag : Tags) { if (Tag.first == Name) { return Tag.second; } }
+	return "";
+}
+
+// Parameterised constructor.
+PgnReader::PgnReader(size_t ChunkSize)
+{
+	Buffer.resize(ChunkSize > 1024 ? ChunkSize : 1024);
+	Begin = End = 0;
+	EndOfFile = true;
+	GamesRead = GamesSkipped = 0;
+}
+
+// Function to open a file.
+bool PgnReader::Open(const string& FileName)
+{
+
+	File.close();
+	File.clear();
+	File.open(FileName, ios::binary);
+	if (!File.is_open()) { cerr << "Error: Unable to open " << FileName << "." << endl; return false; }
+	Begin = End = 0;
+	EndOfFile = false;
+	GamesRead = GamesSkipped = 0;
+
+	// Read the first chunk, skipping the byte order mark some programs put at the start.
+	Refill();
+	if (End - Begin >= 3 && memcmp(&Buffer[Begin], "\xEF\xBB\xBF", 3) == 0) { Begin += 3; }
+	return true;
+
+}
+
+// Function to move the unused part of the buffer to the front and read more of the file after it.
+void PgnReader::Refill()
+{
+
+	// Keep the part that hasn't been used. If it fills the whole buffer, a single game is bigger than a chunk, so the buffer grows.
+	if (Begin > 0)
+	{
+		memmove(Buffer.data(), Buffer.data() + Begin, End - Begin);
+		End -= Begin;
+		Begin = 0;
+	}
+	if (End == Buffer.size()) { Buffer.resize(2 * Buffer.size()); }
+
+	// Read as much as fits.
+	File.read(Buffer.data() + End, static_cast<streamsize>(Buffer.size() - End));
+	size_t Read{ static_cast<size_t>(File.gcount()) };
+	End += Read;
+	if (Read == 0 || File.eof()) { EndOfFile = true; }
+
+}
+
+// Function to read the next game.
+bool PgnReader::ReadGame(PgnGame& Game)
+{
+
+	while (true)
+	{
+		const char* Cursor{ Buffer.data() + Begin };
+		ParseStatus Status{ ParseGame(Cursor, Buffer.data() + End, EndOfFile, Game) };
+		// If the game runs past the end of the buffer, load more of the file and read it again.
+		if (Status == NeedMoreData) { Refill(); continue; }
+		Begin = static_cast<size_t>(Cursor - Buffer.data());
+		if (Status == NoMoreGames) { return false; }
+		if (Status == GameSkipped) { GamesSkipped++; continue; }
+		GamesRead++;
+		return true;
+	}
+
+}
+
+// Access functions.
+long long PgnReader::GetGamesRead()    const { return GamesRead; }
+long long PgnReader::GetGamesSkipped() const { return GamesSkipped; }
+
+// Function to read a PGN file with several threads.
+long long PgnNamespace::ReadPgnFileParallel(const string& FileName, int Threads, const function<void(const PgnGame&, int)>& Process, long long& Skipped)
+{
+
+	// Map the whole file.
+	Skipped = 0;
+	MappedFile File;
+	if (!File.Open(FileName)) { return -1; }
+	const char* Start{ reinterpret_cast<const char*>(File.GetData()) };
+	const char* Stop{ Start + File.GetSize() };
+	if (File.GetSize() == 0) { return 0; }
+	if (Threads < 1) { Threads = 1; }
+
+	// Split the file into equal shares, moving each split forward to the start of a game.
+	vector<const char*> Splits(Threads + 1);
+	Splits[0] = Start;
+	Splits[Threads] = Stop;
+	for (int t = 1; t < Threads; t++)
+	{
+		const char* Guess{ Start + File.GetSize() * t / Threads };
+		Splits[t] = FindGameStart(Guess > Splits[t - 1] ? Guess : Splits[t - 1], Stop, Start);
+	}
+
+	// Read each share on its own thread.
+	atomic<long long> Read{ 0 }, Bad{ 0 };
+	vector<thread> Workers;
+	for (int t = 0; t < Threads; t++)
+	{
+		Workers.emplace_back([&, t]()
+		{
+			PgnGame Game;
+			const char* Cursor{ Splits[t] };
+			long long MyRead{ 0 }, MyBad{ 0 };
+			while (true)
+			{
+				ParseStatus Status{ ParseGame(Cursor, Splits[t + 1], true, Game) };
+				if (Status == NoMoreGames) { break; }
+				if (Status == GameSkipped) { MyBad++; continue; }
+				MyRead++;
+				Process(Game, t);
+			}
+			Read += MyRead;
+			Bad += MyBad;
+		});
+	}
+	for (auto& Worker : Workers) { Worker.join(); }
+	Skipped = Bad;
+	return Read;
+
+}
+
+// Function to write a game in PGN.
+void PgnNamespace::WritePgnGame(ostream& Out, const PgnGame& Game)
+{
+
+	// The tags, with any quotes or backslashes in the values escaped.
+	for (const auto& Tag : Game.Tags)
+	{
+		Out << '[' << Tag.first << " \"";
+		for (char Symbol : Tag.second) { if (Symbol == '"' || Symbol == '\\') { Out << '\\'; } Out << Symbol; }
+		Out << "\"]\n";
+	}
+	Out << '\n';
+
+	// The moves, numbered, with lines kept under 80 characters.
+	FENPosition Position{ Game.StartingPosition };
+	string Line;
+	char Token[32];
+	auto AddToken = [&](const char* Text)
+	{
+		size_t Length{ strlen(Text) };
+		if (!Line.empty() && Line.size() + 1 + Length > 79) { Out << Line << '\n'; Line.clear(); }
+		if (!Line.empty()) { Line += ' '; }
+		Line.append(Text, Length);
+	};
+	for (size_t i = 0; i < Game.Moves.size(); i++)
+	{
+		if (Position.WhiteToMove || i == 0)
+		{
+			snprintf(Token, sizeof(Token), Position.WhiteToMove ? "%d." : "%d...", Position.FullmoveNumber);
+			AddToken(Token);
+		}
+		WriteSAN(Position, Game.Moves[i], Token);
+		AddToken(Token);
+		MakePositionMove(Position, Game.Moves[i]);
+	}
+	AddToken(Game.Result.empty() ? "*" : Game.Result.c_str());
+	Out << Line << "\n\n";
+
+}
+
+// Function to run "pgn <file> [threads]" from the command line.
+int PgnNamespace::RunPgn(int argc, char* argv[])
+{
+
+	// Check the arguments.
+	if (argc < 3) { cerr << "Error: Usage is \"pgn <file> [threads]\"." << endl; return 1; }
+	string FileName{ argv[2] };
+	int Threads{ argc > 3 ? atoi(argv[3]) : 1 };
+
+	// Read every game, counting the moves, either streaming on one thread or mapped and shared between several.
+	long long Games{ 0 }, Skipped{ 0 };
+	atomic<long long> Moves{ 0 };
+	auto Start = chrono::steady_clock::now();
+	if (Threads <= 1)
+	{
+		PgnReader Reader;
+		if (!Reader.Open(FileName)) { return 1; }
+		PgnGame Game;
+		while (Reader.ReadGame(Game)) { Moves += static_cast<long long>(Game.Moves.size()); }
+		Games = Reader.GetGamesRead();
+		Skipped = Reader.GetGamesSkipped();
+	}
+	else
+	{
+		Games = ReadPgnFileParallel(FileName, Threads, [&](const PgnGame& Game, int) { Moves += static_cast<long long>(Game.Moves.size()); }, Skipped);
+		if (Games < 0) { return 1; }
+	}
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+
+	// Report the results.
+	cout << "Read " << Games << " games (" << Moves << " moves) from " << FileName << " in " << fixed << setprecision(2) << Seconds << " seconds"
+		<< " with " << max(Threads, 1) << (Threads > 1 ? " threads" : " thread") << ": " << setprecision(0) << (Seconds > 0 ? Games / Seconds : 0.0) << " games per second." << endl;
+	if (Skipped > 0) { cerr << "Error: " << Skipped << " games had a move or position that couldn't be read and were skipped." << endl; }
+	return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+// OOP Chess Project: Pgn.h.
+// This is the PGN header file.
+// It contains the declarations of the streaming reader and the writer of PGN files, the standard format for recorded games.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Pgn
+#define MY_CLASS_Pgn
+
+// Include the relevant libraries.
+#include <string>
+#include <vector>
+#include <fstream>
+#include <functional>
+#include "Fen.h"
+#include "MoveGenerator.h"
+
+// Using namespaces.
+using namespace FenNamespace;
+using namespace GeneratorNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace PgnNamespace
+{
+
+	// A game read from, or to be written to, a PGN file.
+	struct PgnGame {
+		// The tag pairs, in the order they appear.
+		vector<pair<string, string>> Tags;
+		// The position the game starts from (the FEN tag, if there is one) and the moves from there.
+		FENPosition StartingPosition;
+		vector<PositionMove> Moves;
+		// The result: "1-0", "0-1", "1/2-1/2" or "*".
+		string Result;
+
+		// Function to return the value of a tag, or an empty string if the game doesn't have it.
+		string GetTag(const string& Name) const;
+	};
+
+	// PgnReader class.
+	// The file is read a chunk at a time, so memory use stays the same however large the file is.
+	// A game that runs past the end of a chunk is read again once the rest of it has been loaded.
+	class PgnReader {
+
+	// Private member data.
+	private:
+
+		// The file and the part of it that has been read but not yet used.
+		ifstream File;
+		vector<char> Buffer;
+		size_t Begin, End;
+		bool EndOfFile;
+		// The number of games read, and skipped because a move couldn't be read.
+		long long GamesRead, GamesSkipped;
+
+		// Function to move the unused part of the buffer to the front and read more of the file after it.
+		void Refill();
+
+	// Public member functions.
+	public:
+
+		// Parameterised constructor, with the size of each chunk.
+		PgnReader(size_t ChunkSize = 1 << 20);
+		// Destructor.
+		~PgnReader() {}
+
+		// Function to open a file. Returns false if it can't be opened.
+		bool Open(const string& FileName);
+
+		// Function to read the next game into Game. Returns false when there are no more.
+		// Games with a move that isn't legal (or a FEN tag that can't be read) are skipped.
+		bool ReadGame(PgnGame& Game);
+
+		// Access functions.
+		long long GetGamesRead()    const;
+		long long GetGamesSkipped() const;
+
+	};
+
+	// Function to read a PGN file with several threads. The file is memory-mapped and split into one share per thread,
+	// with each share starting at the beginning of a game. Process is called from the threads, with the thread number.
+	// Returns the number of games read, or -1 if the file can't be opened. Skipped is set to the number of games skipped.
+	long long ReadPgnFileParallel(const string& FileName, int Threads, const function<void(const PgnGame&, int)>& Process, long long& Skipped);
+
+	// Function to write a game in PGN, with its tags, its moves in standard algebraic notation and its result.
+	void WritePgnGame(ostream& Out, const PgnGame& Game);
+
+	// Function to run "pgn <file> [threads]" from the command line: every game is read and checked, and the speed is reported.
+	int RunPgn(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -3,11 +3,13 @@
 // It contains all the definitions related to the Piece class.
 // James Cummins.
 
-// Include the Pieces header file.
+// Include the Pieces and evaluation parameters header files.
 #include "Pieces.h"
+#include "EvalParameters.h"
 
 // Using namespaces.
 using namespace PieceNamespace;
+using namespace ParameterNamespace;
 
 // Default constructor.
 Piece::Piece()
@@ -172,15 +174,8 @@ MoveType Pawn::TypeOfMove(int NewX, int NewY) const
 // Pawn position evaluation function.
 vector<vector<double>> Pawn::PositionEvaluation() const
 {
-	// Return the 8x8 pawn position evaluation vector.
-	return { {0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0 },
-	{5.0,  5.0,  5.0,  5.0,  5.0,  5.0,  5.0,  5.0},
-	{1.0,  1.0,  2.0,  3.0,  3.0,  2.0,  1.0,  1.0},
-	{0.5,  0.5,  1.0,  2.5,  2.5,  1.0,  0.5,  0.5},
-	{0.0,  0.0,  0.0,  2.0,  2.0,  0.0,  0.0,  0.0},
-	{0.5, -0.5, -1.0,  0.0,  0.0, -1.0, -0.5,  0.5},
-	{0.5,  1.0, 1.0,  -2.0, -2.0,  1.0,  1.0,  0.5},
-	{0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0} };
+	// Return the 8x8 pawn position evaluation vector from the active evaluation parameters.
+	return PositionTableVector(PawnType);
 }
 
 // Default constructor.
@@ -191,7 +186,7 @@ WhitePawn::WhitePawn(Point InputPoint) : Pawn(InputPoint, "White", 'P') {};
 WhitePawn::WhitePawn(int InputX, int InputY) : Pawn(Point(InputX, InputY), "White", 'P') {};
 
 // WhitePawn get value function.
-double WhitePawn::GetValue() const { return  10.0; }
+double WhitePawn::GetValue() const { return  ActiveParameters().PieceValues[PawnType]; }
 
 // Default constructor.
 BlackPawn::BlackPawn() : Pawn() {}
@@ -201,7 +196,7 @@ BlackPawn::BlackPawn(Point InputPoint) : Pawn(InputPoint, "Black", 'p') {};
 BlackPawn::BlackPawn(int InputX, int InputY) : Pawn(Point(InputX, InputY), "Black", 'p') {};
 
 // BlackPawn get value function.
-double BlackPawn::GetValue() const { return -10.0; }
+double BlackPawn::GetValue() const { return -ActiveParameters().PieceValues[PawnType]; }
 
 // Default constructor.
 King::King() : Piece() {}
@@ -228,15 +223,8 @@ MoveType King::TypeOfMove(int NewX, int NewY) const
 // King position evaluation function.
 vector<vector<double>> King::PositionEvaluation() const
 {
-	// Return the 8x8 king position evaluation vector.
-	return { {-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
-	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
-	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
-	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
-	{-2.0, -3.0, -3.0, -4.0, -4.0, -3.0, -3.0, -2.0},
-	{-1.0, -2.0, -2.0, -2.0, -2.0, -2.0, -2.0, -1.0},
-	{2.0,  2.0,  0.0,  0.0,  0.0,  0.0,  2.0,  2.0},
-	{2.0,  3.0,  1.0,  0.0,  0.0,  1.0,  3.0,  2.0} };
+	// Return the 8x8 king position evaluation vector from the active evaluation parameters.
+	return PositionTableVector(KingType);
 }
 
 // Default constructor.
@@ -247,7 +235,7 @@ WhiteKing::WhiteKing(Point InputPoint) : King(InputPoint, "White", 'K') {};
 WhiteKing::WhiteKing(int InputX, int InputY) : King(Point(InputX, InputY), "White", 'K') {};
 
 // WhiteKing get value function.
-double WhiteKing::GetValue() const { return  900.0; }
+double WhiteKing::GetValue() const { return  ActiveParameters().PieceValues[KingType]; }
 
 // Default constructor.
 BlackKing::BlackKing() : King() {}
@@ -257,7 +245,7 @@ BlackKing::BlackKing(Point InputPoint) : King(InputPoint, "Black", 'k') {};
 BlackKing::BlackKing(int InputX, int InputY) : King(Point(InputX, InputY), "Black", 'k') {};
 
 // BlackKing get value function.
-double BlackKing::GetValue() const { return -900.0; }
+double BlackKing::GetValue() const { return -ActiveParameters().PieceValues[KingType]; }
 
 // Default constructor.
 Queen::Queen() : Piece() {}
@@ -293,15 +281,8 @@ MoveType Queen::TypeOfMove(int NewX, int NewY) const
 // Queen position evaluation function.
 vector<vector<double>> Queen::PositionEvaluation() const
 {
-	// Return the 8x8 queen position evaluation vector.
-	return { {-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0},
-	{-1.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -1.0},
-	{-1.0,  0.0,  0.5,  0.5,  0.5,  0.5,  0.0, -1.0},
-	{-0.5,  0.0,  0.5,  0.5,  0.5,  0.5,  0.0, -0.5},
-	{0.0,  0.0,  0.5,  0.5,  0.5,  0.5,  0.0, -0.5},
-	{-1.0,  0.5,  0.5,  0.5,  0.5,  0.5,  0.0, -1.0},
-	{-1.0,  0.0,  0.5,  0.0,  0.0,  0.0,  0.0, -1.0},
-	{-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0} };
+	// Return the 8x8 queen position evaluation vector from the active evaluation parameters.
+	return PositionTableVector(QueenType);
 }
 
 // Default constructor.
@@ -312,7 +293,7 @@ WhiteQueen::WhiteQueen(Point InputPoint) : Queen(InputPoint, "White", 'Q') {};
 WhiteQueen::WhiteQueen(int InputX, int InputY) : Queen(Point(InputX, InputY), "White", 'Q') {};
 
 // WhiteQueen get value function.
-double WhiteQueen::GetValue() const { return  90.0; }
+double WhiteQueen::GetValue() const { return  ActiveParameters().PieceValues[QueenType]; }
 
 // Default constructor.
 BlackQueen::BlackQueen() : Queen() {}
@@ -322,7 +303,7 @@ BlackQueen::BlackQueen(Point InputPoint) : Queen(InputPoint, "Black", 'q') {};
 BlackQueen::BlackQueen(int InputX, int InputY) : Queen(Point(InputX, InputY), "Black", 'q') {};
 
 // BlackQueen get value function.
-double BlackQueen::GetValue() const { return -90.0; }
+double BlackQueen::GetValue() const { return -ActiveParameters().PieceValues[QueenType]; }
 
 // Default constructor.
 Rook::Rook() : Piece() {}
@@ -350,15 +331,8 @@ MoveType Rook::TypeOfMove(int NewX, int NewY) const
 // Rook position evaluation function.
 vector<vector<double>> Rook::PositionEvaluation() const
 {
-	// Return the 8x8 rook position evaluation vector.
-	return { {0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0},
-	{0.5,  1.0,  1.0,  1.0,  1.0,  1.0,  1.0,  0.5},
-	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
-	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
-	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
-	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
-	{-0.5,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -0.5},
-	{0.0,   0.0, 0.0,  0.5,  0.5,  0.0,  0.0,  0.0} };
+	// Return the 8x8 rook position evaluation vector from the active evaluation parameters.
+	return PositionTableVector(RookType);
 }
 
 // Default constructor.
@@ -369,7 +343,7 @@ WhiteRook::WhiteRook(Point InputPoint) : Rook(InputPoint, "White", 'R') {};
 WhiteRook::WhiteRook(int InputX, int InputY) : Rook(Point(InputX, InputY), "White", 'R') {};
 
 // WhiteRook get value function.
-double WhiteRook::GetValue() const { return  50.0; }
+double WhiteRook::GetValue() const { return  ActiveParameters().PieceValues[RookType]; }
 
 // Default constructor.
 BlackRook::BlackRook() : Rook() {}
@@ -379,7 +353,7 @@ BlackRook::BlackRook(Point InputPoint) : Rook(InputPoint, "Black", 'r') {};
 BlackRook::BlackRook(int InputX, int InputY) : Rook(Point(InputX, InputY), "Black", 'r') {};
 
 // BlackRook get value function.
-double BlackRook::GetValue() const { return -50.0; }
+double BlackRook::GetValue() const { return -ActiveParameters().PieceValues[RookType]; }
 
 // Default constructor.
 Bishop::Bishop() : Piece() {}
@@ -409,15 +383,8 @@ MoveType Bishop::TypeOfMove(int NewX, int NewY) const
 // Bishop position evaluation function.
 vector<vector<double>> Bishop::PositionEvaluation() const
 {
-	// Return the 8x8 bishop position evaluation vector.
-	return { {-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0 },
-	{-1.0,  0.0,  0.0,  0.0,  0.0,  0.0,  0.0, -1.0},
-	{-1.0,  0.0,  0.5,  1.0,  1.0,  0.5,  0.0, -1.0},
-	{-1.0,  0.5,  0.5,  1.0,  1.0,  0.5,  0.5, -1.0},
-	{-1.0,  0.0,  1.0,  1.0,  1.0,  1.0,  0.0, -1.0},
-	{-1.0,  1.0,  1.0,  1.0,  1.0,  1.0,  1.0, -1.0},
-	{-1.0,  0.5,  0.0,  0.0,  0.0,  0.0,  0.5, -1.0},
-	{-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0} };
+	// Return the 8x8 bishop position evaluation vector from the active evaluation parameters.
+	return PositionTableVector(BishopType);
 }
 
 // Default constructor.
@@ -428,7 +395,7 @@ WhiteBishop::WhiteBishop(Point InputPoint) : Bishop(InputPoint, "White", 'B') {}
 WhiteBishop::WhiteBishop(int InputX, int InputY) : Bishop(Point(InputX, InputY), "White", 'B') {};
 
 // WhiteBishop get value function.
-double WhiteBishop::GetValue() const { return  30.0; }
+double WhiteBishop::GetValue() const { return  ActiveParameters().PieceValues[BishopType]; }
 
 // Default constructor.
 BlackBishop::BlackBishop() : Bishop() {}
@@ -438,7 +405,7 @@ BlackBishop::BlackBishop(Point InputPoint) : Bishop(InputPoint, "Black", 'b') {}
 BlackBishop::BlackBishop(int InputX, int InputY) : Bishop(Point(InputX, InputY), "Black", 'b') {};
 
 // BlackBishop get value function.
-double BlackBishop::GetValue() const { return -30.0; }
+double BlackBishop::GetValue() const { return -ActiveParameters().PieceValues[BishopType]; }
 
 // Default constructor.
 Knight::Knight() : Piece() {}
@@ -466,15 +433,8 @@ MoveType Knight::TypeOfMove(int NewX, int NewY) const
 // King position evaluation function.
 vector<vector<double>> Knight::PositionEvaluation() const
 {
-	// Return the 8x8 knight position evaluation vector.
-	return { {-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0},
-	{-4.0, -2.0,  0.0,  0.0,  0.0,  0.0, -2.0, -4.0},
-	{-3.0,  0.0,  1.0,  1.5,  1.5,  1.0,  0.0, -3.0},
-	{-3.0,  0.5,  1.5,  2.0,  2.0,  1.5,  0.5, -3.0},
-	{-3.0,  0.0,  1.5,  2.0,  2.0,  1.5,  0.0, -3.0},
-	{-3.0,  0.5,  1.0,  1.5,  1.5,  1.0,  0.5, -3.0},
-	{-4.0, -2.0,  0.0,  0.5,  0.5,  0.0, -2.0, -4.0},
-	{-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0} };
+	// Return the 8x8 knight position evaluation vector from the active evaluation parameters.
+	return PositionTableVector(KnightType);
 }
 
 // Default constructor.
@@ -485,7 +445,7 @@ WhiteKnight::WhiteKnight(Point InputPoint) : Knight(InputPoint, "White", 'N') {}
 WhiteKnight::WhiteKnight(int InputX, int InputY) : Knight(Point(InputX, InputY), "White", 'N') {};
 
 // WhiteKnight get value function.
-double WhiteKnight::GetValue() const { return  30.0; }
+double WhiteKnight::GetValue() const { return  ActiveParameters().PieceValues[KnightType]; }
 
 // Default constructor.
 BlackKnight::BlackKnight() : Knight() {}
@@ -495,4 +455,61 @@ BlackKnight::BlackKnight(Point InputPoint) : Knight(InputPoint, "Black", 'n') {}
 BlackKnight::BlackKnight(int InputX, int InputY) : Knight(Point(InputX, InputY), "Black", 'n') {};
 
 // BlackKnight get value function.
-double BlackKnight::GetValue() const { return -30.0; }
\ No newline at end of file
+double BlackKnight::GetValue() const { return -ActiveParameters().PieceValues[KnightType]; }
+
+// Non member function to return the piece code of a piece symbol.
+int PieceNamespace::SymbolToPieceCode(char Symbol)
+{
+
+	// A switch is used because this is called every time a square of the board changes.
+	switch (Symbol) {
+	case 'P': return WhitePawnCode;
+	case 'N': return WhiteKnightCode;
+	case 'B': return WhiteBishopCode;
+	case 'R': return WhiteRookCode;
+	case 'Q': return WhiteQueenCode;
+	case 'K': return WhiteKingCode;
+	case 'p': return BlackPawnCode;
+	case 'n': return BlackKnightCode;
+	case 'b': return BlackBishopCode;
+	case 'r': return BlackRookCode;
+	case 'q': return BlackQueenCode;
+	case 'k': return BlackKingCode;
+	// If the symbol is not recognised, return the empty square code.
+	default:  return NoPieceCode;
+	}
+
+}
+
+// Non member function to return the piece symbol of a piece code.
+char PieceNamespace::PieceCodeToSymbol(int Code)
+{
+
+	// Empty squares (and anything out of range) are represented by a space.
+	if (Code <= NoPieceCode || Code >= NumberOfPieceCodes) { return ' '; }
+	return "PNBRQKpnbrqk"[Code - 1];
+
+}
+
+// Non member function to create a new piece from its piece code.
+shared_ptr<Piece> PieceNamespace::MakePiece(int Code, int InputX, int InputY)
+{
+
+	// Return the matching derived piece, or a null pointer for an empty square.
+	switch (Code) {
+	case WhitePawnCode:   return make_shared<WhitePawn>(InputX, InputY);
+	case WhiteKnightCode: return make_shared<WhiteKnight>(InputX, InputY);
+	case WhiteBishopCode: return make_shared<WhiteBishop>(InputX, InputY);
+	case WhiteRookCode:   return make_shared<WhiteRook>(InputX, InputY);
+	case WhiteQueenCode:  return make_shared<WhiteQueen>(InputX, InputY);
+	case WhiteKingCode:   return make_shared<WhiteKing>(InputX, InputY);
+	case BlackPawnCode:   return make_shared<BlackPawn>(InputX, InputY);
+	case BlackKnightCode: return make_shared<BlackKnight>(InputX, InputY);
+	case BlackBishopCode: return make_shared<BlackBishop>(InputX, InputY);
+	case BlackRookCode:   return make_shared<BlackRook>(InputX, InputY);
+	case BlackQueenCode:  return make_shared<BlackQueen>(InputX, InputY);
+	case BlackKingCode:   return make_shared<BlackKing>(InputX, InputY);
+	default:              return nullptr;
+	}
+
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 // Include the relevant libraries.
 #include <string>
 #include <vector>
+#include <memory>
 #include "Point.h"
 
 // Using namespaces.
@@ -41,6 +42,25 @@ namespace PieceNamespace
 		Illegal       // Applies to all pieces.
 	};
 
+	// Compact integer codes for the pieces, used wherever a whole position needs to be stored cheaply.
+	// Zero represents an empty square.
+	enum PieceCode {
+		NoPieceCode,      // Empty square.
+		WhitePawnCode,    // White pieces.
+		WhiteKnightCode,  //         "
+		WhiteBishopCode,  //         "
+		WhiteRookCode,    //         "
+		WhiteQueenCode,   //         "
+		WhiteKingCode,    //         "
+		BlackPawnCode,    // Black pieces.
+		BlackKnightCode,  //         "
+		BlackBishopCode,  //         "
+		BlackRookCode,    //         "
+		BlackQueenCode,   //         "
+		BlackKingCode,    //         "
+		NumberOfPieceCodes
+	};
+
 	// Virtual Piece class.
 	class Piece {
 
@@ -450,6 +470,15 @@ namespace PieceNamespace
 
 	};
 
+	// Non member function to return the piece code of a piece symbol (e.g. 'P' or 'k').
+	int SymbolToPieceCode(char Symbol);
+
+	// Non member function to return the piece symbol of a piece code.
+	char PieceCodeToSymbol(int Code);
+
+	// Non member function to create a new piece from its piece code.
+	shared_ptr<Piece> MakePiece(int Code, int InputX, int InputY);
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,261 @@
+// OOP Chess Project: Renderer.cpp.
+// This is the renderer source file.
+// It contains all the definitions related to drawing the chessboard on the console.
+// James Cummins.
+
+// Include the relevant header files and the operating system headers.
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include "Renderer.h"
+#include "Pieces.h"
+#if defined(_WIN32)
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#else
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+// Using namespaces.
+using namespace RenderNamespace;
+using namespace PieceNamespace;
+
+// Function to return the backend in use, found the first time it is asked for.
+static ConsoleBackend& CurrentBackend()
+{
+	static ConsoleBackend Backend{ DetectConsoleBackend() };
+	return Backend;
+}
+
+// Functions to choose the backend.
+void RenderNamespace::SetConsoleBackend(ConsoleBackend Backend) { CurrentBackend() = Backend; }
+ConsoleBackend RenderNamespace::GetConsoleBackend() { return CurrentBackend(); }
+
+// Function to find the best backend for the standard output.
+ConsoleBackend RenderNamespace::DetectConsoleBackend()
+{
+#if defined(_WIN32)
+	HANDLE Output{ GetStdHandle(STD_OUTPUT_HANDLE) };
+	DWORD Mode;
+	if (!GetConsoleMode(Output, &Mode)) { return PlainBackend; }
+	if (SetConsoleMode(Output, Mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING)) { return AnsiBackend; }
+	return WindowsBackend;
+#else
+	return isatty(STDOUT_FILENO) ? AnsiBackend : PlainBackend;
+#endif
+}
+
+// Function to add text to a frame.
+static char* Append(char* Cursor, const char* Text)
+{
+	size_t Length{ strlen(Text) };
+	memcpy(Cursor, Text, Length);
+	return Cursor + Length;
+}
+
+// Function to write the escape code for a colour into a buffer of at least 16 characters. The Windows console numbers colours
+// with blue as 1, green as 2 and red as 4, where ANSI has them the other way round, so the bits are turned over.
+static void WriteColourCode(int Foreground, int Background, char Code[])
+{
+	auto AnsiColour = [](int Colour) { return ((Colour & 1) << 2) | (Colour & 2) | ((Colour & 4) >> 2); };
+	snprintf(Code, 16, "\x1b[%d;%dm", (Foreground & 8 ? 90 : 30) + AnsiColour(Foreground), (Background & 8 ? 100 : 40) + AnsiColour(Background));
+}
+
+// The last board drawn on the screen, for incremental drawing. The screen is shared, so so is this.
+struct ScreenBoard {
+	bool Incremental, Drawn;
+	uint8_t Codes[64];
+	int Foreground, Background;
+};
+static ScreenBoard Screen{ false, false, {}, 15, 0 };
+static mutex ScreenLock;
+
+// Functions to switch incremental drawing on or off.
+void RenderNamespace::SetIncrementalDrawing(bool On)
+{
+	lock_guard<mutex> Lock(ScreenLock);
+	Screen.Incremental = On;
+	Screen.Drawn = false;
+}
+bool RenderNamespace::GetIncrementalDrawing()
+{
+	lock_guard<mutex> Lock(ScreenLock);
+	return Screen.Incremental;
+}
+
+// Function to return the number of lines the console window has, or 0 if it isn't known.
+static int ConsoleLines()
+{
+#if defined(_WIN32)
+	CONSOLE_SCREEN_BUFFER_INFO Information;
+	if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &Information)) { return 0; }
+	return Information.srWindow.Bottom - Information.srWindow.Top + 1;
+#else
+	winsize Size;
+	if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &Size) != 0) { return 0; }
+	return Size.ws_row;
+#endif
+}
+
+// Function to give the screen back its whole height for scrolling, and put the cursor at the bottom, when the program ends.
+static void ReleaseScreen() { cout << "\x1b[r\x1b[999;1H" << endl; }
+
+// Function to compose a frame of the board.
+size_t RenderNamespace::ComposeBoardFrame(const uint8_t Codes[64], int Foreground, int Background, ConsoleBackend Backend, char Frame[])
+{
+
+	// The layout is the one the board has always been printed in: labelled columns and rows, and squares three lines high.
+	// The two colour codes are worked out once, and copied in where they are needed.
+	const char* Labels{ "        a     b     c     d     e     f     g     h   " };
+	bool Colour{ Backend != PlainBackend };
+	char Normal[16] = "", Highlight[16] = "";
+	if (Colour)
+	{
+		WriteColourCode(Foreground, Background, Normal);
+		WriteColourCode(0, 15, Highlight);
+	}
+	char* Cursor{ Frame };
+	Cursor = Append(Cursor, Normal);
+	*Cursor++ = '\n';
+	Cursor = Append(Cursor, Labels);
+	Cursor = Append(Cursor, "\n      _____ _____ _____ _____ _____ _____ _____ _____ ");
+	for (int i = 0; i < 8; i++)
+	{
+		Cursor = Append(Cursor, "\n     |     |     |     |     |     |     |     |     |\n  ");
+		*Cursor++ = static_cast<char>('8' - i);
+		Cursor = Append(Cursor, "  ");
+		for (int j = 0; j < 8; j++)
+		{
+			// White pieces are picked out in black on white.
+			int Code{ Codes[8 * i + j] };
+			Cursor = Append(Cursor, "|  ");
+			bool White{ Code >= WhitePawnCode && Code <= WhiteKingCode };
+			if (White) { Cursor = Append(Cursor, Highlight); }
+			*Cursor++ = PieceCodeToSymbol(Code);
+			if (White) { Cursor = Append(Cursor, Normal); }
+			Cursor = Append(Cursor, "  ");
+		}
+		Cursor = Append(Cursor, "|  ");
+		*Cursor++ = static_cast<char>('8' - i);
+		Cursor = Append(Cursor, "\n     |_____|_____|_____|_____|_____|_____|_____|_____|");
+	}
+	Cursor = Append(Cursor, "\n\n");
+	Cursor = Append(Cursor, Labels);
+	if (Colour) { Cursor = Append(Cursor, "\x1b[0m"); }
+	*Cursor++ = '\n';
+	return static_cast<size_t>(Cursor - Frame);
+
+}
+
+// Function to compose the update from one position of the board to another.
+size_t RenderNamespace::ComposeBoardUpdate(const uint8_t Previous[64], const uint8_t Codes[64], int Foreground, int Background, char Frame[])
+{
+
+	// Save the cursor and its colours, so the text below carries on as it was.
+	char Normal[16], Highlight[16];
+	WriteColourCode(Foreground, Background, Normal);
+	WriteColourCode(0, 15, Highlight);
+	char* Cursor{ Frame };
+	for (int Square = 0; Square < 64; Square++)
+	{
+		// The piece on row i and column j of the board is on screen line 5 + 3i, in column 9 + 6j.
+		int Code{ Codes[Square] };
+		if (Code == Previous[Square]) { continue; }
+		if (Cursor == Frame) { Cursor = Append(Cursor, "\x1b" "7"); }
+		Cursor += snprintf(Cursor, 16, "\x1b[%d;%dH", 5 + 3 * (Square / 8), 9 + 6 * (Square % 8));
+		Cursor = Append(Cursor, Code >= WhitePawnCode && Code <= WhiteKingCode ? Highlight : Normal);
+		*Cursor++ = PieceCodeToSymbol(Code);
+	}
+	if (Cursor != Frame) { Cursor = Append(Cursor, "\x1b" "8"); }
+	return static_cast<size_t>(Cursor - Frame);
+
+}
+
+#if defined(_WIN32)
+// Function to write a frame on an older Windows console, changing the colours with console calls where the escape codes are.
+// Only the codes ComposeBoardFrame writes are understood: a foreground and background colour, or 0 to go back to how the console was.
+static void WriteWindowsFrame(const char Frame[], size_t Length)
+{
+	HANDLE Output{ GetStdHandle(STD_OUTPUT_HANDLE) };
+	CONSOLE_SCREEN_BUFFER_INFO Information;
+	WORD Original{ static_cast<WORD>(GetConsoleScreenBufferInfo(Output, &Information) ? Information.wAttributes : 15) };
+	auto WindowsColour = [](int Code) { return ((Code & 1) << 2) | (Code & 2) | ((Code & 4) >> 2); };
+	size_t Start{ 0 };
+	for (size_t i = 0; i <= Length; i++)
+	{
+		if (i < Length && Frame[i] != '\x1b') { continue; }
+		cout.write(Frame + Start, static_cast<streamsize>(i - Start)).flush();
+		if (i == Length) { break; }
+
+		// Read the numbers of the code up to its 'm'.
+		WORD Attribute{ 0 };
+		size_t End{ i + 2 };
+		int Number{ 0 };
+		for (; End < Length && Frame[End] != 'm'; End++)
+		{
+			if (Frame[End] >= '0' && Frame[End] <= '9') { Number = 10 * Number + (Frame[End] - '0'); continue; }
+			if (Number >= 90) { Attribute |= static_cast<WORD>(8 | WindowsColour(Number - 90)); }
+			else if (Number >= 30 && Number < 40) { Attribute |= static_cast<WORD>(WindowsColour(Number - 30)); }
+			Number = 0;
+		}
+		if (Number >= 100) { Attribute |= static_cast<WORD>((8 | WindowsColour(Number - 100)) << 4); }
+		else if (Number >= 40) { Attribute |= static_cast<WORD>(WindowsColour(Number - 40) << 4); }
+		SetConsoleTextAttribute(Output, Number == 0 ? Original : Attribute);
+		i = End;
+		Start = End + 1;
+	}
+}
+#endif
+
+// Function to write a frame to the standard output in one go.
+void RenderNamespace::WriteFrame(const char Frame[], size_t Length, ConsoleBackend Backend)
+{
+#if defined(_WIN32)
+	if (Backend == WindowsBackend) { WriteWindowsFrame(Frame, Length); return; }
+#else
+	(void)Backend;
+#endif
+	cout.write(Frame, static_cast<streamsize>(Length)).flush();
+}
+
+// Function to compose a frame of the board and write it.
+void RenderNamespace::DrawBoard(const uint8_t Codes[64], int Foreground, int Background)
+{
+
+	thread_local char Frame[MaximumFrameLength];
+	ConsoleBackend Backend{ GetConsoleBackend() };
+
+	// Incremental drawing needs escape codes and a window tall enough for the board and a few lines of text.
+	// Otherwise the whole frame is written where the cursor is, as it always was.
+	unique_lock<mutex> Lock(ScreenLock);
+	if (!Screen.Incremental || Backend != AnsiBackend || ConsoleLines() < BoardScreenLines + 4)
+	{
+		Lock.unlock();
+		WriteFrame(Frame, ComposeBoardFrame(Codes, Foreground, Background, Backend, Frame), Backend);
+		return;
+	}
+
+	// The first time, or after the colours change, clear the screen and draw the whole board at the top. The lines below it are
+	// then made the only ones that scroll, so the board stays where it is and its squares can be found again.
+	size_t Length;
+	if (!Screen.Drawn || Foreground != Screen.Foreground || Background != Screen.Background)
+	{
+		char* Cursor{ Append(Frame, "\x1b[H\x1b[2J") };
+		Cursor += ComposeBoardFrame(Codes, Foreground, Background, Backend, Cursor);
+		Cursor += snprintf(Cursor, 32, "\x1b[%dr\x1b[%d;1H", BoardScreenLines + 1, BoardScreenLines + 1);
+		Length = static_cast<size_t>(Cursor - Frame);
+		if (!Screen.Drawn) { atexit(ReleaseScreen); }
+		Screen.Drawn = true;
+		Screen.Foreground = Foreground;
+		Screen.Background = Background;
+	}
+	else { Length = ComposeBoardUpdate(Screen.Codes, Codes, Foreground, Background, Frame); }
+	memcpy(Screen.Codes, Codes, 64);
+	WriteFrame(Frame, Length, Backend);
+
+}
\ No newline at end of file
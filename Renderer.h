@@ -0,0 +1,66 @@
+// OOP Chess Project: Renderer.h.
+// This is the renderer header file.
+// It contains the declarations of the functions that draw the chessboard on the console.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Renderer
+#define MY_CLASS_Renderer
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <cstddef>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace RenderNamespace
+{
+
+	// The ways colours can be sent to the console: ANSI escape codes, which every terminal (and Windows 10 onwards) understands,
+	// calls to the Windows console for older Windows consoles, or no colour at all when the output isn't a console.
+	enum ConsoleBackend { AnsiBackend, WindowsBackend, PlainBackend };
+
+	// Functions to choose the backend. It starts as the one DetectConsoleBackend finds.
+	void SetConsoleBackend(ConsoleBackend Backend);
+	ConsoleBackend GetConsoleBackend();
+
+	// Function to find the best backend for the standard output: ANSI on a terminal, plain if the output is redirected,
+	// and on Windows the console calls if the console can't be switched to understanding ANSI escape codes.
+	ConsoleBackend DetectConsoleBackend();
+
+	// The longest a frame of the board can be, escape codes and all.
+	const size_t MaximumFrameLength{ 4096 };
+
+	// Function to compose a frame of the board, from its piece codes, into a buffer of at least MaximumFrameLength characters.
+	// Colours are numbered as the Windows console numbers them (0 black to 15 bright white, with 8 added for bright colours).
+	// The board is drawn in the given colours, with white pieces in black on bright white. Returns the length of the frame.
+	size_t ComposeBoardFrame(const uint8_t Codes[64], int Foreground, int Background, ConsoleBackend Backend, char Frame[]);
+
+	// Function to write a frame to the standard output in one go. With the Windows backend the escape codes in it are turned
+	// into console calls.
+	void WriteFrame(const char Frame[], size_t Length, ConsoleBackend Backend);
+
+	// Functions to switch incremental drawing on or off. When it is on and the console understands ANSI escape codes, the board is drawn
+	// once at the top of the screen with everything else scrolling beneath it, and after that only the squares that have changed are
+	// written, at their places on the screen. A move then sends a few dozen bytes instead of a whole frame.
+	void SetIncrementalDrawing(bool On);
+	bool GetIncrementalDrawing();
+
+	// The screen lines the board takes up when it is drawn at the top of the screen. Text goes on the lines below.
+	const int BoardScreenLines{ 29 };
+
+	// Function to compose the update from one position of the board to another: for each square that differs, the escape code
+	// to move the cursor to it and the piece in its colours, with the cursor put back where it was afterwards.
+	// The board must have been drawn at the top of the screen. Returns the length of the update, which is zero if nothing changed.
+	size_t ComposeBoardUpdate(const uint8_t Previous[64], const uint8_t Codes[64], int Foreground, int Background, char Frame[]);
+
+	// Function to compose a frame of the board and write it, using a buffer kept by each thread so nothing is allocated.
+	// With incremental drawing on, only the changes since the last board are written.
+	void DrawBoard(const uint8_t Codes[64], int Foreground, int Background);
+
+}
+
+#endif
\ No newline at end of file
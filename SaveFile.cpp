@@ -0,0 +1,112 @@
+// OOP Chess Project: SaveFile.cpp.
+// This is the save file source file.
+// It contains the definitions of the binary saved game format.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include "SaveFile.h"
+
+// Using namespaces.
+using namespace SaveNamespace;
+
+// The first four bytes of every save file.
+static const char SaveFileMagic[4]{ 'C', 'H', 'S', 'V' };
+
+// Function to add bytes to a 32-bit FNV-1a checksum.
+static uint32_t AddToChecksum(uint32_t Checksum, const uint8_t* Data, size_t Size)
+{
+	for (size_t i = 0; i < Size; i++) { Checksum = (Checksum ^ Data[i]) * 16777619u; }
+	return Checksum;
+}
+
+// Function to work out the checksum of a header and its moves, treating the checksum field as zero.
+static uint32_t SaveFileChecksum(const SaveFileHeader& Header, const uint16_t* Moves, size_t NumberOfMoves)
+{
+	SaveFileHeader Copy{ Header };
+	Copy.Checksum = 0;
+	uint32_t Checksum{ AddToChecksum(2166136261u, reinterpret_cast<const uint8_t*>(&Copy), sizeof(Copy)) };
+	return AddToChecksum(Checksum, reinterpret_cast<const uint8_t*>(Moves), NumberOfMoves * sizeof(uint16_t));
+}
+
+// Function to convert a FEN position into a saved position.
+void SaveNamespace::PackSavedPosition(const FENPosition& Position, SavedPosition& Saved)
+{
+	PackPosition(Position.Codes, 0, Draw, Position.WhiteToMove, Saved.Placement);
+	Saved.Castling = Position.Castling;
+	Saved.EnPassantSquare = static_cast<int8_t>(Position.EnPassantSquare);
+	Saved.HalfmoveClock = static_cast<uint16_t>(Position.HalfmoveClock);
+	Saved.FullmoveNumber = static_cast<uint16_t>(Position.FullmoveNumber);
+	Saved.Reserved = 0;
+}
+
+// Function to convert a saved position into a FEN position.
+void SaveNamespace::UnpackSavedPosition(const SavedPosition& Saved, FENPosition& Position)
+{
+	UnpackPosition(Saved.Placement, Position.Codes);
+	Position.WhiteToMove = Saved.Placement.WhiteToMove != 0;
+	Position.Castling = Saved.Castling;
+	Position.EnPassantSquare = Saved.EnPassantSquare;
+	Position.HalfmoveClock = Saved.HalfmoveClock;
+	Position.FullmoveNumber = Saved.FullmoveNumber;
+}
+
+// Function to write a save file in one go.
+bool SaveNamespace::WriteSaveFile(const string& FileName, SaveFileHeader& Header, const vector<uint16_t>& Moves)
+{
+
+	// Fill in the parts of the header that describe the file itself.
+	memcpy(Header.Magic, SaveFileMagic, sizeof(SaveFileMagic));
+	Header.Version = SaveFileVersion;
+	Header.HeaderSize = sizeof(SaveFileHeader);
+	Header.NumberOfMoves = static_cast<uint32_t>(Moves.size());
+	Header.Checksum = SaveFileChecksum(Header, Moves.data(), Moves.size());
+
+	// Put the header and moves into one buffer so the file is written with a single call.
+	vector<uint8_t> Buffer(sizeof(SaveFileHeader) + Moves.size() * sizeof(uint16_t));
+	memcpy(Buffer.data(), &Header, sizeof(SaveFileHeader));
+	if (!Moves.empty()) { memcpy(Buffer.data() + sizeof(SaveFileHeader), Moves.data(), Moves.size() * sizeof(uint16_t)); }
+	ofstream File(FileName, ios::binary | ios::trunc);
+	if (!File.is_open()) { cerr << "Error: Unable to open " << FileName << " for saving." << endl; return false; }
+	File.write(reinterpret_cast<const char*>(Buffer.data()), static_cast<streamsize>(Buffer.size()));
+	if (!File) { cerr << "Error: Unable to write " << FileName << "." << endl; return false; }
+	return true;
+
+}
+
+// Function to read a whole save file with a single read and check it.
+bool SaveNamespace::ReadSaveFile(const string& FileName, SaveFileHeader& Header, vector<uint16_t>& Moves)
+{
+
+	// Read the whole file at once.
+	ifstream File(FileName, ios::binary | ios::ate);
+	if (!File.is_open()) { cerr << "Error: Unable to open " << FileName << " for loading." << endl; return false; }
+	size_t Size{ static_cast<size_t>(File.tellg()) };
+	vector<uint8_t> Buffer(Size);
+	File.seekg(0);
+	if (Size > 0) { File.read(reinterpret_cast<char*>(Buffer.data()), static_cast<streamsize>(Size)); }
+	if (!File || Size < sizeof(SaveFileHeader)) { cerr << "Error: " << FileName << " is too short to be a saved game." << endl; return false; }
+
+	// Check the header describes this file.
+	memcpy(&Header, Buffer.data(), sizeof(SaveFileHeader));
+	if (memcmp(Header.Magic, SaveFileMagic, sizeof(SaveFileMagic)) != 0) { cerr << "Error: " << FileName << " is not a saved game." << endl; return false; }
+	if (Header.Version != SaveFileVersion || Header.HeaderSize != sizeof(SaveFileHeader))
+	{
+		cerr << "Error: " << FileName << " was saved in version " << Header.Version << " of the format, but only version " << SaveFileVersion << " can be read." << endl;
+		return false;
+	}
+	if (Size != sizeof(SaveFileHeader) + static_cast<size_t>(Header.NumberOfMoves) * sizeof(uint16_t))
+	{
+		cerr << "Error: " << FileName << " should hold " << Header.NumberOfMoves << " moves but is the wrong size." << endl;
+		return false;
+	}
+
+	// Copy out the moves and check nothing has been corrupted.
+	Moves.resize(Header.NumberOfMoves);
+	if (!Moves.empty()) { memcpy(Moves.data(), Buffer.data() + sizeof(SaveFileHeader), Moves.size() * sizeof(uint16_t)); }
+	if (SaveFileChecksum(Header, Moves.data(), Moves.size()) != Header.Checksum) { cerr << "Error: " << FileName << " is corrupt (the checksum doesn't match)." << endl; return false; }
+	return true;
+
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+// OOP Chess Project: SaveFile.h.
+// This is the save file header file.
+// It contains the declarations of the binary saved game format: a snapshot of the position plus the moves of the game.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_SaveFile
+#define MY_CLASS_SaveFile
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Fen.h"
+#include "PackedPosition.h"
+
+// Using namespaces.
+using namespace FenNamespace;
+using namespace PackedNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace SaveNamespace
+{
+
+	// The version of the format written by this program. Files of any other version are refused.
+	const uint16_t SaveFileVersion{ 1 };
+
+	// A position as it is stored in a save file: the placement and side to move, and the rest of the FEN fields.
+	struct SavedPosition {
+		PackedPosition Placement;
+		uint8_t Castling;
+		int8_t EnPassantSquare;
+		uint16_t HalfmoveClock, FullmoveNumber;
+		uint16_t Reserved;
+	};
+	static_assert(sizeof(SavedPosition) == 44, "SavedPosition must be 44 bytes so that save files are portable.");
+
+	// The start of a save file. It is followed by NumberOfMoves 16-bit moves.
+	// The game can be restored from the current position alone, and the starting position is kept so that moves can be undone.
+	struct SaveFileHeader {
+		char Magic[4];
+		uint16_t Version, HeaderSize;
+		uint32_t NumberOfMoves;
+		// The checksum of the whole file, worked out with this field set to zero.
+		uint32_t Checksum;
+		SavedPosition StartingPosition, CurrentPosition;
+		int32_t GameTurnNumber, CaptureCounter, PawnMoveCounter;
+	};
+	static_assert(sizeof(SaveFileHeader) == 116, "SaveFileHeader must be 116 bytes so that save files are portable.");
+
+	// Functions to convert between a FEN position and a saved position.
+	void PackSavedPosition(const FENPosition& Position, SavedPosition& Saved);
+	void UnpackSavedPosition(const SavedPosition& Saved, FENPosition& Position);
+
+	// Functions to pack a move into 16 bits and read it back: the square moved from in the low six bits and the square moved to in the next six.
+	// The game writes its moves as they are, so the top four bits may hold the promotion piece and flags of a packed move. Reading ignores them.
+	inline uint16_t PackSavedMove(int From, int To) { return static_cast<uint16_t>((From & 63) | ((To & 63) << 6)); }
+	inline int SavedMoveFrom(uint16_t Move) { return Move & 63; }
+	inline int SavedMoveTo(uint16_t Move)   { return (Move >> 6) & 63; }
+
+	// Function to write a save file in one go. The magic number, version, sizes and checksum of the header are filled in here.
+	// Returns false if the file can't be written.
+	bool WriteSaveFile(const string& FileName, SaveFileHeader& Header, const vector<uint16_t>& Moves);
+
+	// Function to read a whole save file with a single read and check it. Returns false, with an error message, if it is
+	// missing, truncated, from another version or corrupt. The moves are copied out of the file.
+	bool ReadSaveFile(const string& FileName, SaveFileHeader& Header, vector<uint16_t>& Moves);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+// OOP Chess Project: SelfPlay.cpp.
+// This is the self-play source file.
+// It contains all the definitions related to generating training data from self-play games.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <random>
+#include "SelfPlay.h"
+#include "GameManager.h"
+#include "PackedPosition.h"
+#include "Zobrist.h"
+
+// Using namespaces.
+using namespace SelfPlayNamespace;
+using namespace GameNamespace;
+using namespace PackedNamespace;
+using namespace ZobristNamespace;
+
+// Function to return the default settings.
+SelfPlayOptions SelfPlayNamespace::DefaultSelfPlayOptions()
+{
+	SelfPlayOptions Options;
+	Options.Games = 1000;
+	Options.Threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+	Options.NodesPerMove = 2000;
+	Options.RandomPlies = 8;
+	Options.MaximumPlies = 400;
+	Options.Seed = static_cast<uint64_t>(time(NULL));
+	Options.BatchSize = 4096;
+	return Options;
+}
+
+// Function to play one game from the starting position, adding its quiet positions to a list with the result of the game.
+static void PlayGame(GameManager& Game, const SelfPlayOptions& Options, mt19937_64& Random, vector<PackedPosition>& Positions)
+{
+
+	// Start the game, remembering every position's key to spot repetitions.
+	FENPosition Position;
+	ParseFEN(StartingFEN, Position);
+	Game.SetPosition(Position);
+	vector<uint64_t> Keys;
+	size_t FirstPosition{ Positions.size() };
+	int Result{ Draw };
+	PositionMove Legal[MaximumMoves];
+
+	for (int Ply = 0; Ply < Options.MaximumPlies; Ply++)
+	{
+		// The game is over at a mate or stalemate, after fifty moves without a capture or pawn move, when neither side can mate,
+		// or at a threefold repetition.
+		Game.GetPosition(Position);
+		Keys.push_back(PositionKey(Position));
+		GameEnding Ending{ FindGameEnding(Position) };
+		if (Ending == Checkmate) { Result = Position.WhiteToMove ? BlackWin : WhiteWin; }
+		if (Ending != NotFinished || count(Keys.begin(), Keys.end(), Keys.back()) >= 3) { break; }
+		int NumberOfMoves{ GenerateLegalMoves(Position, Legal) };
+		bool Check{ InCheck(Position) };
+
+		// The opening moves are random, so the games are all different. After that the search chooses.
+		PackedMove TheMove;
+		if (Ply < Options.RandomPlies)
+		{
+			const PositionMove& Chosen{ Legal[Random() % NumberOfMoves] };
+			TheMove = PackMove(Position.Codes, Chosen.From, Chosen.To);
+		}
+		else
+		{
+			SearchResult Found{ Game.LimitedSearch({ 0, Options.NodesPerMove, 0.0 }) };
+			TheMove = Found.Move;
+
+			// Keep the position if it is quiet: a capture or promotion would change the material straight away, so the score
+			// of such a position says more about the search than about the position.
+			bool Promotion{ IsSpecialMove(TheMove) && (Position.Codes[MoveFrom(TheMove)] - 1) % 6 == PawnType };
+			if (!Check && !IsCaptureMove(TheMove) && !Promotion && fabs(Found.Score) < 9000)
+			{
+				// The evaluation counts a pawn as 10, so it is multiplied by ten to make centipawns.
+				int Score{ static_cast<int>(lround(10 * Found.Score)) };
+				PackedPosition Packed;
+				PackPosition(Position.Codes, max(-32000, min(32000, Score)), Draw, Position.WhiteToMove, Packed);
+				Positions.push_back(Packed);
+			}
+		}
+		Game.MakeMove(TheMove);
+	}
+
+	// Now the result is known, it can be given to the game's positions.
+	for (size_t i = FirstPosition; i < Positions.size(); i++) { Positions[i].Result = static_cast<uint8_t>(Result); }
+
+}
+
+// Function to play games and write their quiet positions to a data file.
+long long SelfPlayNamespace::GenerateSelfPlayData(const string& FileName, const SelfPlayOptions& Options)
+{
+
+	ofstream Output(FileName, ios::binary);
+	if (!Output.is_open()) { cerr << "Error: Unable to open " << FileName << " for saving." << endl; return -1; }
+
+	// Each thread plays the next game nobody has started and keeps its positions until it has a batch,
+	// which it writes while holding the lock on the file, so the file is written in large pieces from one thread at a time.
+	atomic<long long> NextGame{ 0 };
+	long long GamesPlayed{ 0 }, Written{ 0 };
+	mutex OutputLock;
+	auto Start = chrono::steady_clock::now();
+	auto WriteBatch = [&](vector<PackedPosition>& Batch, long long Games) {
+		lock_guard<mutex> Lock(OutputLock);
+		Output.write(reinterpret_cast<const char*>(Batch.data()), static_cast<streamsize>(Batch.size() * sizeof(PackedPosition)));
+		Written += static_cast<long long>(Batch.size());
+		GamesPlayed += Games;
+		double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+		cout << "Played " << GamesPlayed << " games and written " << Written << " positions (" << fixed << setprecision(0)
+			<< (Seconds > 0 ? 3600 * Written / Seconds : 0.0) << " positions per hour)." << endl;
+		Batch.clear();
+	};
+	auto Worker = [&]() {
+		Board TheBoard;
+		GameManager Game(&TheBoard);
+		vector<PackedPosition> Batch;
+		Batch.reserve(Options.BatchSize + static_cast<size_t>(Options.MaximumPlies));
+		long long Games{ 0 };
+		for (long long i = NextGame++; i < Options.Games; i = NextGame++)
+		{
+			// Each game has its own random numbers, so the openings depend on the seed and not on which thread played them.
+			mt19937_64 Random(Options.Seed + static_cast<uint64_t>(i));
+			PlayGame(Game, Options, Random, Batch);
+			Games++;
+			if (Batch.size() >= Options.BatchSize) { WriteBatch(Batch, Games); Games = 0; }
+		}
+		if (!Batch.empty() || Games > 0) { WriteBatch(Batch, Games); }
+	};
+
+	int Threads{ static_cast<int>(max(1LL, min(static_cast<long long>(Options.Threads), Options.Games))) };
+	vector<thread> Workers;
+	for (int i = 1; i < Threads; i++) { Workers.emplace_back(Worker); }
+	Worker();
+	for (thread& TheThread : Workers) { TheThread.join(); }
+	if (!Output) { cerr << "Error: Could not write every position to " << FileName << "." << endl; return -1; }
+	return Written;
+
+}
+
+// Function to run "selfplay <data file> [-games N] [-nodes N] [-random N] [-plies N] [-threads N] [-seed N]" from the command line.
+int SelfPlayNamespace::RunSelfPlay(int argc, char* argv[])
+{
+
+	// Check the arguments.
+	if (argc < 3) { cerr << "Error: Usage is \"selfplay <data file> [-games N] [-nodes N] [-random N] [-plies N] [-threads N] [-seed N]\"." << endl; return 1; }
+	SelfPlayOptions Options{ DefaultSelfPlayOptions() };
+	for (int i = 3; i < argc; i++)
+	{
+		string Option{ argv[i] };
+		if (i + 1 >= argc) { cerr << "Error: " << Option << " needs a value." << endl; return 1; }
+		if (Option == "-games") { Options.Games = atoll(argv[++i]); }
+		else if (Option == "-nodes") { Options.NodesPerMove = atoll(argv[++i]); }
+		else if (Option == "-random") { Options.RandomPlies = atoi(argv[++i]); }
+		else if (Option == "-plies") { Options.MaximumPlies = atoi(argv[++i]); }
+		else if (Option == "-threads") { Options.Threads = atoi(argv[++i]); }
+		else if (Option == "-seed") { Options.Seed = strtoull(argv[++i], nullptr, 10); }
+		else { cerr << "Error: Did not recognise " << Option << "." << endl; return 1; }
+	}
+	if (Options.Games <= 0 || Options.NodesPerMove <= 0) { cerr << "Error: The number of games and nodes must be positive." << endl; return 1; }
+
+	// Play the games.
+	auto Start = chrono::steady_clock::now();
+	long long Written{ GenerateSelfPlayData(argv[2], Options) };
+	if (Written < 0) { return 1; }
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+	cout << "Wrote " << Written << " positions from " << Options.Games << " games to " << argv[2] << " in " << fixed << setprecision(1) << Seconds << " seconds." << endl;
+	return 0;
+
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+// OOP Chess Project: SelfPlay.h.
+// This is the self-play header file.
+// It contains the declarations of the generator of training data from games the computer plays against itself.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_SelfPlay
+#define MY_CLASS_SelfPlay
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+
+// Using namespaces.
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace SelfPlayNamespace
+{
+
+	// The settings of a run of self-play games.
+	struct SelfPlayOptions {
+		// The number of games, and the number of threads playing them.
+		long long Games;
+		int Threads;
+		// The nodes each move is searched for, the number of random moves each game starts with, and the longest a game may last in half moves.
+		long long NodesPerMove;
+		int RandomPlies, MaximumPlies;
+		// The seed of the random openings. The same seed gives the same openings.
+		uint64_t Seed;
+		// The number of positions each thread collects before writing them to the file in one go.
+		size_t BatchSize;
+	};
+
+	// Function to return the default settings: 1000 games on every core, 2000 nodes a move, 8 random half moves,
+	// games of at most 400 half moves, and batches of 4096 positions.
+	SelfPlayOptions DefaultSelfPlayOptions();
+
+	// Function to play games and write their quiet positions to a data file of PackedPosition records, which "tune" can read.
+	// A position is kept if the side to move isn't in check, the search's best move isn't a capture or promotion, and the score isn't a mate.
+	// Each is written with the search's score in centipawns from white's point of view and the result of its game.
+	// Returns the number of positions written, or -1 if the file can't be opened.
+	long long GenerateSelfPlayData(const string& FileName, const SelfPlayOptions& Options);
+
+	// Function to run "selfplay <data file> [-games N] [-nodes N] [-random N] [-plies N] [-threads N] [-seed N]" from the command line.
+	int RunSelfPlay(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,660 @@
+// OOP Chess Project: Server.cpp.
+// This is the SessionServer class source file.
+// It contains all the definitions related to the session server and the client used to try it.
+// James Cummins.
+
+// Include the relevant header files and the operating system headers.
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include "Server.h"
+#include "Uci.h"
+#include "Zobrist.h"
+#if !defined(_WIN32)
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+// Using namespaces.
+using namespace ServerNamespace;
+using namespace UciNamespace;
+using namespace ZobristNamespace;
+
+// The longest line a client may send, and the most that may wait to be written to a client before the server stops reading from it.
+static const size_t MaximumLineLength{ 65536 };
+static const size_t MaximumOutput{ 1 << 20 };
+
+// Function to return the default settings.
+ServerOptions ServerNamespace::DefaultServerOptions()
+{
+	return { "", max(1, static_cast<int>(thread::hardware_concurrency())), 1024, 0.1, 10.0, 100000 };
+}
+
+#if defined(_WIN32)
+
+// The server uses POSIX sockets and poll, which Windows doesn't have in the same form.
+int ServerNamespace::RunServer(int, char*[]) { cerr << "Error: The server is not available on Windows." << endl; return 1; }
+int ServerNamespace::RunClient(int, char*[]) { cerr << "Error: The client is not available on Windows." << endl; return 1; }
+
+#else
+
+// Function to open a socket: listening on the address, or connected to it. Returns -1 if it can't be opened.
+static int OpenSocket(const string& Address, bool Listening)
+{
+
+	// Make the address: a path for a Unix-domain socket, or a port on the loopback interface.
+	sockaddr_storage Storage;
+	socklen_t Length;
+	memset(&Storage, 0, sizeof(Storage));
+	if (Address.compare(0, 5, "unix:") == 0)
+	{
+		string Path{ Address.substr(5) };
+		sockaddr_un& Local{ *reinterpret_cast<sockaddr_un*>(&Storage) };
+		if (Path.empty() || Path.size() >= sizeof(Local.sun_path)) { cerr << "Error: \"" << Path << "\" is not a usable socket path." << endl; return -1; }
+		Local.sun_family = AF_UNIX;
+		memcpy(Local.sun_path, Path.c_str(), Path.size() + 1);
+		Length = sizeof(sockaddr_un);
+
+		// A socket left behind by a server that didn't stop cleanly is removed, but nothing else is.
+		struct stat Status;
+		if (Listening && lstat(Path.c_str(), &Status) == 0 && S_ISSOCK(Status.st_mode)) { unlink(Path.c_str()); }
+	}
+	else
+	{
+		int Port{ atoi(Address.c_str()) };
+		if (Port <= 0 || Port > 65535) { cerr << "Error: \"" << Address << "\" is not a port number or \"unix:<path>\"." << endl; return -1; }
+		sockaddr_in& Network{ *reinterpret_cast<sockaddr_in*>(&Storage) };
+		Network.sin_family = AF_INET;
+		Network.sin_port = htons(static_cast<uint16_t>(Port));
+		Network.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		Length = sizeof(sockaddr_in);
+	}
+
+	// Open the socket and listen or connect.
+	int Socket{ socket(Storage.ss_family, SOCK_STREAM, 0) };
+	if (Socket < 0) { cerr << "Error: Could not open a socket (" << strerror(errno) << ")." << endl; return -1; }
+	int On{ 1 };
+	if (Storage.ss_family == AF_INET) { setsockopt(Socket, SOL_SOCKET, SO_REUSEADDR, &On, sizeof(On)); }
+	bool Worked{ Listening ? bind(Socket, reinterpret_cast<sockaddr*>(&Storage), Length) == 0 && listen(Socket, SOMAXCONN) == 0
+		: connect(Socket, reinterpret_cast<sockaddr*>(&Storage), Length) == 0 };
+	if (!Worked)
+	{
+		cerr << "Error: Could not " << (Listening ? "listen on " : "connect to ") << Address << " (" << strerror(errno) << ")." << endl;
+		close(Socket);
+		return -1;
+	}
+
+	// Small replies are sent at once rather than held back to be joined together.
+	if (Storage.ss_family == AF_INET && !Listening) { setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &On, sizeof(On)); }
+	return Socket;
+
+}
+
+// Function to stop reading or writing from blocking the thread.
+static void SetNonBlocking(int Descriptor) { fcntl(Descriptor, F_SETFL, fcntl(Descriptor, F_GETFL, 0) | O_NONBLOCK); }
+
+// Function to send the whole of a string on a blocking socket. Returns false if the connection has failed.
+static bool SendAll(int Socket, const string& Text)
+{
+	size_t Sent{ 0 };
+	while (Sent < Text.size())
+	{
+		ssize_t Count{ send(Socket, Text.data() + Sent, Text.size() - Sent, 0) };
+		if (Count < 0 && errno == EINTR) { continue; }
+		if (Count <= 0) { return false; }
+		Sent += static_cast<size_t>(Count);
+	}
+	return true;
+}
+
+// Function to return the result of a game: "*" while it is being played, including a draw by threefold repetition.
+static const char* SessionResult(const FENPosition& Position, const vector<uint64_t>& Keys)
+{
+	GameEnding Ending{ FindGameEnding(Position) };
+	if (Ending != NotFinished) { return GameEndingResult(Position, Ending); }
+	if (!Keys.empty() && count(Keys.begin(), Keys.end(), Keys.back()) >= 3) { return "1/2-1/2"; }
+	return "*";
+}
+
+// Function to make a move in a game. The keys of positions before a capture or pawn move can't come again, so they are forgotten.
+static void PlaySessionMove(FENPosition& Position, vector<uint64_t>& Keys, const PositionMove& Move)
+{
+	MakePositionMove(Position, Move);
+	if (Position.HalfmoveClock == 0) { Keys.clear(); }
+	Keys.push_back(PositionKey(Position));
+}
+
+// Constructor.
+SessionServer::SessionServer(const ServerOptions& InputOptions) : Options(InputOptions)
+{
+	ListeningSocket = WakePipe[0] = WakePipe[1] = -1;
+	NextSession = NextConnection = 1;
+	Stopping = false;
+	Searching = 0;
+	SearchCount = NodeCount = 0;
+}
+
+// Destructor.
+SessionServer::~SessionServer()
+{
+
+	// Stop the searches and wait for the threads to finish.
+	Stopping = true;
+	JobReady.notify_all();
+	for (thread& Worker : Workers) { Worker.join(); }
+
+	// Close everything, removing the socket's path.
+	for (auto& Entry : Connections) { close(Entry.second.Socket); }
+	if (ListeningSocket >= 0)
+	{
+		close(ListeningSocket);
+		if (Options.Address.compare(0, 5, "unix:") == 0) { unlink(Options.Address.c_str() + 5); }
+	}
+	if (WakePipe[0] >= 0) { close(WakePipe[0]); close(WakePipe[1]); }
+
+}
+
+// Function to start listening.
+bool SessionServer::Listen()
+{
+	ListeningSocket = OpenSocket(Options.Address, true);
+	if (ListeningSocket < 0) { return false; }
+	if (pipe(WakePipe) != 0) { cerr << "Error: Could not make a pipe (" << strerror(errno) << ")." << endl; return false; }
+	SetNonBlocking(ListeningSocket);
+	SetNonBlocking(WakePipe[0]);
+	SetNonBlocking(WakePipe[1]);
+	return true;
+}
+
+// Function run by each search thread.
+void SessionServer::Work()
+{
+
+	// The thread has its own board and game, set to each position it is given.
+	Board TheBoard;
+	GameManager Game(&TheBoard);
+	while (true)
+	{
+		SearchJob Job;
+		{
+			unique_lock<mutex> Lock(JobLock);
+			JobReady.wait(Lock, [this]() { return Stopping || !Jobs.empty(); });
+			if (Stopping) { return; }
+			Job = Jobs.front();
+			Jobs.pop_front();
+		}
+
+		// Search for whatever is left of the time, but for at least a hundredth of a second so there is always a move.
+		Searching++;
+		double Seconds{ max(0.01, chrono::duration<double>(Job.Deadline - chrono::steady_clock::now()).count()) };
+		Game.SetPosition(Job.Position);
+		SearchResult Result{ Game.LimitedSearch({ 0, 0, Seconds }, &Stopping) };
+		Searching--;
+
+		// Hand the answer over and wake the thread that does the writing. If the pipe is full, it is going to wake anyway.
+		{
+			lock_guard<mutex> Lock(AnswerLock);
+			Answers.push_back({ Job.Connection, Job.Session, Result.Move, Result.Depth > 0 ? Result.Nodes : -1 });
+		}
+		char Byte{ 0 };
+		if (write(WakePipe[1], &Byte, 1) < 0) {}
+	}
+
+}
+
+// Function to give the clients the answers the search threads have found.
+void SessionServer::ApplyAnswers()
+{
+
+	vector<SearchAnswer> Ready;
+	{
+		lock_guard<mutex> Lock(AnswerLock);
+		Ready.swap(Answers);
+	}
+
+	// An answer for a game that has been closed, or whose connection has gone, is thrown away.
+	for (const SearchAnswer& Answer : Ready)
+	{
+		SearchCount++;
+		NodeCount += max(0LL, Answer.Nodes);
+		auto Client = Connections.find(Answer.Connection);
+		if (Client != Connections.end()) { Client->second.Pending--; }
+		auto Session = Sessions.find(Answer.Session);
+		if (Client == Connections.end() || Session == Sessions.end()) { continue; }
+		GameSession& Game{ Session->second };
+		Game.Thinking = false;
+
+		// The move is checked against the legal moves like any other before it is made.
+		char Text[8];
+		PositionMove Move;
+		WriteUciMove(Game.Position.Codes, Answer.Move, Text);
+		if (Answer.Nodes < 0 || !ParseUciMove(Game.Position, Text, Move)) { Client->second.Output += "error " + to_string(Answer.Session) + " no move found\n"; continue; }
+		PlaySessionMove(Game.Position, Game.Keys, Move);
+		Client->second.Output += "bestmove " + to_string(Answer.Session) + " " + Text + " " + DescribeSession(Game) + "\n";
+	}
+
+}
+
+// Function to read what a client has sent.
+bool SessionServer::ReadFrom(Connection& Client)
+{
+
+	// Only one read is done each time round, so a client sending a lot can't keep the others waiting.
+	char Buffer[16384];
+	ssize_t Count{ recv(Client.Socket, Buffer, sizeof(Buffer), 0) };
+	if (Count > 0) { Client.Input.append(Buffer, static_cast<size_t>(Count)); }
+	else if (Count == 0) { Client.Closing = true; }
+	else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) { return false; }
+
+	// A line that never ends is a client that has gone wrong.
+	return Client.Input.size() < MaximumLineLength || Client.Input.find('\n') != string::npos;
+
+}
+
+// Function to write what is waiting for a client.
+bool SessionServer::WriteTo(Connection& Client)
+{
+	size_t Sent{ 0 };
+	while (Sent < Client.Output.size())
+	{
+		ssize_t Count{ send(Client.Socket, Client.Output.data() + Sent, Client.Output.size() - Sent, 0) };
+		if (Count > 0) { Sent += static_cast<size_t>(Count); continue; }
+		if (Count < 0 && errno == EINTR) { continue; }
+		if (Count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { break; }
+		return false;
+	}
+	Client.Output.erase(0, Sent);
+	return true;
+}
+
+// Function to answer the whole lines a client has sent.
+void SessionServer::HandleLines(uint64_t Id, Connection& Client)
+{
+
+	// Once the client has finished sending, a last line without a new line still counts.
+	if (Client.Closing && !Client.Input.empty() && Client.Input.back() != '\n') { Client.Input += '\n'; }
+	size_t Start{ 0 }, End;
+	while (!Stopping && Client.Output.size() < MaximumOutput && (End = Client.Input.find('\n', Start)) != string::npos)
+	{
+		string Line(Client.Input, Start, End - Start);
+		if (!Line.empty() && Line.back() == '\r') { Line.pop_back(); }
+		Start = End + 1;
+		if (!HandleCommand(Id, Client, Line))
+		{
+			Client.Closing = true;
+			Start = Client.Input.size();
+		}
+	}
+	Client.Input.erase(0, Start);
+
+}
+
+// Function to answer one line from a client.
+bool SessionServer::HandleCommand(uint64_t Id, Connection& Client, const string& Line)
+{
+
+	istringstream Command(Line);
+	string Word;
+	if (!(Command >> Word)) { return true; }
+	auto Reply = [&](const string& Text) { Client.Output += Text; Client.Output += '\n'; };
+
+	// Function to find the game a command is for. Only the connection that opened a game may use it.
+	uint64_t SessionId{ 0 };
+	auto FindSession = [&]() -> GameSession* {
+		Command >> SessionId;
+		auto Session = Sessions.find(SessionId);
+		if (Session == Sessions.end() || Session->second.Owner != Id) { Reply("error " + to_string(SessionId) + " unknown game"); return nullptr; }
+		return &Session->second;
+	};
+
+	if (Word == "new")
+	{
+		// Open a game from the starting position, or from the FEN string given.
+		if (Sessions.size() >= Options.MaximumSessions) { Reply("error too many games"); return true; }
+		string FEN;
+		getline(Command >> ws, FEN);
+		GameSession Session{ {}, {}, Id, false };
+		if (!ParseFEN(FEN.empty() ? StartingFEN : FEN.c_str(), Session.Position)) { Reply(string("error bad FEN: ") + FENProblem(FEN.c_str())); return true; }
+		Session.Keys.push_back(PositionKey(Session.Position));
+		SessionId = NextSession++;
+		Sessions.emplace(SessionId, Session);
+		Reply("ok " + to_string(SessionId));
+	}
+	else if (Word == "move" || Word == "go")
+	{
+		// A game can't be changed while the computer is thinking about it, or once it is over.
+		GameSession* Session{ FindSession() };
+		if (Session == nullptr) { return true; }
+		string Name{ to_string(SessionId) };
+		if (Session->Thinking) { Reply("error " + Name + " thinking"); return true; }
+		if (string(SessionResult(Session->Position, Session->Keys)) != "*") { Reply("error " + Name + " game over"); return true; }
+
+		if (Word == "move")
+		{
+			string Text;
+			PositionMove Move;
+			Command >> Text;
+			if (!ParseUciMove(Session->Position, Text, Move)) { Reply("error " + Name + " illegal move"); return true; }
+			PlaySessionMove(Session->Position, Session->Keys, Move);
+			Reply("position " + Name + " " + DescribeSession(*Session));
+			return true;
+		}
+
+		// Queue the search, unless too many are waiting already.
+		double Milliseconds{ 0.0 };
+		double Seconds{ Command >> Milliseconds ? Milliseconds / 1000.0 : Options.DefaultSeconds };
+		Seconds = max(0.001, min(Seconds, Options.MaximumSeconds));
+		{
+			lock_guard<mutex> Lock(JobLock);
+			if (Jobs.size() >= Options.QueueLimit) { Reply("busy " + Name); return true; }
+			Jobs.push_back({ Id, SessionId, Session->Position, chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(Seconds)) });
+		}
+		JobReady.notify_one();
+		Session->Thinking = true;
+		Client.Pending++;
+	}
+	else if (Word == "fen")
+	{
+		GameSession* Session{ FindSession() };
+		if (Session != nullptr) { Reply("position " + to_string(SessionId) + " " + DescribeSession(*Session)); }
+	}
+	else if (Word == "close")
+	{
+		// A search still running for the game finishes, and its answer is thrown away.
+		if (FindSession() == nullptr) { return true; }
+		Sessions.erase(SessionId);
+		Reply("ok " + to_string(SessionId));
+	}
+	else if (Word == "stats")
+	{
+		size_t Queued;
+		{
+			lock_guard<mutex> Lock(JobLock);
+			Queued = Jobs.size();
+		}
+		ostringstream Line;
+		Line << "stats sessions " << Sessions.size() << " connections " << Connections.size() << " queued " << Queued
+			<< " searching " << Searching << " searches " << SearchCount << " nodes " << NodeCount;
+		Reply(Line.str());
+	}
+	else if (Word == "quit") { return false; }
+	else if (Word == "shutdown")
+	{
+		Stopping = true;
+		JobReady.notify_all();
+		Reply("ok shutdown");
+	}
+	else { Reply("error unknown command " + Word); }
+	return true;
+
+}
+
+// Function to return a game's result and position.
+string SessionServer::DescribeSession(const GameSession& Session) const
+{
+	char Buffer[MaximumFENLength];
+	int Length{ WriteFEN(Session.Position, Buffer) };
+	return string(SessionResult(Session.Position, Session.Keys)) + " " + string(Buffer, Length);
+}
+
+// Function to close a connection and the games it opened.
+void SessionServer::Disconnect(uint64_t Id)
+{
+	for (auto Session = Sessions.begin(); Session != Sessions.end(); )
+	{
+		if (Session->second.Owner == Id) { Session = Sessions.erase(Session); }
+		else { ++Session; }
+	}
+	close(Connections[Id].Socket);
+	Connections.erase(Id);
+}
+
+// Function to serve clients until one sends "shutdown".
+void SessionServer::Serve()
+{
+
+	for (int i = 0; i < Options.Workers; i++) { Workers.emplace_back(&SessionServer::Work, this); }
+	vector<pollfd> Polls;
+	vector<uint64_t> Ids;
+	while (!Stopping)
+	{
+		// Wait for the pipe, a new connection, or a client that can be read from or written to. A client is only read from while
+		// little is waiting to be written to it, so one that doesn't read its replies stops being answered rather than using up memory.
+		// A client that has finished sending is left out until it has something to be written, as it would always be ready.
+		Polls.clear();
+		Ids.clear();
+		Polls.push_back({ WakePipe[0], POLLIN, 0 });
+		Polls.push_back({ ListeningSocket, POLLIN, 0 });
+		int Timeout{ -1 };
+		for (auto& Entry : Connections)
+		{
+			Connection& Client{ Entry.second };
+			bool Blocked{ Client.Output.size() >= MaximumOutput };
+			short Events{ static_cast<short>((!Client.Closing && !Blocked && Client.Input.size() < MaximumLineLength ? POLLIN : 0) | (Client.Output.empty() ? 0 : POLLOUT)) };
+			Polls.push_back({ Events == 0 ? -1 : Client.Socket, Events, 0 });
+			Ids.push_back(Entry.first);
+
+			// Lines left over from before are answered without waiting.
+			if (!Blocked && Client.Input.find('\n') != string::npos) { Timeout = 0; }
+		}
+		if (poll(Polls.data(), Polls.size(), Timeout) < 0 && errno != EINTR) { cerr << "Error: poll failed (" << strerror(errno) << ")." << endl; break; }
+
+		// Take the answers the search threads have found.
+		if (Polls[0].revents & POLLIN)
+		{
+			char Buffer[256];
+			while (read(WakePipe[0], Buffer, sizeof(Buffer)) > 0) {}
+		}
+		ApplyAnswers();
+
+		// Accept new connections.
+		if (Polls[1].revents & POLLIN)
+		{
+			int Socket;
+			while ((Socket = accept(ListeningSocket, nullptr, nullptr)) >= 0)
+			{
+				SetNonBlocking(Socket);
+				int On{ 1 };
+				if (Options.Address.compare(0, 5, "unix:") != 0) { setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &On, sizeof(On)); }
+				Connections.emplace(NextConnection++, Connection{ Socket, "", "", 0, false });
+			}
+		}
+
+		// Read, answer and write. A client that has finished is let go once its searches have been answered and its replies written.
+		for (size_t i = 0; i < Ids.size(); i++)
+		{
+			Connection& Client{ Connections[Ids[i]] };
+			short Events{ Polls[i + 2].revents };
+			bool Failed{ (Events & (POLLERR | POLLNVAL)) != 0 };
+			if (!Failed && (Events & (POLLIN | POLLHUP)) != 0) { Failed = !ReadFrom(Client); }
+			if (!Failed) { HandleLines(Ids[i], Client); }
+			if (!Failed && !Client.Output.empty()) { Failed = !WriteTo(Client); }
+			if (Failed || (Client.Closing && Client.Pending == 0 && Client.Output.empty())) { Disconnect(Ids[i]); }
+		}
+	}
+
+	// Send anything that can be sent before stopping.
+	for (auto& Entry : Connections) { WriteTo(Entry.second); }
+
+}
+
+// Function to run "server <address> [-workers N] [-queue N] [-movetime ms] [-maxtime ms] [-sessions N]" from the command line.
+int ServerNamespace::RunServer(int argc, char* argv[])
+{
+
+	// Read the settings.
+	const string Usage{ "Error: Usage is \"server <unix:path|port> [-workers N] [-queue N] [-movetime ms] [-maxtime ms] [-sessions N]\"." };
+	if (argc < 3) { cerr << Usage << endl; return 1; }
+	ServerOptions Options{ DefaultServerOptions() };
+	Options.Address = argv[2];
+	for (int i = 3; i < argc; i += 2)
+	{
+		string Option{ argv[i] };
+		if (i + 1 >= argc) { cerr << Usage << endl; return 1; }
+		double Value{ atof(argv[i + 1]) };
+		if (Option == "-workers") { Options.Workers = static_cast<int>(Value); }
+		else if (Option == "-queue") { Options.QueueLimit = static_cast<size_t>(max(0.0, Value)); }
+		else if (Option == "-movetime") { Options.DefaultSeconds = Value / 1000.0; }
+		else if (Option == "-maxtime") { Options.MaximumSeconds = Value / 1000.0; }
+		else if (Option == "-sessions") { Options.MaximumSessions = static_cast<size_t>(max(0.0, Value)); }
+		else { cerr << Usage << endl; return 1; }
+	}
+	if (Options.Workers < 1 || Options.DefaultSeconds <= 0 || Options.MaximumSeconds <= 0) { cerr << Usage << endl; return 1; }
+
+	// A client that goes away while being written to must not stop the server.
+	signal(SIGPIPE, SIG_IGN);
+	SessionServer Server(Options);
+	if (!Server.Listen()) { return 1; }
+	cout << "Listening on " << Options.Address << " with " << Options.Workers << " search threads." << endl;
+	Server.Serve();
+	return 0;
+
+}
+
+// Function to play games on a server as fast as it allows, reporting how fast it was.
+static int RunLoadTest(int Socket, int Games, int Moves, long long Milliseconds)
+{
+
+	// Read the replies a line at a time.
+	string Buffer;
+	auto ReadLine = [&](string& Line) {
+		size_t End;
+		while ((End = Buffer.find('\n')) == string::npos)
+		{
+			char Data[16384];
+			ssize_t Count{ recv(Socket, Data, sizeof(Data), 0) };
+			if (Count < 0 && errno == EINTR) { continue; }
+			if (Count <= 0) { return false; }
+			Buffer.append(Data, static_cast<size_t>(Count));
+		}
+		Line.assign(Buffer, 0, End);
+		Buffer.erase(0, End + 1);
+		return true;
+	};
+	string Go{ Milliseconds > 0 ? " " + to_string(Milliseconds) : "" };
+	auto Start = chrono::steady_clock::now();
+
+	// Open the games.
+	string Requests;
+	for (int i = 0; i < Games; i++) { Requests += "new\n"; }
+	if (!SendAll(Socket, Requests)) { cerr << "Error: The server closed the connection." << endl; return 1; }
+	struct LoadGame { int Moves; chrono::steady_clock::time_point Asked; };
+	unordered_map<uint64_t, LoadGame> Playing;
+	string Line, Word;
+	Requests.clear();
+	for (int i = 0; i < Games; i++)
+	{
+		if (!ReadLine(Line)) { cerr << "Error: The server closed the connection." << endl; return 1; }
+		istringstream Reply(Line);
+		uint64_t Id;
+		if (!(Reply >> Word >> Id) || Word != "ok") { cerr << "Error: The server replied \"" << Line << "\"." << endl; return 1; }
+		Playing[Id] = { 0, chrono::steady_clock::now() };
+		Requests += "go " + to_string(Id) + Go + "\n";
+	}
+
+	// Ask for every game's first move, then ask for the next move as each one comes back. A game the server is too busy for
+	// is asked again after a moment, and the time it takes counts from the first asking.
+	if (!SendAll(Socket, Requests)) { cerr << "Error: The server closed the connection." << endl; return 1; }
+	vector<double> Latencies;
+	long long Busy{ 0 };
+	int Finished{ 0 };
+	while (Finished < Games)
+	{
+		if (!ReadLine(Line)) { cerr << "Error: The server closed the connection." << endl; return 1; }
+		istringstream Reply(Line);
+		uint64_t Id{ 0 };
+		Reply >> Word >> Id;
+		auto Game = Playing.find(Id);
+		if (Word == "ok") { continue; }
+		if (Game == Playing.end() || (Word != "bestmove" && Word != "busy")) { cerr << "Error: The server replied \"" << Line << "\"." << endl; return 1; }
+		string Request{ "go " + to_string(Id) + Go + "\n" };
+		if (Word == "busy")
+		{
+			Busy++;
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+		else
+		{
+			string Move, Result;
+			Reply >> Move >> Result;
+			auto Now = chrono::steady_clock::now();
+			Latencies.push_back(chrono::duration<double, milli>(Now - Game->second.Asked).count());
+			Game->second.Asked = Now;
+			if (++Game->second.Moves >= Moves || Result != "*")
+			{
+				Finished++;
+				Request = "close " + to_string(Id) + "\n";
+			}
+		}
+		if (!SendAll(Socket, Request)) { cerr << "Error: The server closed the connection." << endl; return 1; }
+	}
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+
+	// Report the rate and how long the moves took.
+	sort(Latencies.begin(), Latencies.end());
+	auto Percentile = [&](double Fraction) { return Latencies.empty() ? 0.0 : Latencies[min(Latencies.size() - 1, static_cast<size_t>(Fraction * Latencies.size()))]; };
+	double Total{ 0.0 };
+	for (double Latency : Latencies) { Total += Latency; }
+	cout << fixed << setprecision(2) << Latencies.size() << " moves in " << Games << " games took " << Seconds << " seconds ("
+		<< (Seconds > 0 ? Latencies.size() / Seconds : 0.0) << " moves per second), with " << Busy << " busy replies." << endl;
+	cout << "Milliseconds a move: mean " << (Latencies.empty() ? 0.0 : Total / Latencies.size()) << ", median " << Percentile(0.5)
+		<< ", 99th percentile " << Percentile(0.99) << ", longest " << (Latencies.empty() ? 0.0 : Latencies.back()) << "." << endl;
+	SendAll(Socket, "quit\n");
+	return 0;
+
+}
+
+// Function to run "client <address> [-load <games> <moves>] [-movetime ms]" from the command line.
+int ServerNamespace::RunClient(int argc, char* argv[])
+{
+
+	// Read the settings.
+	const string Usage{ "Error: Usage is \"client <unix:path|port> [-load <games> <moves>] [-movetime ms]\"." };
+	if (argc < 3) { cerr << Usage << endl; return 1; }
+	int Games{ 0 }, Moves{ 0 };
+	long long Milliseconds{ 0 };
+	for (int i = 3; i < argc; i++)
+	{
+		string Option{ argv[i] };
+		if (Option == "-load" && i + 2 < argc) { Games = atoi(argv[i + 1]); Moves = atoi(argv[i + 2]); i += 2; }
+		else if (Option == "-movetime" && i + 1 < argc) { Milliseconds = atoll(argv[++i]); }
+		else { cerr << Usage << endl; return 1; }
+	}
+	signal(SIGPIPE, SIG_IGN);
+	int Socket{ OpenSocket(argv[2], false) };
+	if (Socket < 0) { return 1; }
+	if (Games > 0 && Moves > 0)
+	{
+		int Result{ RunLoadTest(Socket, Games, Moves, Milliseconds) };
+		close(Socket);
+		return Result;
+	}
+
+	// Otherwise print the replies on one thread while sending the lines typed on this one. Once the input ends, the server is told
+	// nothing more is coming, and the replies still to come are waited for.
+	thread Reader([Socket]() {
+		char Data[16384];
+		ssize_t Count;
+		while ((Count = recv(Socket, Data, sizeof(Data), 0)) > 0) { cout.write(Data, Count).flush(); }
+	});
+	string Line;
+	while (getline(cin, Line) && SendAll(Socket, Line + "\n")) {}
+	shutdown(Socket, SHUT_WR);
+	Reader.join();
+	close(Socket);
+	return 0;
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+// OOP Chess Project: Server.h.
+// This is the SessionServer class header file.
+// It contains the declarations of the session server, which plays many games at once for clients connected over a local socket.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Server
+#define MY_CLASS_Server
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include "GameManager.h"
+
+// Using namespaces.
+using namespace GameNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace ServerNamespace
+{
+
+	// The settings of a server.
+	struct ServerOptions {
+		// Where the server listens: "unix:<path>" for a Unix-domain socket, or a port number on 127.0.0.1.
+		string Address;
+		// The number of threads searching, and the most searches that may wait for one. A search asked for when the queue is full
+		// is answered "busy" straight away, so a client that asks too much finds out rather than waiting.
+		int Workers;
+		size_t QueueLimit;
+		// The time a search may take when none is given, and the most it may be given, in seconds. The time counts from when the
+		// search is asked for, so time spent waiting in the queue comes out of it.
+		double DefaultSeconds, MaximumSeconds;
+		// The most games that may be open at once.
+		size_t MaximumSessions;
+	};
+
+	// Function to return the default settings: every core searching, 1024 searches queued, 100 ms a move (at most 10 s)
+	// and 100000 games.
+	ServerOptions DefaultServerOptions();
+
+	// SessionServer class.
+	// One thread does all the reading and writing on non-blocking sockets and keeps the games, and a pool of threads does the searching.
+	// A game is just its position and the keys of the positions since the last capture or pawn move, so it takes a few hundred bytes;
+	// only the search threads have a board. Each line from a client is one command, and each command gets one line back:
+	//   new [FEN]          ->  ok <id>
+	//   move <id> <move>   ->  position <id> <result> <FEN>
+	//   go <id> [ms]       ->  bestmove <id> <move> <result> <FEN>, or busy <id> if too many searches are waiting
+	//   fen <id>           ->  position <id> <result> <FEN>
+	//   close <id>         ->  ok <id>
+	//   stats              ->  stats sessions <n> connections <n> queued <n> searching <n> searches <n> nodes <n>
+	//   quit               ->  the connection is closed once its searches have been answered
+	//   shutdown           ->  the server stops
+	// Moves are in coordinates (e.g. "e2e4") and the result is "*" until the game is over. Anything wrong gets "error <reason>".
+	// Games belong to the connection that opened them and are closed when it goes.
+	class SessionServer {
+
+	// Private member data.
+	private:
+
+		// A game.
+		struct GameSession {
+			FENPosition Position;
+			vector<uint64_t> Keys;
+			uint64_t Owner;
+			bool Thinking;
+		};
+
+		// A client's connection, with what has been read but not yet handled and what is waiting to be written.
+		struct Connection {
+			int Socket;
+			string Input, Output;
+			// The searches asked for and not yet answered, and whether the client has finished sending.
+			int Pending;
+			bool Closing;
+		};
+
+		// A search waiting for a thread, and its answer.
+		struct SearchJob {
+			uint64_t Connection, Session;
+			FENPosition Position;
+			chrono::steady_clock::time_point Deadline;
+		};
+		struct SearchAnswer {
+			uint64_t Connection, Session;
+			PackedMove Move;
+			long long Nodes;
+		};
+
+		ServerOptions Options;
+		int ListeningSocket;
+		// The pipe the search threads write to, to wake the reading and writing thread when they have an answer.
+		int WakePipe[2];
+		unordered_map<uint64_t, GameSession> Sessions;
+		unordered_map<uint64_t, Connection> Connections;
+		uint64_t NextSession, NextConnection;
+
+		// The search threads, the searches waiting for them and the answers they have found.
+		vector<thread> Workers;
+		deque<SearchJob> Jobs;
+		vector<SearchAnswer> Answers;
+		mutex JobLock, AnswerLock;
+		condition_variable JobReady;
+		atomic<bool> Stopping;
+		atomic<int> Searching;
+		long long SearchCount, NodeCount;
+
+		// Function run by each search thread.
+		void Work();
+
+		// Function to give the clients the answers the search threads have found.
+		void ApplyAnswers();
+
+		// Functions to read from and write to a connection. They return false if the connection has failed.
+		bool ReadFrom(Connection& Client);
+		bool WriteTo(Connection& Client);
+
+		// Function to answer the whole lines a client has sent, stopping while too much is waiting to be written to it.
+		void HandleLines(uint64_t Id, Connection& Client);
+
+		// Function to answer one line from a client. Returns false if it was "quit".
+		bool HandleCommand(uint64_t Id, Connection& Client, const string& Line);
+
+		// Function to return a game's result and position, as sent after each move.
+		string DescribeSession(const GameSession& Session) const;
+
+		// Function to close a connection and the games it opened.
+		void Disconnect(uint64_t Id);
+
+	// Public member functions.
+	public:
+
+		// Constructor.
+		SessionServer(const ServerOptions& InputOptions);
+		// Destructor, which stops the server if it is running.
+		~SessionServer();
+
+		// Function to start listening. Returns false if the address can't be used.
+		bool Listen();
+
+		// Function to serve clients until one sends "shutdown".
+		void Serve();
+
+	};
+
+	// Function to run "server <address> [-workers N] [-queue N] [-movetime ms] [-maxtime ms] [-sessions N]" from the command line.
+	int RunServer(int argc, char* argv[]);
+
+	// Function to run "client <address> [-load <games> <moves>] [-movetime ms]" from the command line. Without "-load" the lines typed
+	// are sent to the server and its replies printed. With it, that many games are opened and played by the computer on both sides for
+	// that many moves each, keeping every game's next search asked for, and the moves per second and the time each took are reported.
+	int RunClient(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+// OOP Chess Project: Session.cpp.
+// This is the GameSession class source file.
+// It contains all the definitions related to the GameSession class.
+// James Cummins.
+
+// Include the GameSession header file.
+#include "Session.h"
+
+// Using namespaces.
+using namespace SessionNamespace;
+
+// Default constructor.
+GameSession::GameSession() : Step(ChoosingMode), GameMode(1), IntelligentTurn(true) {}
+
+// Function to start the session.
+SessionStatus GameSession::Start() { return NewGame(); }
+
+// Access function for what the session is waiting for.
+SessionStatus GameSession::GetStatus() const
+{
+	if (Step == Finished) { return SessionFinished; }
+	if (Step == ComputerTurn) { return NeedsComputerMove; }
+	return NeedsInput;
+}
+
+// Function to start a new game.
+SessionStatus GameSession::NewGame()
+{
+
+	// Define the board, set the colour scheme and initialise it. Then define the game.
+	TheGame.reset();
+	TheBoard.reset(new Board);
+	TheBoard->SetColourAndBackground(15, 0);
+	TheBoard->InitialiseBoard();
+	TheGame.reset(new GameManager(TheBoard.get()));
+
+	// Print useful information.
+	cout << "Chess Game by James Cummins." << endl;
+	cout << "For maximum gaming pleasure it is recommended to maximise the console screen.\n" << endl;
+
+	// Print the chessboard, and ask for the game mode.
+	TheBoard->PrintBoard();
+	TheGame->AskGameMode();
+	Step = ChoosingMode;
+	return GetStatus();
+
+}
+
+// Function to go on to the next turn.
+SessionStatus GameSession::NextTurn()
+{
+
+	// Structure the game according to the game mode selected: in game mode 1 the humans take turns, in game modes 2 and 3
+	// the human plays white and the computer black, and in game mode 4 the intelligent computer and the random one take turns.
+	if (TheGame->IsGameOver()) { return EndGame(); }
+	if (GameMode == 1 || ((GameMode == 2 || GameMode == 3) && TheGame->GetGameTurnNumber() % 2 == 0))
+	{
+		TheGame->AskBeginOption();
+		Step = ChoosingBeginOption;
+	}
+	else
+	{
+		IntelligentTurn = true;
+		Step = ComputerTurn;
+	}
+	return GetStatus();
+
+}
+
+// Function to ask the questions at the end of a game.
+SessionStatus GameSession::EndGame()
+{
+	// Allow the user to view all the moves and save them to a file.
+	cout << "\nWould you like to display all the moves and print them to a file (Y/N)? ";
+	Step = ChoosingDisplay;
+	return GetStatus();
+}
+
+// Function to give the session a line the user typed.
+SessionStatus GameSession::GiveInput(const string& Line)
+{
+
+	// Blank lines are skipped, as they always have been.
+	if (Line.find_first_not_of(" \t\r") == string::npos) { return GetStatus(); }
+	char Answer;
+	switch (Step)
+	{
+	case ChoosingMode:
+		// Select the game mode, then give the user an option to load a previously saved game.
+		if (!TheGame->AnswerGameMode(Line, GameMode)) { break; }
+		TheGame->AskLoadGame();
+		Step = ChoosingLoad;
+		break;
+	case ChoosingLoad:
+		// Give the user the option of the neural evaluation, if a network is available.
+		if (!TheGame->AnswerLoadGame(Line)) { break; }
+		if ((GameMode == 3 || GameMode == 4) && TheGame->AskEvaluator()) { Step = ChoosingEvaluator; break; }
+		return NextTurn();
+	case ChoosingEvaluator:
+		if (!TheGame->AnswerEvaluator(Line)) { break; }
+		return NextTurn();
+	case ChoosingBeginOption:
+		// Unless the user quits, the move comes next whatever they chose.
+		if (!TheGame->AnswerBeginOption(Line, Answer)) { break; }
+		if (Answer == 'Q') { Step = Finished; break; }
+		TheGame->BeginHumanMove();
+		Step = EnteringMove;
+		break;
+	case EnteringMove:
+		if (!TheGame->AnswerHumanMove(Line)) { break; }
+		if (TheGame->IsGameOver()) { return EndGame(); }
+		TheGame->AskEndOption();
+		Step = ChoosingEndOption;
+		break;
+	case ChoosingEndOption:
+		// In game modes 2 and 3 the computer moves straight after white has given the turn over.
+		if (!TheGame->AnswerEndOption(Line, Answer)) { break; }
+		if (Answer == 'Q') { Step = Finished; break; }
+		if (GameMode == 1) { return NextTurn(); }
+		if (TheGame->GetGameTurnNumber() % 2 == 0) { TheGame->AskBeginOption(); Step = ChoosingBeginOption; }
+		else { Step = ComputerTurn; }
+		break;
+	case ChoosingDisplay:
+		if (!GoodInput(Line, 'Y', 'Y', 'N', 'N', Answer)) { break; }
+		if (Answer == 'Y')
+		{
+			cout << "\nPrinting moves:" << endl;
+			TheGame->PrintList();
+			cout << "\nMoves printed to files (ChessGame.txt and ChessGame.pgn)." << endl;
+		}
+		// Allow the user to play the chess game again.
+		cout << "\nWould you like to use the play another game (Y/N)? ";
+		Step = ChoosingRepeat;
+		break;
+	case ChoosingRepeat:
+		if (!GoodInput(Line, 'Y', 'Y', 'N', 'N', Answer)) { break; }
+		if (Answer == 'N') { Step = Finished; break; }
+		for (int i = 0; i < 100; i++) { cout << "\n" << endl; }
+		return NewGame();
+	default:
+		// The session isn't waiting for a line.
+		break;
+	}
+	return GetStatus();
+
+}
+
+// Function to let the computer make the move it is waiting for.
+SessionStatus GameSession::PlayComputerMove()
+{
+
+	// In game modes 2 and 3 the computer plays randomly or intelligently. In game mode 4 the intelligent computer moves first,
+	// and the random one replies unless the game is over.
+	if (Step != ComputerTurn) { return GetStatus(); }
+	if (GameMode != 4) { TheGame->ComputerMove(GameMode == 3); return NextTurn(); }
+	if (IntelligentTurn)
+	{
+		TheGame->ComputerMove(true);
+		if (TheGame->IsGameOver()) { return EndGame(); }
+		IntelligentTurn = false;
+		return GetStatus();
+	}
+	TheGame->ComputerMove(false);
+	return NextTurn();
+
+}
\ No newline at end of file
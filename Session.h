@@ -0,0 +1,79 @@
+// OOP Chess Project: Session.h.
+// This is the GameSession class header file.
+// It contains the declarations of the interactive game as a state machine, which can be paused whenever it needs something.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Session
+#define MY_CLASS_Session
+
+// Include the relevant libraries.
+#include <memory>
+#include <string>
+#include "GameManager.h"
+
+// Using namespaces.
+using namespace GameNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace SessionNamespace
+{
+
+	// What a session is waiting for: a line typed by the user, a move by the computer, or nothing, because it has finished.
+	enum SessionStatus { NeedsInput, NeedsComputerMove, SessionFinished };
+
+	// GameSession class.
+	// The game the user plays, from choosing a game mode to being asked whether to play again, run one step at a time.
+	// Each step asks a question or makes a move and returns what the session is waiting for next, so the session never waits
+	// for anything itself. Whoever runs it decides when to give it a line or let the computer move, and can run any number of
+	// sessions on one thread. Quitting finishes the session rather than the program.
+	class GameSession {
+
+	// Private member data.
+	private:
+
+		// The places in the game where the session waits.
+		enum SessionStep { ChoosingMode, ChoosingLoad, ChoosingEvaluator, ChoosingBeginOption, EnteringMove, ChoosingEndOption, ComputerTurn, ChoosingDisplay, ChoosingRepeat, Finished };
+
+		// The board and the game being played on it, which are new for each game.
+		unique_ptr<Board> TheBoard;
+		unique_ptr<GameManager> TheGame;
+		// Where the game is, its mode, and in game mode 4 whether it is the intelligent computer's turn.
+		SessionStep Step;
+		int GameMode;
+		bool IntelligentTurn;
+
+		// Function to start a new game, printing the board and asking for the game mode.
+		SessionStatus NewGame();
+		// Function to go on to the next turn, or to the end of the game if it is over.
+		SessionStatus NextTurn();
+		// Function to ask the questions at the end of a game.
+		SessionStatus EndGame();
+
+	// Public member functions.
+	public:
+
+		// Default constructor. The session doesn't print anything until it is started.
+		GameSession();
+		// Destructor.
+		~GameSession() {}
+
+		// Function to start the session, printing the first board and question.
+		SessionStatus Start();
+
+		// Function to give the session a line the user typed. Blank lines are ignored, as is anything given when no line is wanted.
+		SessionStatus GiveInput(const string& Line);
+
+		// Function to let the computer make the move it is waiting for. Nothing happens if it isn't waiting for one.
+		SessionStatus PlayComputerMove();
+
+		// Access function for what the session is waiting for.
+		SessionStatus GetStatus() const;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,361 @@
+// OOP Chess Project: Tournament.cpp.
+// This is the tournament source file.
+// It contains all the definitions related to playing tournaments between two settings of the engine.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <limits>
+#include "Tournament.h"
+#include "Batch.h"
+#include "Pgn.h"
+#include "Uci.h"
+#include "Zobrist.h"
+
+// Using namespaces.
+using namespace TournamentNamespace;
+using namespace BatchNamespace;
+using namespace PgnNamespace;
+using namespace UciNamespace;
+using namespace ZobristNamespace;
+
+// How a game ended: its result ("" if it was stopped before the end), why, and whether it was adjudicated.
+struct GameOutcome { string Result, Ending; bool Adjudicated; };
+
+// Function to read engine settings.
+bool TournamentNamespace::ParseEngineSettings(const string& Text, EngineSettings& Settings)
+{
+
+	// Each setting is a name and a value joined by '='. An engine given no limit searches 2000 nodes a move.
+	Settings = { Text, { 0, 0, 0.0 }, -1.0, "" };
+	stringstream Stream(Text);
+	string Item;
+	while (getline(Stream, Item, ','))
+	{
+		size_t Equals{ Item.find('=') };
+		if (Equals == string::npos) { return false; }
+		string Name{ Item.substr(0, Equals) }, Value{ Item.substr(Equals + 1) };
+		if (Name == "depth") { Settings.Limits.Depth = atoi(Value.c_str()); }
+		else if (Name == "nodes") { Settings.Limits.Nodes = atoll(Value.c_str()); }
+		else if (Name == "time") { Settings.Limits.Seconds = atof(Value.c_str()); }
+		else if (Name == "lazy") { Settings.LazyMargin = atof(Value.c_str()); }
+		else if (Name == "nn") { Settings.NetworkFile = Value; }
+		else { return false; }
+	}
+	if (Settings.Limits.Depth < 0 || Settings.Limits.Nodes < 0 || Settings.Limits.Seconds < 0) { return false; }
+	if (Settings.Limits.Depth == 0 && Settings.Limits.Nodes == 0 && Settings.Limits.Seconds == 0) { Settings.Limits.Nodes = 2000; }
+	return true;
+
+}
+
+// Function to return the default settings.
+TournamentOptions TournamentNamespace::DefaultTournamentOptions()
+{
+	TournamentOptions Options;
+	ParseEngineSettings("nodes=2000", Options.Engines[0]);
+	ParseEngineSettings("nodes=2000", Options.Engines[1]);
+	Options.Games = 20000;
+	Options.Threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+	Options.RandomPlies = 8;
+	Options.Seed = static_cast<uint64_t>(time(NULL));
+	Options.MaximumPlies = 400;
+	Options.WinScore = 60.0;
+	Options.WinMoves = 4;
+	Options.DrawScore = 1.0;
+	Options.DrawMoves = 8;
+	Options.DrawPly = 80;
+	Options.Elo0 = -10.0;
+	Options.Elo1 = 0.0;
+	Options.Alpha = Options.Beta = 0.05;
+	return Options;
+}
+
+// Function to work out the average score of a game and its variance, counting a win as 1 and a draw as a half.
+static void ScoreMoments(const TournamentScore& Score, double& Mean, double& Variance)
+{
+	double Games{ static_cast<double>(Score.Wins + Score.Draws + Score.Losses) };
+	Mean = (Score.Wins + 0.5 * Score.Draws) / Games;
+	Variance = (Score.Wins + 0.25 * Score.Draws) / Games - Mean * Mean;
+}
+
+// Functions to convert between an average score and the Elo difference that would give it.
+// A score of 0% or 100% gives an infinite difference, which prints as "-inf" or "inf".
+static double EloFromScore(double Score) { return 400.0 * log10(Score / (1.0 - Score)); }
+static double ScoreFromElo(double Elo) { return 1.0 / (1.0 + pow(10.0, -Elo / 400.0)); }
+
+// Function to work out the Elo difference a score shows.
+double TournamentNamespace::ScoreElo(const TournamentScore& Score)
+{
+	if (Score.Wins + Score.Draws + Score.Losses == 0) { return 0.0; }
+	double Mean, Variance;
+	ScoreMoments(Score, Mean, Variance);
+	return EloFromScore(Mean);
+}
+
+// Function to work out the 95% error margin of the Elo difference, from the standard error of the average score.
+// If the interval reaches a score of 0% or 100% (as it always does when every game has been won or lost) the margin is infinite.
+double TournamentNamespace::EloErrorMargin(const TournamentScore& Score)
+{
+	long long Games{ Score.Wins + Score.Draws + Score.Losses };
+	if (Games == 0) { return 0.0; }
+	double Mean, Variance;
+	ScoreMoments(Score, Mean, Variance);
+	double Error{ 1.96 * sqrt(max(0.0, Variance) / Games) };
+	if (Mean - Error <= 0.0 || Mean + Error >= 1.0) { return numeric_limits<double>::infinity(); }
+	return (EloFromScore(Mean + Error) - EloFromScore(Mean - Error)) / 2;
+}
+
+// Function to work out the log likelihood ratio of the sequential probability ratio test.
+// With the score of a game taken as normal with the variance seen so far, the ratio of the likelihoods of the average scores
+// the two Elo differences would give is N((s - s0)^2 - (s - s1)^2) / 2v. Half a win and half a loss are added to the games,
+// so a run of nothing but wins or draws still has a variance and the test can decide on it.
+double TournamentNamespace::SprtLogLikelihoodRatio(const TournamentScore& Score, double Elo0, double Elo1)
+{
+	long long Games{ Score.Wins + Score.Draws + Score.Losses };
+	if (Games == 0) { return 0.0; }
+	double Mean{ (Score.Wins + 0.5 * Score.Draws + 0.5) / (Games + 1) };
+	double Variance{ (Score.Wins + 0.25 * Score.Draws + 0.5) / (Games + 1) - Mean * Mean };
+	double Score0{ ScoreFromElo(Elo0) }, Score1{ ScoreFromElo(Elo1) };
+	return (Score1 - Score0) * (2 * Mean - Score0 - Score1) / (2 * Variance / Games);
+}
+
+// Function to make an opening of random moves from the usual starting position. The same seed gives the same opening.
+// Openings that end the game are thrown away.
+static FENPosition RandomOpening(int Plies, uint64_t Seed)
+{
+	mt19937_64 Random(Seed);
+	PositionMove Legal[MaximumMoves];
+	while (true)
+	{
+		FENPosition Position;
+		ParseFEN(StartingFEN, Position);
+		int Ply{ 0 };
+		for (; Ply < Plies; Ply++)
+		{
+			int NumberOfMoves{ GenerateLegalMoves(Position, Legal) };
+			if (NumberOfMoves == 0) { break; }
+			MakePositionMove(Position, Legal[Random() % NumberOfMoves]);
+		}
+		if (Ply == Plies && FindGameEnding(Position) == NotFinished) { return Position; }
+	}
+}
+
+// Function to play a game between the two engines, Engines[0] being white, and record its moves.
+static GameOutcome PlayTournamentGame(GameManager* Engines[2], const EngineSettings* Settings[2], const FENPosition& Start,
+	const TournamentOptions& Options, const atomic<bool>& Stop, vector<PositionMove>& Moves)
+{
+
+	// Play until the game ends, remembering the positions since the last capture or pawn move to spot repetitions.
+	FENPosition Position{ Start };
+	vector<uint64_t> Keys{ PositionKey(Position) };
+	int WinPlies{ 0 }, DrawPlies{ 0 };
+	bool WhiteWinning{ false };
+	for (int Ply = 0; ; Ply++)
+	{
+		GameEnding End{ FindGameEnding(Position) };
+		if (End != NotFinished) { return { GameEndingResult(Position, End), GameEndingName(End), false }; }
+		if (count(Keys.begin(), Keys.end(), Keys.back()) >= 3) { return { "1/2-1/2", "threefold repetition", false }; }
+		if (Ply >= Options.MaximumPlies) { return { "1/2-1/2", "move limit", true }; }
+
+		// The side to move searches. Scores are from white's point of view.
+		int Side{ Position.WhiteToMove ? 0 : 1 };
+		Engines[Side]->SetPosition(Position);
+		SearchResult Found{ Engines[Side]->LimitedSearch(Settings[Side]->Limits, &Stop) };
+		if (Stop) { return { "", "stopped", false }; }
+
+		// Count how long the scores have shown a clear win, or a dead draw. A mate score isn't counted, as the engine can't tell it
+		// from stalemate, and a real mate doesn't take long to play out.
+		if (fabs(Found.Score) >= Options.WinScore && fabs(Found.Score) < 9000)
+		{
+			if (WinPlies > 0 && (Found.Score > 0) != WhiteWinning) { WinPlies = 0; }
+			WhiteWinning = Found.Score > 0;
+			WinPlies++;
+		}
+		else { WinPlies = 0; }
+		DrawPlies = Ply + 1 >= Options.DrawPly && fabs(Found.Score) <= Options.DrawScore ? DrawPlies + 1 : 0;
+
+		// Make the move, checking it against the legal moves like any other.
+		char Text[8];
+		PositionMove Move;
+		WriteUciMove(Position.Codes, Found.Move, Text);
+		if (Found.Depth == 0 || !ParseUciMove(Position, Text, Move)) { return { Position.WhiteToMove ? "0-1" : "1-0", "illegal move", false }; }
+		Moves.push_back(Move);
+		MakePositionMove(Position, Move);
+		if (Position.HalfmoveClock == 0) { Keys.clear(); }
+		Keys.push_back(PositionKey(Position));
+
+		// Both engines have to agree, so the scores must have held for the moves of both sides.
+		if (Options.WinMoves > 0 && WinPlies >= 2 * Options.WinMoves) { return { WhiteWinning ? "1-0" : "0-1", "adjudicated win", true }; }
+		if (Options.DrawMoves > 0 && DrawPlies >= 2 * Options.DrawMoves) { return { "1/2-1/2", "adjudicated draw", true }; }
+	}
+
+}
+
+// Function to print the score so far.
+static void PrintScore(const TournamentScore& Score, const TournamentOptions& Options)
+{
+	long long Games{ Score.Wins + Score.Draws + Score.Losses };
+	cout << "Games " << Games << ": +" << Score.Wins << " =" << Score.Draws << " -" << Score.Losses << fixed << setprecision(1)
+		<< " (" << (Games > 0 ? 100.0 * (Score.Wins + 0.5 * Score.Draws) / Games : 0.0) << "%), Elo " << ScoreElo(Score) << " +/- " << EloErrorMargin(Score)
+		<< ", LLR " << setprecision(2) << SprtLogLikelihoodRatio(Score, Options.Elo0, Options.Elo1) << " [" << log(Options.Beta / (1 - Options.Alpha))
+		<< ", " << log((1 - Options.Beta) / Options.Alpha) << "]" << endl;
+}
+
+// Function to play the tournament.
+TournamentScore TournamentNamespace::RunTournament(const TournamentOptions& Options)
+{
+
+	// The test stops when the log likelihood ratio leaves the bounds the error chances give.
+	const double LowerBound{ log(Options.Beta / (1 - Options.Alpha)) }, UpperBound{ log((1 - Options.Beta) / Options.Alpha) };
+	TournamentScore Score{ 0, 0, 0 };
+	ofstream Pgn;
+	if (!Options.PgnFile.empty())
+	{
+		Pgn.open(Options.PgnFile);
+		if (!Pgn.is_open()) { cerr << "Error: Unable to open " << Options.PgnFile << " for saving." << endl; return Score; }
+	}
+
+	// Set the two engines up once, so a neural network is only loaded a single time.
+	Board EngineBoards[2];
+	GameManager FirstEngine(&EngineBoards[0]), SecondEngine(&EngineBoards[1]);
+	GameManager* Engines[2]{ &FirstEngine, &SecondEngine };
+	for (int i = 0; i < 2; i++)
+	{
+		EngineBoards[i].InitialiseBoard();
+		if (Options.Engines[i].LazyMargin >= 0) { Engines[i]->SetLazyEvaluationMargin(Options.Engines[i].LazyMargin); }
+		if (Options.Engines[i].NetworkFile.empty()) { continue; }
+		if (!Engines[i]->LoadNeuralNetwork(Options.Engines[i].NetworkFile))
+		{
+			cerr << "Error: Could not load the neural network " << Options.Engines[i].NetworkFile << "." << endl;
+			return Score;
+		}
+		Engines[i]->SetEvaluator(NeuralEvaluation);
+	}
+
+	// Each thread plays the next game nobody has started. Games come in pairs from the same opening with the colours swapped,
+	// so an opening that favours one side favours both engines equally.
+	atomic<long long> NextGame{ 0 };
+	atomic<bool> Stop{ false };
+	mutex ScoreLock;
+	int Decision{ 0 };
+	auto Worker = [&]() {
+
+		// The thread has a board for each engine, and a clone of the engine on it. The clones share the engines' networks.
+		Board Boards[2];
+		GameManager First(&Boards[0]), Second(&Boards[1]);
+		GameManager* Games[2]{ &First, &Second };
+		for (int i = 0; i < 2; i++) { Games[i]->CloneFrom(*Engines[i]); }
+
+		for (long long Game = NextGame++; Game < Options.Games && !Stop; Game = NextGame++)
+		{
+			long long Pair{ Game / 2 };
+			bool FirstIsWhite{ Game % 2 == 0 };
+			FENPosition Opening{ Options.Openings.empty() ? RandomOpening(Options.RandomPlies, Options.Seed + static_cast<uint64_t>(Pair))
+				: Options.Openings[static_cast<size_t>(Pair) % Options.Openings.size()] };
+			GameManager* Players[2]{ Games[FirstIsWhite ? 0 : 1], Games[FirstIsWhite ? 1 : 0] };
+			const EngineSettings* Settings[2]{ &Options.Engines[FirstIsWhite ? 0 : 1], &Options.Engines[FirstIsWhite ? 1 : 0] };
+			PgnGame Record;
+			Record.StartingPosition = Opening;
+			GameOutcome Outcome{ PlayTournamentGame(Players, Settings, Opening, Options, Stop, Record.Moves) };
+			if (Outcome.Result.empty()) { break; }
+
+			// Add the result for the first engine, write the game and see if the test has decided.
+			lock_guard<mutex> Lock(ScoreLock);
+			if (Outcome.Result == "1/2-1/2") { Score.Draws++; }
+			else if ((Outcome.Result == "1-0") == FirstIsWhite) { Score.Wins++; }
+			else { Score.Losses++; }
+			if (Pgn.is_open())
+			{
+				char FEN[MaximumFENLength];
+				string OpeningFEN(FEN, WriteFEN(Opening, FEN));
+				Record.Result = Outcome.Result;
+				Record.Tags = { {"Event", "Tournament"}, {"Site", "?"}, {"Date", "????.??.??"}, {"Round", to_string(Game + 1)},
+					{"White", Settings[0]->Name}, {"Black", Settings[1]->Name}, {"Result", Outcome.Result}, {"Termination", Outcome.Adjudicated ? "adjudication" : "normal"} };
+				if (OpeningFEN != StartingFEN) { Record.Tags.push_back({ "SetUp", "1" }); Record.Tags.push_back({ "FEN", OpeningFEN }); }
+				WritePgnGame(Pgn, Record);
+			}
+			double Ratio{ SprtLogLikelihoodRatio(Score, Options.Elo0, Options.Elo1) };
+			long long Played{ Score.Wins + Score.Draws + Score.Losses };
+			if (Decision == 0 && (Ratio <= LowerBound || Ratio >= UpperBound))
+			{
+				Decision = Ratio >= UpperBound ? 1 : -1;
+				Stop = true;
+			}
+			if (Played % 10 == 0 || Decision != 0) { PrintScore(Score, Options); }
+		}
+
+	};
+
+	int Threads{ static_cast<int>(max(1LL, min(static_cast<long long>(Options.Threads), Options.Games))) };
+	vector<thread> Workers;
+	for (int i = 1; i < Threads; i++) { Workers.emplace_back(Worker); }
+	Worker();
+	for (thread& TheThread : Workers) { TheThread.join(); }
+
+	// Report the result of the test.
+	if (Decision == 0 && (Score.Wins + Score.Draws + Score.Losses) % 10 != 0) { PrintScore(Score, Options); }
+	cout << "SPRT of " << Options.Elo0 << " against " << Options.Elo1 << " Elo: ";
+	if (Decision > 0) { cout << "H1 accepted, " << Options.Engines[0].Name << " is no weaker than " << Options.Engines[1].Name << "." << endl; }
+	else if (Decision < 0) { cout << "H0 accepted, " << Options.Engines[0].Name << " is weaker than " << Options.Engines[1].Name << "." << endl; }
+	else { cout << "no decision after " << Score.Wins + Score.Draws + Score.Losses << " games." << endl; }
+	return Score;
+
+}
+
+// Function to run "tournament ..." from the command line.
+int TournamentNamespace::RunTournamentCommand(int argc, char* argv[])
+{
+
+	// Read the settings.
+	TournamentOptions Options{ DefaultTournamentOptions() };
+	for (int i = 2; i < argc; i++)
+	{
+		string Option{ argv[i] };
+		if (i + 1 >= argc) { cerr << "Error: " << Option << " needs a value." << endl; return 1; }
+		string Value{ argv[++i] };
+		if (Option == "-engine1" || Option == "-engine2")
+		{
+			if (!ParseEngineSettings(Value, Options.Engines[Option == "-engine1" ? 0 : 1])) { cerr << "Error: \"" << Value << "\" is not a valid engine setting." << endl; return 1; }
+		}
+		else if (Option == "-games") { Options.Games = atoll(Value.c_str()); }
+		else if (Option == "-threads") { Options.Threads = atoi(Value.c_str()); }
+		else if (Option == "-openings") { if (!LoadBatchPositions(Value, Options.Openings)) { return 1; } }
+		else if (Option == "-random") { Options.RandomPlies = atoi(Value.c_str()); }
+		else if (Option == "-seed") { Options.Seed = strtoull(Value.c_str(), nullptr, 10); }
+		else if (Option == "-plies") { Options.MaximumPlies = atoi(Value.c_str()); }
+		else if (Option == "-win" && i + 1 < argc) { Options.WinScore = atof(Value.c_str()); Options.WinMoves = atoi(argv[++i]); }
+		else if (Option == "-draw" && i + 2 < argc) { Options.DrawScore = atof(Value.c_str()); Options.DrawMoves = atoi(argv[++i]); Options.DrawPly = atoi(argv[++i]); }
+		else if (Option == "-elo0") { Options.Elo0 = atof(Value.c_str()); }
+		else if (Option == "-elo1") { Options.Elo1 = atof(Value.c_str()); }
+		else if (Option == "-alpha") { Options.Alpha = atof(Value.c_str()); }
+		else if (Option == "-beta") { Options.Beta = atof(Value.c_str()); }
+		else if (Option == "-pgn") { Options.PgnFile = Value; }
+		else { cerr << "Error: Did not recognise " << Option << "." << endl; return 1; }
+	}
+	if (Options.Games <= 0) { cerr << "Error: The number of games must be positive." << endl; return 1; }
+	if (Options.Elo0 >= Options.Elo1 || Options.Alpha <= 0 || Options.Alpha >= 0.5 || Options.Beta <= 0 || Options.Beta >= 0.5)
+	{
+		cerr << "Error: The SPRT needs elo0 below elo1, and alpha and beta between 0 and 0.5." << endl;
+		return 1;
+	}
+
+	// Play the tournament.
+	cout << "Tournament of " << Options.Engines[0].Name << " against " << Options.Engines[1].Name << ", at most " << Options.Games << " games." << endl;
+	auto Start = chrono::steady_clock::now();
+	TournamentScore Score{ RunTournament(Options) };
+	long long Games{ Score.Wins + Score.Draws + Score.Losses };
+	if (Games == 0) { return 1; }
+	double Seconds{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+	cout << "Played " << Games << " games in " << fixed << setprecision(1) << Seconds << " seconds." << endl;
+	return 0;
+
+}
\ No newline at end of file
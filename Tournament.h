@@ -0,0 +1,89 @@
+// OOP Chess Project: Tournament.h.
+// This is the tournament header file.
+// It contains the declarations of the tournament runner, which plays two settings of the engine against each other to compare their strength.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Tournament
+#define MY_CLASS_Tournament
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameManager.h"
+
+// Using namespaces.
+using namespace GameNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace TournamentNamespace
+{
+
+	// The settings of one of the engines: the limits of its searches, its lazy evaluation margin (negative to leave the game's own)
+	// and the neural network it evaluates with (none for the classic evaluation).
+	struct EngineSettings {
+		string Name;
+		SearchLimits Limits;
+		double LazyMargin;
+		string NetworkFile;
+	};
+
+	// Function to read engine settings written as "nodes=2000,depth=3,time=0.1,lazy=2,nn=network.bin", in any order.
+	// Returns false if any of it can't be read. The settings are also the engine's name.
+	bool ParseEngineSettings(const string& Text, EngineSettings& Settings);
+
+	// The settings of a tournament.
+	struct TournamentOptions {
+		// The two engines. The first is the one being tested, so scores and Elo are given from its point of view.
+		EngineSettings Engines[2];
+		// The most games to play, and the number of threads playing them, one game each.
+		long long Games;
+		int Threads;
+		// Each opening is played twice, once with each engine as white. The openings are the positions in a file,
+		// or if there isn't one, this many random half moves from the usual starting position chosen with the seed.
+		vector<FENPosition> Openings;
+		int RandomPlies;
+		uint64_t Seed;
+		// The longest a game may last in half moves before it is a draw.
+		int MaximumPlies;
+		// A game is given to a side once both engines have scored it at least WinScore ahead for WinMoves moves running,
+		// and drawn once, after DrawPly half moves, both have scored it within DrawScore for DrawMoves moves running.
+		// A number of moves of zero turns that adjudication off. Scores count a pawn as 10.
+		double WinScore, DrawScore;
+		int WinMoves, DrawMoves, DrawPly;
+		// The sequential probability ratio test: the Elo difference of the hypothesis that the tested engine is worse (Elo0) and
+		// that it isn't (Elo1), and the chances of wrongly accepting each. The tournament stops as soon as one is accepted.
+		double Elo0, Elo1, Alpha, Beta;
+		// The file the games are written to as PGN, if any.
+		string PgnFile;
+	};
+
+	// Function to return the default settings: both engines searching 2000 nodes a move, at most 20000 games on every core,
+	// 8 random half moves, games of at most 400 half moves, a win at 60 for 4 moves, a draw within 1 for 8 moves after 80 half moves,
+	// and a test of -10 against 0 Elo with 5% errors.
+	TournamentOptions DefaultTournamentOptions();
+
+	// The games the tested engine has won, drawn and lost.
+	struct TournamentScore {
+		long long Wins, Draws, Losses;
+	};
+
+	// Functions to work out the Elo difference a score shows, its 95% error margin, and the log likelihood ratio of the
+	// sequential probability ratio test of Elo0 against Elo1 (using the normal approximation to a game's score).
+	double ScoreElo(const TournamentScore& Score);
+	double EloErrorMargin(const TournamentScore& Score);
+	double SprtLogLikelihoodRatio(const TournamentScore& Score, double Elo0, double Elo1);
+
+	// Function to play the tournament, printing its progress. Returns the score, which is all zeros if an engine couldn't be set up.
+	TournamentScore RunTournament(const TournamentOptions& Options);
+
+	// Function to run "tournament [-engine1 settings] [-engine2 settings] [-games N] [-threads N] [-openings file] [-random N] [-seed N]
+	// [-plies N] [-win score moves] [-draw score moves ply] [-elo0 E] [-elo1 E] [-alpha A] [-beta B] [-pgn file]" from the command line.
+	int RunTournamentCommand(int argc, char* argv[]);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,283 @@
+// OOP Chess Project: Tuner.cpp.
+// This is the Tuner class source file.
+// It contains the definitions of the offline tuner that fits the evaluation parameters to the results of real games.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include "Tuner.h"
+#include "Board.h"
+
+// Using namespaces.
+using namespace TunerNamespace;
+using namespace BoardNamespace;
+
+// The largest number of features one position can have: a value and a table entry for each of 32 pieces, plus the positional terms.
+const int MaximumFeatures{ 2 * 32 + MaximumPositionalFeatures };
+
+// Function to run the tuner commands named on the command line.
+int TunerNamespace::RunTuner(int argc, char* argv[])
+{
+
+	string Command{ argv[1] };
+
+	// Convert a text file into a packed data file.
+	if (Command == "pack")
+	{
+		if (argc < 4) { cerr << "Error: Usage is pack <text file> <data file>." << endl; return 1; }
+		long long Written{ ConvertTextPositions(argv[2], argv[3]) };
+		if (Written < 0) { return 1; }
+		cout << "Packed " << Written << " positions into " << argv[3] << "." << endl;
+		return 0;
+	}
+
+	// Otherwise tune.
+	if (argc < 3) { cerr << "Error: Usage is tune <data file> [epochs] [output file] [threads]." << endl; return 1; }
+	int Epochs{ 300 }, Threads{ static_cast<int>(thread::hardware_concurrency()) };
+	string OutputFile{ argc > 4 ? argv[4] : "EvalParameters.txt" };
+	// Exception handling in case the epochs or threads aren't numbers.
+	try
+	{
+		if (argc > 3) { Epochs = stoi(argv[3]); }
+		if (argc > 5) { Threads = stoi(argv[5]); }
+	}
+	catch (exception&) { cerr << "Error: The epochs and threads must be whole numbers." << endl; return 1; }
+	// The hardware can report 0 threads when it doesn't know.
+	Threads = max(Threads, 1);
+
+	// Start from the parameters the engine is using, map the data and check the features before tuning.
+	Tuner TheTuner(ActiveParameters(), Threads);
+	if (!TheTuner.LoadDataFile(argv[2])) { return 1; }
+	int Mismatches{ TheTuner.CheckAgainstBoard(1000) };
+	if (Mismatches > 0) { cerr << "Error: " << Mismatches << " positions are scored differently by the tuner and the board." << endl; return 1; }
+	TheTuner.FitScalingConstant();
+	TheTuner.Run(Epochs, 0.1, 25, OutputFile);
+	return 0;
+
+}
+
+// Parameterised constructor.
+Tuner::Tuner(const EvaluationParameters& StartingParameters, int Threads)
+{
+
+	Positions = nullptr;
+	NumberOfPositions = 0;
+	Parameters = ParametersToVector(StartingParameters);
+	// The pawn value sets the scale of everything else, and the king value cancels out, so both are held fixed.
+	Fixed.assign(NumberOfParameters, false);
+	Fixed[PawnType] = Fixed[KingType] = true;
+	ScalingConstant = 0.05;
+	NumberOfThreads = max(Threads, 1);
+
+}
+
+// Function to map the data file.
+bool Tuner::LoadDataFile(const string& FileName)
+{
+
+	if (!DataFile.Open(FileName)) { return false; }
+	if (DataFile.GetSize() % sizeof(PackedPosition) != 0 || DataFile.GetSize() == 0)
+	{
+		cerr << "Error: " << FileName << " is not a packed position file." << endl;
+		DataFile.Close();
+		return false;
+	}
+	Positions = reinterpret_cast<const PackedPosition*>(DataFile.GetData());
+	NumberOfPositions = DataFile.GetSize() / sizeof(PackedPosition);
+	cout << "Loaded " << NumberOfPositions << " positions from " << FileName << "." << endl;
+	return true;
+
+}
+
+// Function to work out the features of one position.
+// The material and position tables are listed here, and the positional terms come from the attack maps,
+// exactly as Board::EvaluateBoard and Board::EvaluatePositionalTerms score them (CheckAgainstBoard makes sure of this).
+int Tuner::ExtractFeatures(const PackedPosition& Position, int Indices[], double Weights[])
+{
+
+	// For each piece code: its type and its sign.
+	static const int CodeType[NumberOfPieceCodes]{ 0, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5 };
+	static const double CodeSign[NumberOfPieceCodes]{ 0, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1 };
+
+	// Find the occupied squares first, so that the loop below only visits the pieces.
+	// Testing every square in turn is much slower, since whether a square is empty is impossible to predict.
+	uint8_t Codes[64];
+	UnpackPosition(Position, Codes);
+	Bitboard Occupied{ 0 };
+	for (int Square = 0; Square < 64; Square++) { Occupied |= static_cast<Bitboard>(Codes[Square] != NoPieceCode) << Square; }
+
+	// Material and position tables. Black uses the table rotated by 180 degrees and subtracts it.
+	// The piece values are gathered together first, since many pieces share them.
+	double PieceValueWeights[NumberOfPieceTypes]{};
+	int Count{ 0 };
+	for (; Occupied; Occupied &= Occupied - 1)
+	{
+		int Square{ LowestBit(Occupied) }, Code{ Codes[Square] };
+		double Sign{ CodeSign[Code] };
+		PieceValueWeights[CodeType[Code]] += Sign;
+		Indices[Count] = PositionTableOffset + 64 * CodeType[Code] + (Sign > 0 ? Square : 63 - Square);
+		Weights[Count++] = Sign;
+	}
+	for (int Type = 0; Type < NumberOfPieceTypes; Type++)
+	{
+		Indices[Count] = Type; Weights[Count] = PieceValueWeights[Type]; Count += PieceValueWeights[Type] != 0;
+	}
+
+	// The positional terms.
+	AttackMaps Maps;
+	Maps.Build(Codes);
+	return Count + PositionalFeatures(Maps.CountTerms(), Indices + Count, Weights + Count);
+
+}
+
+// Function to add the error and gradient of a range of positions.
+void Tuner::AccumulateRange(size_t Begin, size_t End, double K, double& Error, double* Gradient) const
+{
+
+	int Indices[MaximumFeatures];
+	double Weights[MaximumFeatures];
+	Error = 0;
+	for (size_t n = Begin; n < End; n++)
+	{
+		// The evaluation is the weighted sum of the parameters, turned into an expected score by the sigmoid.
+		int Count{ ExtractFeatures(Positions[n], Indices, Weights) };
+		double Evaluation{ 0 };
+		for (int f = 0; f < Count; f++) { Evaluation += Weights[f] * Parameters[Indices[f]]; }
+		double Expected{ 1.0 / (1.0 + exp(-K * Evaluation)) };
+		double Difference{ Expected - ResultScore(Positions[n]) };
+		Error += Difference * Difference;
+
+		// The derivative of the squared error with respect to each parameter used.
+		if (Gradient)
+		{
+			double Factor{ 2.0 * Difference * Expected * (1.0 - Expected) * K };
+			for (int f = 0; f < Count; f++) { Gradient[Indices[f]] += Factor * Weights[f]; }
+		}
+	}
+
+}
+
+// Function to return the mean squared error over every position.
+double Tuner::ComputeError(double K, vector<double>* Gradient) const
+{
+
+	// Each thread works on its own slice of the data with its own gradient, and the results are added up at the end.
+	vector<double> Errors(NumberOfThreads, 0.0);
+	vector<vector<double>> Gradients(Gradient ? NumberOfThreads : 0, vector<double>(NumberOfParameters, 0.0));
+	vector<thread> Threads;
+	for (int t = 0; t < NumberOfThreads; t++)
+	{
+		size_t Begin{ NumberOfPositions * t / NumberOfThreads }, End{ NumberOfPositions * (t + 1) / NumberOfThreads };
+		Threads.emplace_back([this, t, Begin, End, K, Gradient, &Errors, &Gradients]() {
+			AccumulateRange(Begin, End, K, Errors[t], Gradient ? Gradients[t].data() : nullptr);
+		});
+	}
+	for (auto& Worker : Threads) { Worker.join(); }
+
+	// Add up the results.
+	double Error{ 0 };
+	for (int t = 0; t < NumberOfThreads; t++) { Error += Errors[t]; }
+	if (Gradient)
+	{
+		Gradient->assign(NumberOfParameters, 0.0);
+		for (int t = 0; t < NumberOfThreads; t++)
+		{
+			for (int p = 0; p < NumberOfParameters; p++) { (*Gradient)[p] += Gradients[t][p] / NumberOfPositions; }
+		}
+	}
+	return Error / NumberOfPositions;
+
+}
+
+// Function to check that the features reproduce the board's own evaluation.
+int Tuner::CheckAgainstBoard(size_t Count) const
+{
+
+	// The board evaluates with the active parameters, so use those here too.
+	int Mismatches{ 0 }, Indices[MaximumFeatures];
+	double Weights[MaximumFeatures];
+	vector<double> Active{ ParametersToVector(ActiveParameters()) };
+	for (size_t n = 0; n < min(Count, NumberOfPositions); n++)
+	{
+		// Set up the position on an empty board.
+		Board TheBoard;
+		for (int Square = 0; Square < 64; Square++)
+		{
+			int Code{ PackedSquare(Positions[n], Square) };
+			if (Code != NoPieceCode) { TheBoard.AddPiece(MakePiece(Code, Square / 8, Square % 8)); }
+		}
+		double Expected{ TheBoard.EvaluateBoard() + TheBoard.EvaluatePositionalTerms() };
+		double Evaluation{ 0 };
+		int Features{ ExtractFeatures(Positions[n], Indices, Weights) };
+		for (int f = 0; f < Features; f++) { Evaluation += Weights[f] * Active[Indices[f]]; }
+		if (fabs(Evaluation - Expected) > 1e-6) { Mismatches++; }
+	}
+	return Mismatches;
+
+}
+
+// Function to find the scaling constant that best fits the current parameters.
+double Tuner::FitScalingConstant()
+{
+
+	// The error is a smooth bowl in K, so a golden section search finds the bottom.
+	const double Ratio{ (sqrt(5.0) - 1.0) / 2.0 };
+	double Low{ 0.001 }, High{ 1.0 };
+	double A{ High - Ratio * (High - Low) }, B{ Low + Ratio * (High - Low) };
+	double ErrorA{ ComputeError(A, nullptr) }, ErrorB{ ComputeError(B, nullptr) };
+	while (High - Low > 1e-4)
+	{
+		if (ErrorA < ErrorB) { High = B; B = A; ErrorB = ErrorA; A = High - Ratio * (High - Low); ErrorA = ComputeError(A, nullptr); }
+		else { Low = A; A = B; ErrorA = ErrorB; B = Low + Ratio * (High - Low); ErrorB = ComputeError(B, nullptr); }
+	}
+	ScalingConstant = (Low + High) / 2.0;
+	cout << fixed << setprecision(5) << "Scaling constant K = " << ScalingConstant << ", error = " << setprecision(6) << ComputeError(ScalingConstant, nullptr) << endl;
+	return ScalingConstant;
+
+}
+
+// Function to run a number of epochs of Adam.
+void Tuner::Run(int Epochs, double LearningRate, int ReportEvery, const string& OutputFile)
+{
+
+	// The Adam moment estimates.
+	const double Beta1{ 0.9 }, Beta2{ 0.999 }, Epsilon{ 1e-8 };
+	vector<double> Gradient, Momentum(NumberOfParameters, 0.0), Velocity(NumberOfParameters, 0.0);
+	auto Start = chrono::steady_clock::now();
+
+	for (int Epoch = 1; Epoch <= Epochs; Epoch++)
+	{
+		// One step uses the gradient over the whole data file.
+		double Error{ ComputeError(ScalingConstant, &Gradient) };
+		for (int p = 0; p < NumberOfParameters; p++)
+		{
+			if (Fixed[p]) { continue; }
+			Momentum[p] = Beta1 * Momentum[p] + (1.0 - Beta1) * Gradient[p];
+			Velocity[p] = Beta2 * Velocity[p] + (1.0 - Beta2) * Gradient[p] * Gradient[p];
+			double MomentumHat{ Momentum[p] / (1.0 - pow(Beta1, Epoch)) }, VelocityHat{ Velocity[p] / (1.0 - pow(Beta2, Epoch)) };
+			Parameters[p] -= LearningRate * MomentumHat / (sqrt(VelocityHat) + Epsilon);
+		}
+
+		// Report progress and save, so that stopping early still leaves a usable file.
+		if (Epoch % ReportEvery == 0 || Epoch == Epochs)
+		{
+			double Elapsed{ chrono::duration<double>(chrono::steady_clock::now() - Start).count() };
+			cout << fixed << "Epoch " << Epoch << ": error = " << setprecision(6) << Error << ", " << setprecision(1) << Elapsed << " seconds." << endl;
+			SaveParameters(OutputFile, GetParameters());
+		}
+	}
+	cout << "Tuned parameters saved to " << OutputFile << "." << endl;
+
+}
+
+// Function to return the tuned parameters.
+EvaluationParameters Tuner::GetParameters() const
+{
+	EvaluationParameters Tuned{ ActiveParameters() };
+	ParametersFromVector(Parameters, Tuned);
+	return Tuned;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+// OOP Chess Project: Tuner.h.
+// This is the Tuner class header file.
+// It contains the declarations of the offline tuner that fits the evaluation parameters to the results of real games.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Tuner
+#define MY_CLASS_Tuner
+
+// Include the relevant libraries.
+#include <vector>
+#include <string>
+#include "EvalParameters.h"
+#include "MappedFile.h"
+#include "PackedPosition.h"
+#include "AttackMaps.h"
+
+// Using namespaces.
+using namespace ParameterNamespace;
+using namespace FileNamespace;
+using namespace PackedNamespace;
+using namespace AttackNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace TunerNamespace
+{
+
+	// Function to run the tuner commands named on the command line:
+	// "pack <text file> <data file>" converts FEN + result lines into a packed data file, and
+	// "tune <data file> [epochs] [output file] [threads]" tunes the parameters and writes them to the output file.
+	int RunTuner(int argc, char* argv[]);
+
+	// Tuner class.
+	// The evaluation is a weighted sum of the parameters, so each position is turned into a short list of
+	// (parameter, weight) features and the prediction error over the whole data file is minimised with Adam.
+	class Tuner {
+
+	// Private member data.
+	private:
+
+		// The memory-mapped data file and the positions in it.
+		MappedFile DataFile;
+		const PackedPosition* Positions;
+		size_t NumberOfPositions;
+		// The parameters being tuned, and which of them are held fixed.
+		vector<double> Parameters;
+		vector<bool> Fixed;
+		// The constant that turns an evaluation into an expected score.
+		double ScalingConstant;
+		// The number of threads to share the work between.
+		int NumberOfThreads;
+
+		// Function to work out the features of one position. Returns the number of features written.
+		static int ExtractFeatures(const PackedPosition& Position, int Indices[], double Weights[]);
+
+		// Function to add the error and (optionally) the gradient of a range of positions.
+		void AccumulateRange(size_t Begin, size_t End, double K, double& Error, double* Gradient) const;
+
+		// Function to return the mean squared error over every position, and fill in the gradient if one is given.
+		double ComputeError(double K, vector<double>* Gradient) const;
+
+	// Public member functions.
+	public:
+
+		// Parameterised constructor, starting from the given parameters.
+		Tuner(const EvaluationParameters& StartingParameters, int Threads);
+		// Destructor.
+		~Tuner() {}
+
+		// Function to map the data file. Returns false if it can't be opened or is the wrong size.
+		bool LoadDataFile(const string& FileName);
+
+		// Function to check that the features reproduce the board's own evaluation.
+		// Returns the number of positions (out of the first Count) that disagree.
+		int CheckAgainstBoard(size_t Count) const;
+
+		// Function to find the scaling constant that best fits the current parameters.
+		double FitScalingConstant();
+
+		// Function to run a number of epochs of Adam. Progress is reported and the parameters are saved every ReportEvery epochs.
+		void Run(int Epochs, double LearningRate, int ReportEvery, const string& OutputFile);
+
+		// Function to return the tuned parameters.
+		EvaluationParameters GetParameters() const;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,285 @@
+// OOP Chess Project: Uci.cpp.
+// This is the UciEngine class source file.
+// It contains all the definitions related to the Universal Chess Interface front end.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include "Uci.h"
+
+// Using namespaces.
+using namespace UciNamespace;
+
+// Function to write a move in coordinates, with the letter of the promotion piece if there is one.
+static void WritePositionMove(const PositionMove& Move, char Buffer[])
+{
+	const char PromotionLetters[6]{ 'p', 'n', 'b', 'r', 'q', 'k' };
+	char* Cursor{ Buffer };
+	*Cursor++ = static_cast<char>('a' + Move.From % 8);
+	*Cursor++ = static_cast<char>('8' - Move.From / 8);
+	*Cursor++ = static_cast<char>('a' + Move.To % 8);
+	*Cursor++ = static_cast<char>('8' - Move.To / 8);
+	if (Move.Promotion != NoPieceCode) { *Cursor++ = PromotionLetters[(Move.Promotion - 1) % 6]; }
+	*Cursor = '\0';
+}
+
+// Function to write a move in coordinates.
+void UciNamespace::WriteUciMove(const uint8_t Codes[64], PackedMove Move, char Buffer[])
+{
+	int From{ MoveFrom(Move) }, To{ MoveTo(Move) };
+	bool Promotion{ (Codes[From] == WhitePawnCode && To / 8 == 0) || (Codes[From] == BlackPawnCode && To / 8 == 7) };
+	PositionMove Converted{ static_cast<uint8_t>(From), static_cast<uint8_t>(To), static_cast<uint8_t>(Promotion ? Codes[From] + 4 : NoPieceCode) };
+	WritePositionMove(Converted, Buffer);
+}
+
+// Function to read a move in coordinates.
+bool UciNamespace::ParseUciMove(const FENPosition& Position, const string& Text, PositionMove& Move)
+{
+
+	// Read the squares, and the promotion piece if there is one.
+	if (Text.size() < 4 || Text.size() > 5) { return false; }
+	if (Text[0] < 'a' || Text[0] > 'h' || Text[1] < '1' || Text[1] > '8' || Text[2] < 'a' || Text[2] > 'h' || Text[3] < '1' || Text[3] > '8') { return false; }
+	int From{ 8 * ('8' - Text[1]) + (Text[0] - 'a') }, To{ 8 * ('8' - Text[3]) + (Text[2] - 'a') };
+	const string PromotionLetters{ "pnbrqk" };
+	int PromotionType{ Text.size() == 5 ? static_cast<int>(PromotionLetters.find(static_cast<char>(tolower(Text[4])))) : QueenType };
+	if (PromotionType < KnightType || PromotionType > QueenType) { return false; }
+
+	// Find the move among the legal moves, so a bad move can't upset the board.
+	PositionMove Legal[MaximumMoves];
+	int NumberOfMoves{ GenerateLegalMoves(Position, Legal) };
+	for (int i = 0; i < NumberOfMoves; i++)
+	{
+		if (Legal[i].From != From || Legal[i].To != To) { continue; }
+		if (Legal[i].Promotion != NoPieceCode && (Legal[i].Promotion - 1) % 6 != PromotionType) { continue; }
+		Move = Legal[i];
+		return true;
+	}
+	return false;
+
+}
+
+// Default constructor.
+UciEngine::UciEngine() : Game(&TheBoard)
+{
+	StopSearch = false;
+	UseBook = true;
+	Game.SetPositionFromFEN(StartingFEN);
+}
+
+// Destructor.
+UciEngine::~UciEngine() { StopSearching(); }
+
+// Function to write a line of output. Each line is flushed, since the program reading it is waiting for it.
+void UciEngine::Send(const string& Line)
+{
+	lock_guard<mutex> Lock(OutputLock);
+	cout << Line << endl;
+}
+
+// Function to stop the search and wait for its thread to finish, which is when it has sent its best move.
+void UciEngine::StopSearching()
+{
+	StopSearch = true;
+	if (SearchThread.joinable()) { SearchThread.join(); }
+	StopSearch = false;
+}
+
+// Function to make a move written in coordinates.
+bool UciEngine::MakeUciMove(const string& Text)
+{
+
+	FENPosition Position;
+	PositionMove Move;
+	Game.GetPosition(Position);
+	if (!ParseUciMove(Position, Text, Move)) { return false; }
+
+	// The board always promotes to a queen, so any other promotion is made on the position and the board set up from it.
+	if (Move.Promotion == NoPieceCode || (Move.Promotion - 1) % 6 == QueenType) { Game.MakeMove(PackMove(Position.Codes, Move.From, Move.To)); }
+	else
+	{
+		MakePositionMove(Position, Move);
+		Game.SetPosition(Position);
+	}
+	return true;
+
+}
+
+// Function to set up the position of a "position startpos|fen <FEN> [moves <move>...]" command.
+void UciEngine::SetPosition(istringstream& Command)
+{
+
+	// Read the starting position, which is either the usual one or a FEN string up to the word "moves".
+	string Word, FEN;
+	Command >> Word;
+	if (Word == "startpos") { FEN = StartingFEN; Command >> Word; }
+	else if (Word == "fen")
+	{
+		while (Command >> Word && Word != "moves") { FEN += (FEN.empty() ? "" : " ") + Word; }
+	}
+	else { Send("info string Error: Expected startpos or fen after position."); return; }
+	vector<string> Moves;
+	while (Command >> Word) { Moves.push_back(Word); }
+
+	// A program playing a game sends the whole game every move. If this is the last position with moves added,
+	// only the new moves are made; otherwise the game starts again from the position.
+	size_t FirstNewMove{ 0 };
+	if (FEN == BaseFEN && Moves.size() >= PositionMoves.size() && equal(PositionMoves.begin(), PositionMoves.end(), Moves.begin())) { FirstNewMove = PositionMoves.size(); }
+	else if (!Game.SetPositionFromFEN(FEN))
+	{
+		Send("info string Error: \"" + FEN + "\" is not a valid FEN string.");
+		BaseFEN.clear();
+		PositionMoves.clear();
+		return;
+	}
+	for (size_t i = FirstNewMove; i < Moves.size(); i++)
+	{
+		if (!MakeUciMove(Moves[i])) { Send("info string Error: " + Moves[i] + " is not a legal move, so it and the moves after it were ignored."); Moves.resize(i); break; }
+	}
+	BaseFEN = FEN;
+	PositionMoves = Moves;
+
+}
+
+// Function to start a search for a "go" command.
+void UciEngine::Go(istringstream& Command)
+{
+
+	// Read the limits. Anything not understood (such as "ponder") is ignored.
+	StopSearching();
+	SearchLimits Limits{ 0, 0, 0.0 };
+	long long WhiteTime{ 0 }, BlackTime{ 0 }, WhiteIncrement{ 0 }, BlackIncrement{ 0 }, MoveTime{ 0 };
+	int MovesToGo{ 0 };
+	bool Infinite{ false };
+	string Word;
+	while (Command >> Word)
+	{
+		if (Word == "infinite") { Infinite = true; }
+		else if (Word == "depth") { Command >> Limits.Depth; }
+		else if (Word == "nodes") { Command >> Limits.Nodes; }
+		else if (Word == "movetime") { Command >> MoveTime; }
+		else if (Word == "wtime") { Command >> WhiteTime; }
+		else if (Word == "btime") { Command >> BlackTime; }
+		else if (Word == "winc") { Command >> WhiteIncrement; }
+		else if (Word == "binc") { Command >> BlackIncrement; }
+		else if (Word == "movestogo") { Command >> MovesToGo; }
+	}
+
+	// With a clock, spend an even share of the time left (assuming 30 more moves if the number isn't given) plus most of the increment,
+	// but never more than half of what is left. A little is kept back for the time it takes to send the move.
+	FENPosition Position;
+	Game.GetPosition(Position);
+	long long TimeLeft{ Position.WhiteToMove ? WhiteTime : BlackTime }, Increment{ Position.WhiteToMove ? WhiteIncrement : BlackIncrement };
+	if (MoveTime > 0) { Limits.Seconds = MoveTime / 1000.0; }
+	else if (!Infinite && TimeLeft > 0)
+	{
+		double Share{ static_cast<double>(TimeLeft) / (MovesToGo > 0 ? MovesToGo : 30) + 0.75 * Increment };
+		Limits.Seconds = max(0.01, (min(Share, 0.5 * TimeLeft) - 20) / 1000.0);
+	}
+
+	// If the opening book has the position, its move is sent straight away.
+	PositionMove BookMove;
+	if (UseBook && !Infinite && ActiveBook().IsOpen() && ActiveBook().ChooseMove(Position, false, BookMove))
+	{
+		char Text[8];
+		WritePositionMove(BookMove, Text);
+		Send(string("bestmove ") + Text);
+		return;
+	}
+
+	// Otherwise search on another thread, reporting each finished depth from the point of view of the side to move.
+	SearchThread = thread([this, Limits, Position]() {
+		auto Report = [&](const SearchResult& Result) {
+			ostringstream Line;
+			char Text[8];
+			double Score{ Position.WhiteToMove ? Result.Score : -Result.Score };
+			WriteUciMove(Position.Codes, Result.Move, Text);
+			Line << "info depth " << Result.Depth << " score ";
+			if (fabs(Score) >= MateScore) { Line << "mate " << MateInMoves(Score, Result.Depth); }
+			else { Line << "cp " << lround(10 * Score); }
+			Line << " nodes " << Result.Nodes << " nps " << static_cast<long long>(Result.Seconds > 0 ? Result.Nodes / Result.Seconds : 0)
+				<< " time " << static_cast<long long>(1000 * Result.Seconds) << " pv " << Text;
+			Send(Line.str());
+		};
+		SearchResult Result{ Game.LimitedSearch(Limits, &StopSearch, Report) };
+		// Even a search stopped before its first depth has a move. Only a position without one gets the null move.
+		char Text[8] = "0000";
+		if (Result.Move != PackedMove{ 0 }) { WriteUciMove(Position.Codes, Result.Move, Text); }
+		Send(string("bestmove ") + Text);
+	});
+
+}
+
+// Function to change an option for a "setoption name <name> [value <value>]" command.
+void UciEngine::SetOption(istringstream& Command)
+{
+
+	// The name and the value may both contain spaces.
+	string Word, Name, Value;
+	Command >> Word;
+	while (Command >> Word && Word != "value") { Name += (Name.empty() ? "" : " ") + Word; }
+	while (Command >> Word) { Value += (Value.empty() ? "" : " ") + Word; }
+
+	StopSearching();
+	if (Name == "OwnBook") { UseBook = Value == "true"; }
+	else if (Name == "LazyMargin") { Game.SetLazyEvaluationMargin(atof(Value.c_str())); }
+	else if (Name == "MoveOrdering") { Game.SetMoveOrdering(Value == "true"); }
+	else if (Name == "NeuralNetwork")
+	{
+		// An empty name goes back to the classic evaluation.
+		if (Value.empty() || Value == "<empty>") { Game.SetEvaluator(ClassicEvaluation); }
+		else if (Game.LoadNeuralNetwork(Value)) { Game.SetEvaluator(NeuralEvaluation); }
+		else { Send("info string Error: Could not load the neural network " + Value + "."); }
+	}
+	else { Send("info string Error: No such option " + Name + "."); }
+
+}
+
+// Function to read and answer commands.
+void UciEngine::Run(istream& Input)
+{
+
+	string Line;
+	while (getline(Input, Line))
+	{
+		if (!Line.empty() && Line.back() == '\r') { Line.pop_back(); }
+		istringstream Command(Line);
+		string Word;
+		Command >> Word;
+
+		if (Word == "uci")
+		{
+			Send("id name Chess Game");
+			Send("id author James Cummins");
+			Send("option name OwnBook type check default true");
+			Send("option name LazyMargin type spin default 10 min -1 max 1000");
+			Send("option name MoveOrdering type check default true");
+			Send("option name NeuralNetwork type string default <empty>");
+			Send("uciok");
+		}
+		else if (Word == "isready") { Send("readyok"); }
+		else if (Word == "ucinewgame")
+		{
+			StopSearching();
+			BaseFEN.clear();
+			PositionMoves.clear();
+			Game.SetPositionFromFEN(StartingFEN);
+		}
+		else if (Word == "position") { StopSearching(); SetPosition(Command); }
+		else if (Word == "go") { Go(Command); }
+		else if (Word == "stop") { StopSearching(); }
+		else if (Word == "setoption") { SetOption(Command); }
+		else if (Word == "quit") { break; }
+		else if (Word == "ponderhit" || Word == "debug" || Word == "register") {}
+		else if (!Word.empty()) { Send("info string Error: Did not recognise " + Word + "."); }
+	}
+	StopSearching();
+
+}
+
+// Function to run the engine in UCI mode.
+int UciNamespace::RunUci()
+{
+	UciEngine Engine;
+	Engine.Run(cin);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+// OOP Chess Project: Uci.h.
+// This is the UciEngine class header file.
+// It contains the declarations of the Universal Chess Interface front end, which lets chess programs drive the engine.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Uci
+#define MY_CLASS_Uci
+
+// Include the relevant libraries.
+#include <string>
+#include <vector>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "GameManager.h"
+
+// Using namespaces.
+using namespace GameNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace UciNamespace
+{
+
+	// UciEngine class.
+	// Commands are read on the calling thread, and each search runs on a thread of its own, so "stop" and "isready"
+	// are answered while the engine is thinking. Output from both threads goes through Send, so lines are never mixed up.
+	class UciEngine {
+
+	// Private member data.
+	private:
+
+		// The board and the game the engine plays on.
+		Board TheBoard;
+		GameManager Game;
+		// The thread running the current search, and the flag that tells it to stop.
+		thread SearchThread;
+		atomic<bool> StopSearch;
+		// The lock on the output.
+		mutex OutputLock;
+		// The starting position and moves of the last "position" command, so that when the next one only adds moves to it,
+		// just the new moves are made.
+		string BaseFEN;
+		vector<string> PositionMoves;
+		// Whether the opening book is used when it has the position.
+		bool UseBook;
+
+		// Function to write a line of output.
+		void Send(const string& Line);
+
+		// Functions to handle the commands that need more than a line of output.
+		void SetPosition(istringstream& Command);
+		void Go(istringstream& Command);
+		void SetOption(istringstream& Command);
+
+		// Function to stop the search, if there is one, and wait for its thread to finish.
+		void StopSearching();
+
+		// Function to make a move written in coordinates (e.g. "e2e4" or "e7e8q"). Returns false if it isn't legal.
+		bool MakeUciMove(const string& Text);
+
+	// Public member functions.
+	public:
+
+		// Default constructor, starting from the usual position.
+		UciEngine();
+		// Destructor, which stops any search.
+		~UciEngine();
+
+		// Function to read and answer commands until "quit" or the end of the input.
+		void Run(istream& Input);
+
+	};
+
+	// Function to write a move in coordinates into a buffer of at least 6 characters. A pawn reaching the far row is promoted to a queen.
+	void WriteUciMove(const uint8_t Codes[64], PackedMove Move, char Buffer[]);
+
+	// Function to read a move in coordinates (e.g. "e2e4" or "e7e8n"), finding it among the legal moves of the position.
+	// A promotion without a piece letter is to a queen. Returns false if the text isn't a legal move.
+	bool ParseUciMove(const FENPosition& Position, const string& Text, PositionMove& Move);
+
+	// Function to run the engine in UCI mode on the standard input and output, as started with "uci" on the command line.
+	int RunUci();
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+// OOP Chess Project: Zobrist.h.
+// This is the Zobrist header file.
+// It contains the declarations of the 64-bit position keys used to look positions up in the game database.
+// James Cummins.
+
+#pragma once
+// This will be true only once.
+#ifndef MY_CLASS_Zobrist
+#define MY_CLASS_Zobrist
+
+// Include the relevant libraries.
+#include <cstdint>
+#include <string>
+#include "Fen.h"
+
+// Using namespaces.
+using namespace FenNamespace;
+using namespace std;
+
+// Using a namespace to avoid name collisions.
+namespace ZobristNamespace
+{
+
+	// The number of random numbers a key is made from: one for each piece on each square, four for the castling rights,
+	// eight for the en passant column and one for white to move. This is the layout Polyglot opening books use.
+	const int NumberOfZobristRandoms{ 781 };
+
+	// Function to return the key of a position: the random numbers of everything in it combined with exclusive or.
+	// The en passant column only counts if a pawn could actually make the capture, so transpositions get the same key.
+	// The move counters don't count.
+	uint64_t PositionKey(const FENPosition& Position);
+
+	// Function to return the key of a position as an opening book knows it. This uses the random numbers of the Polyglot
+	// program, so books made by other programs can be read, and the starting position's key is 0x463B96181691FC9C.
+	uint64_t PolyglotKey(const FENPosition& Position);
+
+	// Function to replace the book random numbers with ones from a text file: the 781 numbers in order, in hexadecimal, as they
+	// appear in the Polyglot source ("0x9D39247E33776D41ULL," and so on). Returns false, leaving the book keys alone, if it can't be read.
+	bool LoadPolyglotRandoms(const string& FileName);
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+// OOP Chess Project: FenTests.cpp.
+// This is the FEN test source file.
+// It contains the checks that FEN strings the board can't play from are turned away by every entry point.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include "Fen.h"
+#include "GameManager.h"
+
+// Using namespaces.
+using namespace FenNamespace;
+using namespace GameNamespace;
+
+// The number of checks that failed.
+static int Failures{ 0 };
+
+// Function to check a condition, printing what was checked if it doesn't hold.
+static void Check(bool Condition, const string& Description)
+{
+	if (!Condition) { cerr << "Failed: " << Description << endl; Failures++; }
+}
+
+// Function to check that a FEN string is turned away, by ParseFEN and by the game, with a reason.
+static void CheckRejected(const string& FEN)
+{
+	FENPosition Position;
+	Check(!ParseFEN(FEN.c_str(), Position), "ParseFEN rejects \"" + FEN + "\"");
+	Check(FENProblem(FEN.c_str()) != nullptr, "FENProblem explains \"" + FEN + "\"");
+	Board TheBoard;
+	TheBoard.InitialiseBoard();
+	GameManager Game(&TheBoard);
+	Check(!Game.SetPositionFromFEN(FEN), "SetPositionFromFEN rejects \"" + FEN + "\"");
+	Check(Game.GetFEN() == StartingFEN, "a rejected FEN leaves the game alone: \"" + FEN + "\"");
+}
+
+// Function to check that a FEN string is read.
+static void CheckAccepted(const string& FEN)
+{
+	FENPosition Position;
+	Check(ParseFEN(FEN.c_str(), Position), "ParseFEN reads \"" + FEN + "\"");
+	Check(FENProblem(FEN.c_str()) == nullptr, "FENProblem finds nothing wrong with \"" + FEN + "\"");
+}
+
+// Main function
+int main()
+{
+
+	// Boards without a king, with too many, or empty.
+	CheckRejected("8/8/8/3q4/8/8/8/8 w - - 0 1");
+	CheckRejected("8/8/8/8/8/8/8/4K3 w - - 0 1");
+	CheckRejected("4k3/8/8/8/8/8/8/8 b - - 0 1");
+	CheckRejected("4k3/8/8/8/8/8/8/3KK3 w - - 0 1");
+	CheckRejected("3kk3/8/8/8/8/8/8/4K3 w - - 0 1");
+	CheckRejected("8/8/8/8/8/8/8/8 w - - 0 1");
+	// Pawns on the back ranks.
+	CheckRejected("P3k3/8/8/8/8/8/8/4K3 w - - 0 1");
+	CheckRejected("4k3/8/8/8/8/8/8/p3K3 b - - 0 1");
+	CheckRejected("4k3/8/8/8/8/8/8/P3K3 w - - 0 1");
+	// Malformed strings.
+	CheckRejected("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1");
+
+	// Positions the board can play from.
+	CheckAccepted(StartingFEN);
+	CheckAccepted("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	CheckAccepted("4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+
+	if (Failures == 0) { cout << "All FEN checks passed." << endl; }
+	return Failures == 0 ? 0 : 1;
+
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+// OOP Chess Project: PerftTests.cpp.
+// This is the perft test source file.
+// It contains the checks that the light move generator finds the published number of positions from the standard test positions, and that castling in SAN is only read when it is legal.
+// James Cummins.
+
+// Include the relevant header files.
+#include <cstring>
+#include <iostream>
+#include "MoveGenerator.h"
+
+// Using namespaces.
+using namespace GeneratorNamespace;
+using namespace std;
+
+// Main function
+int main()
+{
+
+	// Count the positions from each standard position and compare them with the published counts.
+	int Failures{ 0 };
+	for (const PerftCheck& Check : StandardPerftChecks)
+	{
+		FENPosition Position;
+		if (!ParseFEN(Check.FEN, Position)) { cerr << "Failed: ParseFEN reads \"" << Check.FEN << "\"" << endl; Failures++; continue; }
+		uint64_t Nodes{ Perft(Position, Check.Depth) };
+		if (Nodes != Check.Nodes)
+		{
+			cerr << "Failed: \"" << Check.FEN << "\" to depth " << Check.Depth << " has " << Nodes << " positions rather than " << Check.Nodes << endl;
+			Failures++;
+		}
+	}
+
+	// Castling must be refused when it is blocked, has no rook, starts in check or passes through an attacked square.
+	struct CastlingCheck { const char* FEN; const char* SAN; bool Legal; };
+	const CastlingCheck CastlingChecks[]{
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "O-O", false },
+		{ "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", "O-O", true },
+		{ "r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1", "O-O-O", true },
+		{ "4k3/8/8/8/8/8/8/4K2R w KQ - 0 1", "O-O-O", false },
+		{ "4k3/8/8/8/8/8/4r3/R3K2R w KQ - 0 1", "O-O", false },
+		{ "4k3/8/8/8/8/8/5r2/R3K2R w KQ - 0 1", "O-O", false },
+		{ "4k3/8/8/8/8/8/5r2/R3K2R w KQ - 0 1", "O-O-O", true },
+	};
+	for (const CastlingCheck& Check : CastlingChecks)
+	{
+		FENPosition Position;
+		PositionMove Move;
+		if (!ParseFEN(Check.FEN, Position)) { cerr << "Failed: ParseFEN reads \"" << Check.FEN << "\"" << endl; Failures++; continue; }
+		bool Legal{ ParseSAN(Position, Check.SAN, static_cast<int>(strlen(Check.SAN)), Move) };
+		if (Legal != Check.Legal)
+		{
+			cerr << "Failed: ParseSAN " << (Legal ? "accepts " : "refuses ") << Check.SAN << " in \"" << Check.FEN << "\"" << endl;
+			Failures++;
+		}
+	}
+
+	if (Failures == 0) { cout << "All perft checks passed." << endl; }
+	return Failures == 0 ? 0 : 1;
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+// OOP Chess Project: ZobristTests.cpp.
+// This is the Zobrist test source file.
+// It contains the checks that opening book keys match the ones published with the Polyglot book format.
+// James Cummins.
+
+// Include the relevant header files.
+#include <iostream>
+#include "Fen.h"
+#include "Zobrist.h"
+
+// Using namespaces.
+using namespace FenNamespace;
+using namespace ZobristNamespace;
+
+// The number of checks that failed.
+static int Failures{ 0 };
+
+// Function to check that a position has the book key Polyglot gives it.
+static void CheckKey(const string& FEN, uint64_t Expected)
+{
+	FENPosition Position;
+	if (!ParseFEN(FEN.c_str(), Position)) { cerr << "Failed: ParseFEN reads \"" << FEN << "\"" << endl; Failures++; return; }
+	uint64_t Key{ PolyglotKey(Position) };
+	if (Key != Expected) { cerr << "Failed: \"" << FEN << "\" has key " << hex << Key << " rather than " << Expected << dec << endl; Failures++; }
+}
+
+// Main function
+int main()
+{
+
+	// The starting position, then 1. e4 d5 2. e5 f5 3. Ke2 Kf7, which covers en passant columns that do and don't count.
+	CheckKey(StartingFEN, 0x463B96181691FC9CULL);
+	CheckKey("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823C9B50FD114196ULL);
+	CheckKey("rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756B94461C50FB0ULL);
+	CheckKey("rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662FAFB965DB29D4ULL);
+	CheckKey("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22A48B5A8E47FF78ULL);
+	CheckKey("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652A607CA3F242C1ULL);
+	CheckKey("rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00FDD303C946BDD9ULL);
+	// 1. a4 b5 2. h4 b4 3. c4, and then 3... bxc3 4. Ra3, which lose some of the castling rights.
+	CheckKey("rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3C8123EA7B067637ULL);
+	CheckKey("rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5C3F9B829B279560ULL);
+
+	if (Failures == 0) { cout << "All Zobrist checks passed." << endl; }
+	return Failures == 0 ? 0 : 1;
+
+}
\ No newline at end of file